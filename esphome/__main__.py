@@ -203,6 +203,12 @@ def generate_cpp_contents(config):
 
     CORE.flush_tasks()
 
+    lambdas, functions = cg.shared_lambda_stats()
+    if lambdas != functions:
+        _LOGGER.info(
+            "Deduplicated %s lambdas into %s shared functions.", lambdas, functions
+        )
+
 
 def write_cpp_file():
     writer.write_platformio_project()
@@ -518,8 +524,19 @@ def command_dashboard(args):
     return dashboard.start_dashboard(args)
 
 
+def command_compile_all(args):
+    from esphome.fleet import compile_fleet
+
+    files = []
+    for path in args.configuration:
+        files += list_yaml_files([path]) if os.path.isdir(path) else [path]
+    nodes = compile_fleet(files, args.jobs, args.report)
+    return sum(1 for node in nodes if node.status != "success")
+
+
 def command_update_all(args):
     import click
+    from esphome.fleet import compile_fleet
 
     success = {}
     files = list_yaml_files(args.configuration)
@@ -531,13 +548,22 @@ def command_update_all(args):
         half_line = "=" * ((twidth - width) // 2)
         click.echo(f"{half_line}{middle_text}{half_line}")
 
+    # Build all nodes in parallel first, the uploads then only take seconds each
+    compiled = {
+        node.config_path: node.status == "success"
+        for node in compile_fleet(files, args.jobs)
+    }
+    print()
+
     for f in files:
         print(f"Updating {color(Fore.CYAN, f)}")
         print("-" * twidth)
         print()
-        rc = run_external_process(
-            "esphome", "--dashboard", "run", f, "--no-logs", "--device", "OTA"
-        )
+        rc = 1
+        if compiled[f]:
+            rc = run_external_process(
+                "esphome", "--dashboard", "upload", f, "--device", "OTA"
+            )
         if rc == 0:
             print_bar(f"[{color(Fore.BOLD_GREEN, 'SUCCESS')}] {f}")
             success[f] = True
@@ -673,6 +699,7 @@ PRE_CONFIG_ACTIONS = {
     "dashboard": command_dashboard,
     "vscode": command_vscode,
     "update-all": command_update_all,
+    "compile-all": command_compile_all,
 }
 
 POST_CONFIG_ACTIONS = {
@@ -879,6 +906,29 @@ def parse_args(argv):
     parser_update.add_argument(
         "configuration", help="Your YAML configuration file directories.", nargs="+"
     )
+    parser_update.add_argument(
+        "--jobs",
+        help="Number of nodes to compile at once, default by CPUs and memory.",
+        type=int,
+    )
+
+    parser_compile_all = subparsers.add_parser(
+        "compile-all",
+        help="Compile many nodes in parallel and report the build time by phase.",
+    )
+    parser_compile_all.add_argument(
+        "configuration",
+        help="Your YAML configuration files or file directories.",
+        nargs="+",
+    )
+    parser_compile_all.add_argument(
+        "--jobs",
+        help="Number of nodes to compile at once, default by CPUs and memory.",
+        type=int,
+    )
+    parser_compile_all.add_argument(
+        "--report", help="Write the build time report as JSON to this file."
+    )
 
     parser_idedata = subparsers.add_parser("idedata")
     parser_idedata.add_argument(
@@ -17,24 +17,41 @@ void A4988::setup() {
   this->step_pin_->digital_write(false);
   this->dir_pin_->setup();
   this->dir_pin_->digital_write(false);
+
+#ifdef USE_STEP_TIMER
+  if (this->step_timer_) {
+    this->generator_ = new stepper::TimedStepGenerator(  // NOLINT(cppcoreguidelines-owning-memory)
+        static_cast<InternalGPIOPin *>(this->step_pin_), static_cast<InternalGPIOPin *>(this->dir_pin_));
+    if (!stepper::StepTimer::get()->add(this->generator_)) {
+      ESP_LOGE(TAG, "Could not create the step timer");
+      this->mark_failed();
+      return;
+    }
+    this->generator_->set_position(this->current_position);
+    this->planned_target_ = this->planned_position_ = this->current_position;
+  }
+#endif
 }
 void A4988::dump_config() {
   ESP_LOGCONFIG(TAG, "A4988:");
   LOG_PIN("  Step Pin: ", this->step_pin_);
   LOG_PIN("  Dir Pin: ", this->dir_pin_);
   LOG_PIN("  Sleep Pin: ", this->sleep_pin_);
+#ifdef USE_STEP_TIMER
+  ESP_LOGCONFIG(TAG, "  Step Timer: %s", YESNO(this->step_timer_));
+#endif
   LOG_STEPPER(this);
 }
 void A4988::loop() {
-  bool at_target = this->has_reached_target();
-  if (this->sleep_pin_ != nullptr) {
-    bool sleep_rising_edge = !sleep_pin_state_ & !at_target;
-    this->sleep_pin_->digital_write(!at_target);
-    this->sleep_pin_state_ = !at_target;
-    if (sleep_rising_edge) {
-      delayMicroseconds(1000);
-    }
+#ifdef USE_STEP_TIMER
+  if (this->generator_ != nullptr) {
+    this->loop_timed_();
+    return;
   }
+#endif
+
+  bool at_target = this->has_reached_target();
+  this->set_awake_(!at_target);
   if (at_target) {
     this->high_freq_.stop();
   } else {
@@ -51,6 +68,54 @@ void A4988::loop() {
   delayMicroseconds(5);
   this->step_pin_->digital_write(false);
 }
+void A4988::set_awake_(bool awake) {
+  if (this->sleep_pin_ == nullptr)
+    return;
+  bool sleep_rising_edge = !sleep_pin_state_ & awake;
+  this->sleep_pin_->digital_write(awake);
+  this->sleep_pin_state_ = awake;
+  if (sleep_rising_edge) {
+    delayMicroseconds(1000);
+  }
+}
+
+#ifdef USE_STEP_TIMER
+void A4988::loop_timed_() {
+  // The timer only steps, set_target() and report_position() change the public fields and are picked up here
+  if (this->current_position != this->planned_position_)
+    this->generator_->set_position(this->current_position);
+  if (this->target_position != this->planned_target_) {
+    this->set_awake_(true);
+    this->planned_target_ = this->target_position;
+    this->generator_->set_target(this->waypoint_(this->target_position));
+  }
+  this->generator_->loop();
+  this->current_position = this->planned_position_ = this->generator_->get_position();
+  this->set_awake_(this->generator_->is_moving() || !this->has_reached_target());
+}
+void A4988::queue_target(int32_t steps) {
+  if (this->generator_ == nullptr) {
+    Stepper::queue_target(steps);
+    return;
+  }
+  this->set_awake_(true);
+  this->target_position = this->planned_target_ = steps;
+  this->generator_->queue_target(this->waypoint_(steps));
+}
+void A4988::set_target_with_limits(int32_t steps, float max_speed, float acceleration, float deceleration) {
+  if (this->generator_ == nullptr) {
+    Stepper::set_target_with_limits(steps, max_speed, acceleration, deceleration);
+    return;
+  }
+  this->set_awake_(true);
+  this->target_position = this->planned_target_ = steps;
+  this->generator_->set_target(stepper::Waypoint{steps, max_speed, acceleration, deceleration});
+}
+void A4988::on_update_speed() {
+  if (this->generator_ != nullptr)
+    this->generator_->set_limits(this->max_speed_, this->acceleration_, this->deceleration_);
+}
+#endif
 
 }  // namespace a4988
 }  // namespace esphome
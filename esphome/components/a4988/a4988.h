@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/hal.h"
 #include "esphome/components/stepper/stepper.h"
 
@@ -17,12 +18,35 @@ class A4988 : public stepper::Stepper, public Component {
   void loop() override;
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
+#ifdef USE_STEP_TIMER
+  void set_step_timer(bool step_timer) { this->step_timer_ = step_timer; }
+  void queue_target(int32_t steps) override;
+  void set_target_with_limits(int32_t steps, float max_speed, float acceleration, float deceleration) override;
+  void on_update_speed() override;
+#endif
+
  protected:
+  /// Wake the driver up before it has to step, and let it sleep once at the target.
+  void set_awake_(bool awake);
+#ifdef USE_STEP_TIMER
+  void loop_timed_();
+  stepper::Waypoint waypoint_(int32_t steps) const {
+    return stepper::Waypoint{steps, this->max_speed_, this->acceleration_, this->deceleration_};
+  }
+#endif
+
   GPIOPin *step_pin_;
   GPIOPin *dir_pin_;
   GPIOPin *sleep_pin_{nullptr};
   bool sleep_pin_state_;
   HighFrequencyLoopRequester high_freq_;
+#ifdef USE_STEP_TIMER
+  bool step_timer_{false};
+  stepper::TimedStepGenerator *generator_{nullptr};
+  /// Target and position handed to the generator, to pick up set_target() and report_position() in loop().
+  int32_t planned_target_{0};
+  int32_t planned_position_{0};
+#endif
 };
 
 }  // namespace a4988
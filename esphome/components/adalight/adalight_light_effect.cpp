@@ -1,6 +1,9 @@
 #include "adalight_light_effect.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 namespace esphome {
 namespace adalight {
 
@@ -8,6 +11,8 @@ static const char *const TAG = "adalight_light_effect";
 
 static const uint32_t ADALIGHT_ACK_INTERVAL = 1000;
 static const uint32_t ADALIGHT_RECEIVE_TIMEOUT = 1000;
+static const size_t ADALIGHT_READ_CHUNK = 64;
+static const uint8_t ADALIGHT_MAGIC[] = {'A', 'd', 'a'};
 
 AdalightLightEffect::AdalightLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -17,39 +22,33 @@ void AdalightLightEffect::start() {
   last_ack_ = 0;
   last_byte_ = 0;
   last_reset_ = 0;
+  this->frame_.resize(this->get_addressable_()->size());
 }
 
 void AdalightLightEffect::stop() {
-  frame_.resize(0);
+  reset_frame_();
+  ESP_LOGD(TAG, "Frames dropped: %" PRIu32 ", late: %" PRIu32, this->frame_.get_dropped(), this->frame_.get_late());
 
   AddressableLightEffect::stop();
 }
 
-unsigned int AdalightLightEffect::get_frame_size_(int led_count) const {
-  // 3 bytes: Ada
-  // 2 bytes: LED count
-  // 1 byte: checksum
-  // 3 bytes per LED
-  return 3 + 2 + 1 + led_count * 3;
+void AdalightLightEffect::reset_frame_() {
+  this->header_size_ = 0;
+  this->led_index_ = 0;
+  this->pixel_size_ = 0;
 }
 
-void AdalightLightEffect::reset_frame_(light::AddressableLight &it) {
-  int buffer_capacity = get_frame_size_(it.size());
-
-  frame_.clear();
-  frame_.reserve(buffer_capacity);
-}
-
-void AdalightLightEffect::blank_all_leds_(light::AddressableLight &it) {
-  for (int led = it.size(); led-- > 0;) {
-    it[led].set(Color::BLACK);
-  }
-  it.schedule_show();
+void AdalightLightEffect::blank_all_leds_() {
+  this->frame_.fill(Color::BLACK);
+  this->frame_.complete();
 }
 
 void AdalightLightEffect::apply(light::AddressableLight &it, const Color &current_color) {
   const uint32_t now = millis();
 
+  if (this->frame_.size() != static_cast<size_t>(it.size()))
+    this->frame_.resize(it.size());
+
   if (now - this->last_ack_ >= ADALIGHT_ACK_INTERVAL) {
     ESP_LOGV(TAG, "Sending ACK");
     this->write_str("Ada\n");
@@ -58,84 +57,77 @@ void AdalightLightEffect::apply(light::AddressableLight &it, const Color &curren
 
   if (!this->last_reset_) {
     ESP_LOGW(TAG, "Frame: Reset.");
-    reset_frame_(it);
-    blank_all_leds_(it);
+    reset_frame_();
+    blank_all_leds_();
     this->last_reset_ = now;
   }
 
-  if (!this->frame_.empty() && now - this->last_byte_ >= ADALIGHT_RECEIVE_TIMEOUT) {
-    ESP_LOGW(TAG, "Frame: Receive timeout (size=%zu).", this->frame_.size());
-    reset_frame_(it);
-    blank_all_leds_(it);
+  if (this->header_size_ != 0 && now - this->last_byte_ >= ADALIGHT_RECEIVE_TIMEOUT) {
+    ESP_LOGW(TAG, "Frame: Receive timeout (led=%u).", this->led_index_);
+    this->frame_.count_late();
+    reset_frame_();
+    blank_all_leds_();
   }
 
   if (this->available() > 0) {
     ESP_LOGV(TAG, "Frame: Available (size=%d).", this->available());
   }
 
-  while (this->available() != 0) {
-    uint8_t data;
-    if (!this->read_byte(&data))
+  // Drain the UART in chunks, pixels go straight into the staged frame
+  uint8_t buf[ADALIGHT_READ_CHUNK];
+  int available;
+  while ((available = this->available()) > 0) {
+    size_t len = std::min<size_t>(available, sizeof(buf));
+    if (!this->read_array(buf, len))
       break;
-    this->frame_.push_back(data);
     this->last_byte_ = now;
+    for (size_t i = 0; i < len; i++)
+      this->parse_byte_(buf[i]);
+  }
 
-    switch (this->parse_frame_(it)) {
-      case INVALID:
-        ESP_LOGD(TAG, "Frame: Invalid (size=%zu, first=%d).", this->frame_.size(), this->frame_[0]);
-        reset_frame_(it);
-        break;
-
-      case PARTIAL:
-        break;
+  this->frame_.apply(it);
+}
 
-      case CONSUMED:
-        ESP_LOGV(TAG, "Frame: Consumed (size=%zu).", this->frame_.size());
-        reset_frame_(it);
-        break;
+void AdalightLightEffect::parse_byte_(uint8_t data) {
+  // Header: `Ada`, LED count high and low byte, checksum
+  if (this->header_size_ < sizeof(this->header_)) {
+    if (this->header_size_ < sizeof(ADALIGHT_MAGIC) && data != ADALIGHT_MAGIC[this->header_size_]) {
+      ESP_LOGD(TAG, "Frame: Invalid (size=%u, first=%d).", this->header_size_ + 1u,
+               this->header_size_ == 0 ? data : this->header_[0]);
+      reset_frame_();
+      // The byte may already start the next frame
+      if (data == ADALIGHT_MAGIC[0])
+        this->header_[this->header_size_++] = data;
+      return;
+    }
+    this->header_[this->header_size_++] = data;
+    if (this->header_size_ < sizeof(this->header_))
+      return;
+
+    uint8_t checksum = this->header_[3] ^ this->header_[4] ^ 0x55;
+    if (checksum != this->header_[5]) {
+      ESP_LOGD(TAG, "Frame: Invalid checksum.");
+      reset_frame_();
+      return;
     }
+    this->led_count_ = (this->header_[3] << 8) + this->header_[4] + 1;
+    return;
   }
-}
 
-AdalightLightEffect::Frame AdalightLightEffect::parse_frame_(light::AddressableLight &it) {
-  if (frame_.empty())
-    return INVALID;
-
-  // Check header: `Ada`
-  if (frame_[0] != 'A')
-    return INVALID;
-  if (frame_.size() > 1 && frame_[1] != 'd')
-    return INVALID;
-  if (frame_.size() > 2 && frame_[2] != 'a')
-    return INVALID;
-
-  // 3 bytes: Count Hi, Count Lo, Checksum
-  if (frame_.size() < 6)
-    return PARTIAL;
-
-  // Check checksum
-  uint16_t checksum = frame_[3] ^ frame_[4] ^ 0x55;
-  if (checksum != frame_[5])
-    return INVALID;
-
-  // Check if we received the full frame
-  uint16_t led_count = (frame_[3] << 8) + frame_[4] + 1;
-  auto buffer_size = get_frame_size_(led_count);
-  if (frame_.size() < buffer_size)
-    return PARTIAL;
-
-  // Apply lights
-  auto accepted_led_count = std::min<int>(led_count, it.size());
-  uint8_t *led_data = &frame_[6];
-
-  for (int led = 0; led < accepted_led_count; led++, led_data += 3) {
-    auto white = std::min(std::min(led_data[0], led_data[1]), led_data[2]);
-
-    it[led].set(Color(led_data[0], led_data[1], led_data[2], white));
+  // 3 bytes per LED
+  this->pixel_[this->pixel_size_++] = data;
+  if (this->pixel_size_ < sizeof(this->pixel_))
+    return;
+  this->pixel_size_ = 0;
+
+  auto white = std::min(std::min(this->pixel_[0], this->pixel_[1]), this->pixel_[2]);
+  this->frame_.set(this->led_index_, Color(this->pixel_[0], this->pixel_[1], this->pixel_[2], white));
+
+  if (++this->led_index_ == this->led_count_) {
+    ESP_LOGV(TAG, "Frame: Consumed (leds=%u).", this->led_count_);
+    this->frame_.complete();
+    reset_frame_();
   }
-
-  it.schedule_show();
-  return CONSUMED;
 }
 
 }  // namespace adalight
@@ -2,10 +2,9 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/light/addressable_light_effect.h"
+#include "esphome/components/light/realtime_frame.h"
 #include "esphome/components/uart/uart.h"
 
-#include <vector>
-
 namespace esphome {
 namespace adalight {
 
@@ -18,21 +17,21 @@ class AdalightLightEffect : public light::AddressableLightEffect, public uart::U
   void apply(light::AddressableLight &it, const Color &current_color) override;
 
  protected:
-  enum Frame {
-    INVALID,
-    PARTIAL,
-    CONSUMED,
-  };
-
-  unsigned int get_frame_size_(int led_count) const;
-  void reset_frame_(light::AddressableLight &it);
-  void blank_all_leds_(light::AddressableLight &it);
-  Frame parse_frame_(light::AddressableLight &it);
+  void reset_frame_();
+  void blank_all_leds_();
+  void parse_byte_(uint8_t data);
 
   uint32_t last_ack_{0};
   uint32_t last_byte_{0};
   uint32_t last_reset_{0};
-  std::vector<uint8_t> frame_;
+  /// 'Ada', LED count high and low byte, checksum
+  uint8_t header_[6];
+  uint8_t header_size_{0};
+  uint16_t led_count_{0};
+  uint16_t led_index_{0};
+  uint8_t pixel_[3];
+  uint8_t pixel_size_{0};
+  light::RealtimeFrame frame_;
 };
 
 }  // namespace adalight
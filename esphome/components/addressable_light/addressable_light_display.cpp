@@ -17,7 +17,8 @@ void AddressableLightDisplay::update() {
   if (!this->enabled_)
     return;
 
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 
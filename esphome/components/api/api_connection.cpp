@@ -26,6 +26,23 @@ namespace api {
 
 static const char *const TAG = "api.connection";
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
+#ifdef USE_ESP32_CAMERA
+static const uint16_t CAMERA_CHUNK_MIN = 1024;
+static const uint16_t CAMERA_CHUNK_MAX = 16384;
+static const uint32_t CAMERA_STATS_INTERVAL = 10000;
+#endif
+
+/// Requests changing entities only use the request and global state, so they can be handled on any task.
+template<typename T> static void run_on_control_task(void (*handler)(const T &), const T &msg) {
+#ifdef USE_NETWORK_TASK
+  // The connection may be gone when the control task gets to it, only the copy of the request is passed on
+  if (!App.in_task(TaskAffinity::CONTROL)) {
+    App.run_in_task(TaskAffinity::CONTROL, [handler, msg]() { handler(msg); });
+    return;
+  }
+#endif
+  handler(msg);
+}
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
@@ -116,7 +133,16 @@ void APIConnection::loop() {
   }
 
   this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+  // Sends the latest state of everything that changed since the previous pass, all of it after subscribing. The
+  // states are only encoded into the send buffer while the table is locked, the socket write follows after the pass.
+  if (this->state_subscription_) {
+    this->cork();
+    this->collecting_states_ = true;
+    App.state_table.send_changed(this->state_cursor_, &this->initial_state_iterator_);
+    this->collecting_states_ = false;
+    if (!this->uncork())
+      return;
+  }
 
   static uint32_t keepalive = 60000;
   static uint8_t max_ping_retries = 60;
@@ -149,25 +175,47 @@ void APIConnection::loop() {
   }
 
 #ifdef USE_ESP32_CAMERA
-  if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
-    uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
+  // Send as much of the image as the socket takes, in chunks that grow as long as the socket keeps up with them
+  while (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
+    const size_t to_send = std::min<size_t>(this->camera_chunk_size_, this->image_reader_.available());
+    const bool done = this->image_reader_.available() == to_send;
     auto buffer = this->create_buffer();
     // fixed32 key = 1;
     buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
-    // bytes data = 2;
-    buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
     // bool done = 3;
-    bool done = this->image_reader_.available() == to_send;
     buffer.encode_bool(3, done);
-    bool success = this->send_buffer(buffer, 44);
+    // bytes data = 2; written straight from the frame buffer
+    buffer.encode_field_raw(2, 2);
+    buffer.encode_varint_raw(to_send);
+    struct iovec payload[2];
+    payload[0].iov_base = buffer.get_buffer()->data();
+    payload[0].iov_len = buffer.get_buffer()->size();
+    payload[1].iov_base = this->image_reader_.peek_data_buffer();
+    payload[1].iov_len = to_send;
+    if (!this->send_packet_(44, payload, 2))
+      break;
 
-    if (success) {
-      this->image_reader_.consume_data(to_send);
-    }
-    if (success && done) {
+    this->image_reader_.consume_data(to_send);
+    if (done)
       this->image_reader_.return_image();
+    if (this->helper_->can_write_without_blocking()) {
+      this->camera_chunk_size_ = std::min<uint16_t>(this->camera_chunk_size_ * 2, CAMERA_CHUNK_MAX);
+    } else {
+      // the socket only took part of the chunk
+      this->camera_chunk_size_ = std::max<uint16_t>(this->camera_chunk_size_ / 2, CAMERA_CHUNK_MIN);
     }
   }
+
+  if (now - this->camera_stats_start_ >= CAMERA_STATS_INTERVAL) {
+    auto stats = this->image_reader_.take_stats();
+    if (stats.frames != 0 || stats.dropped != 0) {
+      const float fps = stats.frames * 1000.0f / (now - this->camera_stats_start_);
+      const uint32_t latency = stats.frames != 0 ? stats.latency_sum / stats.frames : 0;
+      ESP_LOGD(TAG, "%s: Camera %.1f fps, latency %" PRIu32 " ms (max %" PRIu32 " ms), %" PRIu32 " frames dropped",
+               this->client_combined_info_.c_str(), fps, latency, stats.latency_max, stats.dropped);
+    }
+    this->camera_stats_start_ = now;
+  }
 #endif
 
   if (state_subs_at_ != -1) {
@@ -264,7 +312,7 @@ bool APIConnection::send_cover_info(cover::Cover *cover) {
   msg.entity_category = static_cast<enums::EntityCategory>(cover->get_entity_category());
   return this->send_list_entities_cover_response(msg);
 }
-void APIConnection::cover_command(const CoverCommandRequest &msg) {
+static void handle_cover_command(const CoverCommandRequest &msg) {
   cover::Cover *cover = App.get_cover_by_key(msg.key);
   if (cover == nullptr)
     return;
@@ -291,6 +339,9 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
     call.set_command_stop();
   call.perform();
 }
+void APIConnection::cover_command(const CoverCommandRequest &msg) {
+  run_on_control_task(handle_cover_command, msg);
+}
 #endif
 
 #ifdef USE_FAN
@@ -332,7 +383,7 @@ bool APIConnection::send_fan_info(fan::Fan *fan) {
   msg.entity_category = static_cast<enums::EntityCategory>(fan->get_entity_category());
   return this->send_list_entities_fan_response(msg);
 }
-void APIConnection::fan_command(const FanCommandRequest &msg) {
+static void handle_fan_command(const FanCommandRequest &msg) {
   fan::Fan *fan = App.get_fan_by_key(msg.key);
   if (fan == nullptr)
     return;
@@ -352,6 +403,9 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
     call.set_preset_mode(msg.preset_mode);
   call.perform();
 }
+void APIConnection::fan_command(const FanCommandRequest &msg) {
+  run_on_control_task(handle_fan_command, msg);
+}
 #endif
 
 #ifdef USE_LIGHT
@@ -415,7 +469,7 @@ bool APIConnection::send_light_info(light::LightState *light) {
   }
   return this->send_list_entities_light_response(msg);
 }
-void APIConnection::light_command(const LightCommandRequest &msg) {
+static void handle_light_command(const LightCommandRequest &msg) {
   light::LightState *light = App.get_light_by_key(msg.key);
   if (light == nullptr)
     return;
@@ -450,6 +504,9 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
     call.set_effect(msg.effect);
   call.perform();
 }
+void APIConnection::light_command(const LightCommandRequest &msg) {
+  run_on_control_task(handle_light_command, msg);
+}
 #endif
 
 #ifdef USE_SENSOR
@@ -508,7 +565,7 @@ bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   msg.device_class = a_switch->get_device_class();
   return this->send_list_entities_switch_response(msg);
 }
-void APIConnection::switch_command(const SwitchCommandRequest &msg) {
+static void handle_switch_command(const SwitchCommandRequest &msg) {
   switch_::Switch *a_switch = App.get_switch_by_key(msg.key);
   if (a_switch == nullptr)
     return;
@@ -519,6 +576,9 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
     a_switch->turn_off();
   }
 }
+void APIConnection::switch_command(const SwitchCommandRequest &msg) {
+  run_on_control_task(handle_switch_command, msg);
+}
 #endif
 
 #ifdef USE_TEXT_SENSOR
@@ -625,7 +685,7 @@ bool APIConnection::send_climate_info(climate::Climate *climate) {
     msg.supported_swing_modes.push_back(static_cast<enums::ClimateSwingMode>(swing_mode));
   return this->send_list_entities_climate_response(msg);
 }
-void APIConnection::climate_command(const ClimateCommandRequest &msg) {
+static void handle_climate_command(const ClimateCommandRequest &msg) {
   climate::Climate *climate = App.get_climate_by_key(msg.key);
   if (climate == nullptr)
     return;
@@ -653,6 +713,9 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
     call.set_swing_mode(static_cast<climate::ClimateSwingMode>(msg.swing_mode));
   call.perform();
 }
+void APIConnection::climate_command(const ClimateCommandRequest &msg) {
+  run_on_control_task(handle_climate_command, msg);
+}
 #endif
 
 #ifdef USE_NUMBER
@@ -686,7 +749,7 @@ bool APIConnection::send_number_info(number::Number *number) {
 
   return this->send_list_entities_number_response(msg);
 }
-void APIConnection::number_command(const NumberCommandRequest &msg) {
+static void handle_number_command(const NumberCommandRequest &msg) {
   number::Number *number = App.get_number_by_key(msg.key);
   if (number == nullptr)
     return;
@@ -695,6 +758,9 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
   call.set_value(msg.state);
   call.perform();
 }
+void APIConnection::number_command(const NumberCommandRequest &msg) {
+  run_on_control_task(handle_number_command, msg);
+}
 #endif
 
 #ifdef USE_TEXT
@@ -724,7 +790,7 @@ bool APIConnection::send_text_info(text::Text *text) {
 
   return this->send_list_entities_text_response(msg);
 }
-void APIConnection::text_command(const TextCommandRequest &msg) {
+static void handle_text_command(const TextCommandRequest &msg) {
   text::Text *text = App.get_text_by_key(msg.key);
   if (text == nullptr)
     return;
@@ -733,6 +799,9 @@ void APIConnection::text_command(const TextCommandRequest &msg) {
   call.set_value(msg.state);
   call.perform();
 }
+void APIConnection::text_command(const TextCommandRequest &msg) {
+  run_on_control_task(handle_text_command, msg);
+}
 #endif
 
 #ifdef USE_SELECT
@@ -762,7 +831,7 @@ bool APIConnection::send_select_info(select::Select *select) {
 
   return this->send_list_entities_select_response(msg);
 }
-void APIConnection::select_command(const SelectCommandRequest &msg) {
+static void handle_select_command(const SelectCommandRequest &msg) {
   select::Select *select = App.get_select_by_key(msg.key);
   if (select == nullptr)
     return;
@@ -771,6 +840,9 @@ void APIConnection::select_command(const SelectCommandRequest &msg) {
   call.set_option(msg.state);
   call.perform();
 }
+void APIConnection::select_command(const SelectCommandRequest &msg) {
+  run_on_control_task(handle_select_command, msg);
+}
 #endif
 
 #ifdef USE_BUTTON
@@ -787,13 +859,16 @@ bool APIConnection::send_button_info(button::Button *button) {
   msg.device_class = button->get_device_class();
   return this->send_list_entities_button_response(msg);
 }
-void APIConnection::button_command(const ButtonCommandRequest &msg) {
+static void handle_button_command(const ButtonCommandRequest &msg) {
   button::Button *button = App.get_button_by_key(msg.key);
   if (button == nullptr)
     return;
 
   button->press();
 }
+void APIConnection::button_command(const ButtonCommandRequest &msg) {
+  run_on_control_task(handle_button_command, msg);
+}
 #endif
 
 #ifdef USE_LOCK
@@ -821,7 +896,7 @@ bool APIConnection::send_lock_info(lock::Lock *a_lock) {
   msg.requires_code = a_lock->traits.get_requires_code();
   return this->send_list_entities_lock_response(msg);
 }
-void APIConnection::lock_command(const LockCommandRequest &msg) {
+static void handle_lock_command(const LockCommandRequest &msg) {
   lock::Lock *a_lock = App.get_lock_by_key(msg.key);
   if (a_lock == nullptr)
     return;
@@ -838,6 +913,9 @@ void APIConnection::lock_command(const LockCommandRequest &msg) {
       break;
   }
 }
+void APIConnection::lock_command(const LockCommandRequest &msg) {
+  run_on_control_task(handle_lock_command, msg);
+}
 #endif
 
 #ifdef USE_MEDIA_PLAYER
@@ -868,7 +946,7 @@ bool APIConnection::send_media_player_info(media_player::MediaPlayer *media_play
 
   return this->send_list_entities_media_player_response(msg);
 }
-void APIConnection::media_player_command(const MediaPlayerCommandRequest &msg) {
+static void handle_media_player_command(const MediaPlayerCommandRequest &msg) {
   media_player::MediaPlayer *media_player = App.get_media_player_by_key(msg.key);
   if (media_player == nullptr)
     return;
@@ -885,14 +963,15 @@ void APIConnection::media_player_command(const MediaPlayerCommandRequest &msg) {
   }
   call.perform();
 }
+void APIConnection::media_player_command(const MediaPlayerCommandRequest &msg) {
+  run_on_control_task(handle_media_player_command, msg);
+}
 #endif
 
 #ifdef USE_ESP32_CAMERA
 void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage> image) {
   if (!this->state_subscription_)
     return;
-  if (this->image_reader_.available())
-    return;
   if (image->was_requested_by(esphome::esp32_camera::API_REQUESTER) ||
       image->was_requested_by(esphome::esp32_camera::IDLE))
     this->image_reader_.set_image(std::move(image));
@@ -926,10 +1005,13 @@ void APIConnection::camera_image(const CameraImageRequest &msg) {
 #endif
 
 #ifdef USE_HOMEASSISTANT_TIME
-void APIConnection::on_get_time_response(const GetTimeResponse &value) {
+static void handle_get_time_response(const GetTimeResponse &value) {
   if (homeassistant::global_homeassistant_time != nullptr)
     homeassistant::global_homeassistant_time->set_epoch_time(value.epoch_seconds);
 }
+void APIConnection::on_get_time_response(const GetTimeResponse &value) {
+  run_on_control_task(handle_get_time_response, value);
+}
 #endif
 
 #ifdef USE_BLUETOOTH_PROXY
@@ -1044,7 +1126,7 @@ bool APIConnection::send_alarm_control_panel_info(alarm_control_panel::AlarmCont
   msg.requires_code_to_arm = a_alarm_control_panel->get_requires_code_to_arm();
   return this->send_list_entities_alarm_control_panel_response(msg);
 }
-void APIConnection::alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) {
+static void handle_alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) {
   alarm_control_panel::AlarmControlPanel *a_alarm_control_panel = App.get_alarm_control_panel_by_key(msg.key);
   if (a_alarm_control_panel == nullptr)
     return;
@@ -1076,6 +1158,9 @@ void APIConnection::alarm_control_panel_command(const AlarmControlPanelCommandRe
   call.set_code(msg.code);
   call.perform();
 }
+void APIConnection::alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) {
+  run_on_control_task(handle_alarm_control_panel_command, msg);
+}
 #endif
 
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
@@ -1120,7 +1205,13 @@ ConnectResponse APIConnection::connect(const ConnectRequest &msg) {
   if (correct) {
     ESP_LOGD(TAG, "%s: Connected successfully", this->client_combined_info_.c_str());
     this->connection_state_ = ConnectionState::AUTHENTICATED;
+#ifdef USE_NETWORK_TASK
+    App.run_in_task(TaskAffinity::CONTROL,
+                    [trigger = this->parent_->get_client_connected_trigger(), info = this->client_info_,
+                     peer = this->client_peername_]() { trigger->trigger(info, peer); });
+#else
     this->parent_->get_client_connected_trigger()->trigger(this->client_info_, this->client_peername_);
+#endif
 #ifdef USE_HOMEASSISTANT_TIME
     if (homeassistant::global_homeassistant_time != nullptr) {
       this->send_time_request();
@@ -1169,16 +1260,19 @@ DeviceInfoResponse APIConnection::device_info(const DeviceInfoRequest &msg) {
 #endif
   return resp;
 }
-void APIConnection::on_home_assistant_state_response(const HomeAssistantStateResponse &msg) {
-  for (auto &it : this->parent_->get_state_subs()) {
+static void handle_home_assistant_state_response(const HomeAssistantStateResponse &msg) {
+  for (auto &it : global_api_server->get_state_subs()) {
     if (it.entity_id == msg.entity_id && it.attribute.value() == msg.attribute) {
       it.callback(msg.state);
     }
   }
 }
-void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
+void APIConnection::on_home_assistant_state_response(const HomeAssistantStateResponse &msg) {
+  run_on_control_task(handle_home_assistant_state_response, msg);
+}
+static void handle_execute_service(const ExecuteServiceRequest &msg) {
   bool found = false;
-  for (auto *service : this->parent_->get_user_services()) {
+  for (auto *service : global_api_server->get_user_services()) {
     if (service->execute_service(msg)) {
       found = true;
     }
@@ -1187,13 +1281,25 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
     ESP_LOGV(TAG, "Could not find matching service!");
   }
 }
+void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
+  run_on_control_task(handle_execute_service, msg);
+}
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
+  struct iovec payload;
+  payload.iov_base = buffer.get_buffer()->data();
+  payload.iov_len = buffer.get_buffer()->size();
+  return this->send_packet_(message_type, &payload, 1);
+}
+bool APIConnection::send_packet_(uint32_t message_type, const struct iovec *payload, int iovcnt) {
   if (this->remove_)
     return false;
   if (!this->helper_->can_write_without_blocking()) {
+    // the send buffer of a state pass is full, the rest of the states follow in the next pass
+    if (this->collecting_states_)
+      return false;
     delay(0);
     APIError err = this->helper_->loop();
     if (err != APIError::OK) {
@@ -1212,7 +1318,7 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  APIError err = this->helper_->write_packet(message_type, payload, iovcnt);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -1228,6 +1334,16 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
   // Do not set last_traffic_ on send
   return true;
 }
+bool APIConnection::uncork() {
+  APIError err = this->helper_->uncork();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Packet write failed %s errno=%d", this->client_combined_info_.c_str(), api_error_to_str(err),
+             errno);
+    return false;
+  }
+  return true;
+}
 void APIConnection::on_unauthenticated_access() {
   this->on_fatal_error();
   ESP_LOGD(TAG, "%s: tried to access without authentication.", this->client_combined_info_.c_str());
@@ -155,7 +155,7 @@ class APIConnection : public APIServerConnection {
   void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
   void subscribe_states(const SubscribeStatesRequest &msg) override {
     this->state_subscription_ = true;
-    this->initial_state_iterator_.begin();
+    this->state_cursor_.reset();
   }
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
@@ -185,6 +185,9 @@ class APIConnection : public APIServerConnection {
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
+  /// Collect the messages sent until uncork() into as few socket writes as possible.
+  void cork() { this->helper_->cork(); }
+  bool uncork();
 
   std::string get_client_combined_info() const { return this->client_combined_info_; }
 
@@ -192,6 +195,7 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  bool send_packet_(uint32_t message_type, const struct iovec *payload, int iovcnt);
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -213,6 +217,8 @@ class APIConnection : public APIServerConnection {
   uint32_t client_api_version_minor_{0};
 #ifdef USE_ESP32_CAMERA
   esp32_camera::CameraImageReader image_reader_;
+  uint16_t camera_chunk_size_{1024};
+  uint32_t camera_stats_start_{0};
 #endif
 
   bool state_subscription_{false};
@@ -225,6 +231,9 @@ class APIConnection : public APIServerConnection {
   bool next_close_ = false;
   APIServer *parent_;
   InitialStateIterator initial_state_iterator_;
+  StateTable::Cursor state_cursor_;
+  /// Set during a state pass, messages then only go into the send buffer.
+  bool collecting_states_{false};
   ListEntitiesIterator list_entities_iterator_;
   int state_subs_at_ = -1;
 };
@@ -5,12 +5,23 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
 #include "proto.h"
+#include <cinttypes>
 #include <cstring>
 
+#ifdef USE_API_NOISE
+#include <atomic>
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+#endif
+
 namespace esphome {
 namespace api {
 
 static const char *const TAG = "api.socket";
+/// Bytes collected while corked before writes go out anyway, about one TCP segment.
+static const size_t MAX_CORKED_SIZE = 1436;
 
 /// Is the given return value (from write syscalls) a wouldblock error?
 bool is_would_block(ssize_t ret) {
@@ -72,6 +83,17 @@ const char *api_error_to_str(APIError err) {
   return "UNKNOWN";
 }
 
+APIError APIFrameHelper::write_packet(uint16_t type, const struct iovec *payload, int iovcnt) {
+  if (iovcnt == 1)
+    return this->write_packet(type, reinterpret_cast<const uint8_t *>(payload[0].iov_base), payload[0].iov_len);
+  std::vector<uint8_t> data;
+  for (int i = 0; i < iovcnt; i++) {
+    auto *part = reinterpret_cast<const uint8_t *>(payload[i].iov_base);
+    data.insert(data.end(), part, part + payload[i].iov_len);
+  }
+  return this->write_packet(type, data.data(), data.size());
+}
+
 #define HELPER_LOG(msg, ...) ESP_LOGVV(TAG, "%s: " msg, info_.c_str(), ##__VA_ARGS__)
 // uncomment to log raw packets
 //#define HELPER_LOG_PACKETS
@@ -147,7 +169,13 @@ APIError APINoiseFrameHelper::init() {
 }
 /// Run through handshake messages (if in that phase)
 APIError APINoiseFrameHelper::loop() {
+#ifndef USE_ESP32
+  this->in_loop_ = true;
+  APIError err = state_action_();
+  this->in_loop_ = false;
+#else
   APIError err = state_action_();
+#endif
   if (err == APIError::WOULD_BLOCK)
     return APIError::OK;
   if (err != APIError::OK)
@@ -299,6 +327,8 @@ APIError APINoiseFrameHelper::state_action_() {
     prologue_.push_back((uint8_t) frame.msg.size());
     prologue_.insert(prologue_.end(), frame.msg.begin(), frame.msg.end());
 
+    handshake_started_ = millis();
+    handshake_crypto_us_ = 0;
     state_ = State::SERVER_HELLO;
   }
   if (state_ == State::SERVER_HELLO) {
@@ -324,6 +354,13 @@ APIError APINoiseFrameHelper::state_action_() {
     state_ = State::HANDSHAKE;
   }
   if (state_ == State::HANDSHAKE) {
+    if (handshake_job_ != nullptr)
+      return finish_handshake_write_();
+#ifndef USE_ESP32
+    // Without a worker the key exchange runs inline, do at most one message of it per main loop iteration
+    if (!in_loop_)
+      return APIError::WOULD_BLOCK;
+#endif
     int action = noise_handshakestate_get_action(handshake_);
     if (action == NOISE_ACTION_READ_MESSAGE) {
       // waiting for handshake msg
@@ -352,7 +389,9 @@ APIError APINoiseFrameHelper::state_action_() {
       NoiseBuffer mbuf;
       noise_buffer_init(mbuf);
       noise_buffer_set_input(mbuf, frame.msg.data() + 1, frame.msg.size() - 1);
+      const uint32_t start = micros();
       err = noise_handshakestate_read_message(handshake_, &mbuf, nullptr);
+      handshake_crypto_us_ += micros() - start;
       if (err != 0) {
         state_ = State::FAILED;
         HELPER_LOG("noise_handshakestate_read_message failed: %s", noise_err_to_str(err).c_str());
@@ -368,23 +407,7 @@ APIError APINoiseFrameHelper::state_action_() {
       if (aerr != APIError::OK)
         return aerr;
     } else if (action == NOISE_ACTION_WRITE_MESSAGE) {
-      uint8_t buffer[65];
-      NoiseBuffer mbuf;
-      noise_buffer_init(mbuf);
-      noise_buffer_set_output(mbuf, buffer + 1, sizeof(buffer) - 1);
-
-      err = noise_handshakestate_write_message(handshake_, &mbuf, nullptr);
-      if (err != 0) {
-        state_ = State::FAILED;
-        HELPER_LOG("noise_handshakestate_write_message failed: %s", noise_err_to_str(err).c_str());
-        return APIError::HANDSHAKESTATE_WRITE_FAILED;
-      }
-      buffer[0] = 0x00;  // success
-
-      aerr = write_frame_(buffer, mbuf.size + 1);
-      if (aerr != APIError::OK)
-        return aerr;
-      aerr = check_handshake_finished_();
+      aerr = start_handshake_write_();
       if (aerr != APIError::OK)
         return aerr;
     } else {
@@ -466,8 +489,22 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   buffer->type = type;
   return APIError::OK;
 }
-bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
+bool APINoiseFrameHelper::can_write_without_blocking() {
+  if (corked_)
+    return state_ == State::DATA && tx_buf_.size() < MAX_CORKED_SIZE;
+  return state_ == State::DATA && tx_buf_.empty();
+}
+APIError APINoiseFrameHelper::uncork() {
+  corked_ = false;
+  return try_send_tx_buf_();
+}
 APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+  struct iovec iov;
+  iov.iov_base = const_cast<uint8_t *>(payload);
+  iov.iov_len = payload_len;
+  return this->write_packet(type, &iov, 1);
+}
+APIError APINoiseFrameHelper::write_packet(uint16_t type, const struct iovec *payload, int iovcnt) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -479,48 +516,56 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
+  size_t payload_len = 0;
+  for (int i = 0; i < iovcnt; i++)
+    payload_len += payload[i].iov_len;
+
   size_t padding = 0;
   size_t msg_len = 4 + payload_len + padding;
   size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
 
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
+  // Build and encrypt the frame right at the end of tx_buf_, the socket is written from there
+  const size_t frame_offset = tx_buf_.size();
+  tx_buf_.resize(frame_offset + frame_len);
+  uint8_t *frame = &tx_buf_[frame_offset];
+
+  frame[0] = 0x01;  // indicator
+  // frame[1], frame[2] to be set later
   const uint8_t msg_offset = 3;
   const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t) (type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
+  frame[msg_offset + 0] = (uint8_t) (type >> 8);  // type
+  frame[msg_offset + 1] = (uint8_t) type;
+  frame[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
+  frame[msg_offset + 3] = (uint8_t) payload_len;
   // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  uint8_t *dst = &frame[payload_offset];
+  for (int i = 0; i < iovcnt; i++) {
+    auto *part = reinterpret_cast<const uint8_t *>(payload[i].iov_base);
+    dst = std::copy(part, part + payload[i].iov_len, dst);
+  }
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, &frame[msg_offset], msg_len, frame_len - msg_offset);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
+    tx_buf_.resize(frame_offset);
     state_ = State::FAILED;
     HELPER_LOG("noise_cipherstate_encrypt failed: %s", noise_err_to_str(err).c_str());
     return APIError::CIPHERSTATE_ENCRYPT_FAILED;
   }
 
-  size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t) (mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
-
-  struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
-  iov.iov_len = total_len;
+  frame[1] = (uint8_t) (mbuf.size >> 8);
+  frame[2] = (uint8_t) mbuf.size;
+  tx_buf_.resize(frame_offset + 3 + mbuf.size);
+#ifdef HELPER_LOG_PACKETS
+  ESP_LOGVV(TAG, "Sending raw: %s", format_hex_pretty(&tx_buf_[frame_offset], 3 + mbuf.size).c_str());
+#endif
 
-  // write raw to not have two packets sent if NAGLE disabled
-  return write_raw_(&iov, 1);
+  if (corked_)
+    return APIError::OK;
+  // sends everything in one write if nothing was pending, so NAGLE does not split the frame
+  return try_send_tx_buf_();
 }
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
@@ -561,15 +606,15 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
     total_write_len += iov[i].iov_len;
   }
 
-  if (!tx_buf_.empty()) {
+  if (!corked_ && !tx_buf_.empty()) {
     // try to empty tx_buf_ first
     aerr = try_send_tx_buf_();
     if (aerr != APIError::OK && aerr != APIError::WOULD_BLOCK)
       return aerr;
   }
 
-  if (!tx_buf_.empty()) {
-    // tx buf not empty, can't write now because then stream would be inconsistent
+  if (corked_ || !tx_buf_.empty()) {
+    // corked, or tx buf not empty, can't write now because then stream would be inconsistent
     for (int i = 0; i < iovcnt; i++) {
       tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
                      reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
@@ -675,6 +720,86 @@ APIError APINoiseFrameHelper::init_handshake_() {
   return APIError::OK;
 }
 
+struct HandshakeWriteJob {
+  NoiseHandshakeState *handshake{nullptr};
+  uint8_t buffer[65];
+  size_t size{0};
+  int err{0};
+  uint32_t duration_us{0};
+  std::atomic<bool> done{false};
+
+  ~HandshakeWriteJob() {
+    // Still owned when the connection closed before the reply was computed
+    if (this->handshake != nullptr)
+      noise_handshakestate_free(this->handshake);
+  }
+
+  void run() {
+    const uint32_t start = micros();
+    NoiseBuffer mbuf;
+    noise_buffer_init(mbuf);
+    noise_buffer_set_output(mbuf, this->buffer + 1, sizeof(this->buffer) - 1);
+    this->err = noise_handshakestate_write_message(this->handshake, &mbuf, nullptr);
+    this->size = mbuf.size;
+    this->duration_us = micros() - start;
+    this->done = true;
+  }
+};
+
+#ifdef USE_ESP32
+static const uint32_t HANDSHAKE_TASK_STACK_SIZE = 4096;
+
+static void handshake_write_task(void *params) {
+  auto *job = reinterpret_cast<std::shared_ptr<HandshakeWriteJob> *>(params);
+  (*job)->run();
+  delete job;  // NOLINT(cppcoreguidelines-owning-memory)
+  vTaskDelete(nullptr);
+}
+#endif
+
+/** Compute the handshake reply, which generates the ephemeral key and does the Curve25519 key exchange.
+ *
+ * That takes tens of milliseconds, or hundreds on slow chips. On ESP32 it runs on a short-lived task at the priority
+ * of the caller, so the loop keeps running in the meantime, also on single core chips. The job owns the handshake
+ * state until finish_handshake_write_() takes it back, so the connection may close in the meantime.
+ */
+APIError APINoiseFrameHelper::start_handshake_write_() {
+  handshake_job_ = std::make_shared<HandshakeWriteJob>();
+  handshake_job_->handshake = handshake_;
+  handshake_ = nullptr;
+#ifdef USE_ESP32
+  auto *params = new std::shared_ptr<HandshakeWriteJob>(handshake_job_);  // NOLINT(cppcoreguidelines-owning-memory)
+  if (xTaskCreate(handshake_write_task, "api_handshake", HANDSHAKE_TASK_STACK_SIZE, params,
+                  uxTaskPriorityGet(nullptr), nullptr) == pdPASS)
+    return finish_handshake_write_();
+  // Not enough memory for the task, compute it right here
+  delete params;  // NOLINT(cppcoreguidelines-owning-memory)
+#endif
+  handshake_job_->run();
+  return finish_handshake_write_();
+}
+
+APIError APINoiseFrameHelper::finish_handshake_write_() {
+  if (!handshake_job_->done)
+    return APIError::WOULD_BLOCK;
+  std::shared_ptr<HandshakeWriteJob> job = std::move(handshake_job_);
+  handshake_ = job->handshake;
+  job->handshake = nullptr;
+  handshake_crypto_us_ += job->duration_us;
+
+  if (job->err != 0) {
+    state_ = State::FAILED;
+    HELPER_LOG("noise_handshakestate_write_message failed: %s", noise_err_to_str(job->err).c_str());
+    return APIError::HANDSHAKESTATE_WRITE_FAILED;
+  }
+  job->buffer[0] = 0x00;  // success
+
+  APIError aerr = write_frame_(job->buffer, job->size + 1);
+  if (aerr != APIError::OK)
+    return aerr;
+  return check_handshake_finished_();
+}
+
 APIError APINoiseFrameHelper::check_handshake_finished_() {
   assert(state_ == State::HANDSHAKE);
 
@@ -694,6 +819,8 @@ APIError APINoiseFrameHelper::check_handshake_finished_() {
   }
 
   HELPER_LOG("Handshake complete!");
+  ESP_LOGD(TAG, "%s: Handshake took %" PRIu32 " ms, %" PRIu32 " ms of it computing keys", info_.c_str(),
+           millis() - handshake_started_, handshake_crypto_us_ / 1000);
   noise_handshakestate_free(handshake_);
   handshake_ = nullptr;
   state_ = State::DATA;
@@ -902,7 +1029,15 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   buffer->type = rx_header_parsed_type_;
   return APIError::OK;
 }
-bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
+bool APIPlaintextFrameHelper::can_write_without_blocking() {
+  if (corked_)
+    return state_ == State::DATA && tx_buf_.size() < MAX_CORKED_SIZE;
+  return state_ == State::DATA && tx_buf_.empty();
+}
+APIError APIPlaintextFrameHelper::uncork() {
+  corked_ = false;
+  return try_send_tx_buf_();
+}
 APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
@@ -924,6 +1059,25 @@ APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *pay
 
   return write_raw_(iov, 2);
 }
+APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const struct iovec *payload, int iovcnt) {
+  if (state_ != State::DATA) {
+    return APIError::BAD_STATE;
+  }
+
+  size_t payload_len = 0;
+  for (int i = 0; i < iovcnt; i++)
+    payload_len += payload[i].iov_len;
+  std::vector<uint8_t> header;
+  header.push_back(0x00);
+  ProtoVarInt(payload_len).encode(header);
+  ProtoVarInt(type).encode(header);
+
+  std::vector<struct iovec> iov(iovcnt + 1);
+  iov[0].iov_base = &header[0];
+  iov[0].iov_len = header.size();
+  std::copy(payload, payload + iovcnt, iov.begin() + 1);
+  return write_raw_(iov.data(), iov.size());
+}
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
@@ -961,15 +1115,15 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
     total_write_len += iov[i].iov_len;
   }
 
-  if (!tx_buf_.empty()) {
+  if (!corked_ && !tx_buf_.empty()) {
     // try to empty tx_buf_ first
     aerr = try_send_tx_buf_();
     if (aerr != APIError::OK && aerr != APIError::WOULD_BLOCK)
       return aerr;
   }
 
-  if (!tx_buf_.empty()) {
-    // tx buf not empty, can't write now because then stream would be inconsistent
+  if (corked_ || !tx_buf_.empty()) {
+    // corked, or tx buf not empty, can't write now because then stream would be inconsistent
     for (int i = 0; i < iovcnt; i++) {
       tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
                      reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -66,6 +67,13 @@ class APIFrameHelper {
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
   virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /// Write a packet whose payload is spread over several buffers, by default gathered into one copy.
+  virtual APIError write_packet(uint16_t type, const struct iovec *payload, int iovcnt);
+  /// Collect the packets written from now on, so that a burst of small messages leaves in as few segments as
+  /// possible. Writes never block while corked, until the collected bytes exceed a segment.
+  virtual void cork() = 0;
+  /// Send the packets collected since cork().
+  virtual APIError uncork() = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
@@ -75,6 +83,9 @@ class APIFrameHelper {
 };
 
 #ifdef USE_API_NOISE
+/// Computes the handshake reply with the ephemeral key exchange, see APINoiseFrameHelper::start_handshake_write_().
+struct HandshakeWriteJob;
+
 class APINoiseFrameHelper : public APIFrameHelper {
  public:
   APINoiseFrameHelper(std::unique_ptr<socket::Socket> socket, std::shared_ptr<APINoiseContext> ctx)
@@ -85,6 +96,10 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
   APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  /// Gathers the payload buffers straight into the send buffer and encrypts the frame in place there.
+  APIError write_packet(uint16_t type, const struct iovec *payload, int iovcnt) override;
+  void cork() override { this->corked_ = true; }
+  APIError uncork() override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -105,6 +120,8 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError write_frame_(const uint8_t *data, size_t len);
   APIError write_raw_(const struct iovec *iov, int iovcnt);
   APIError init_handshake_();
+  APIError start_handshake_write_();
+  APIError finish_handshake_write_();
   APIError check_handshake_finished_();
   void send_explicit_handshake_reject_(const std::string &reason);
 
@@ -117,6 +134,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
   size_t rx_buf_len_ = 0;
 
   std::vector<uint8_t> tx_buf_;
+  bool corked_{false};
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -124,6 +142,13 @@ class APINoiseFrameHelper : public APIFrameHelper {
   NoiseCipherState *send_cipher_{nullptr};
   NoiseCipherState *recv_cipher_{nullptr};
   NoiseProtocolId nid_;
+  /// Owns the handshake state while the reply is computed
+  std::shared_ptr<HandshakeWriteJob> handshake_job_;
+  uint32_t handshake_started_{0};
+  uint32_t handshake_crypto_us_{0};
+#ifndef USE_ESP32
+  bool in_loop_{false};
+#endif
 
   enum class State {
     INITIALIZE = 1,
@@ -148,6 +173,10 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
   APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  /// Hands the payload buffers straight to the socket, without copying them.
+  APIError write_packet(uint16_t type, const struct iovec *payload, int iovcnt) override;
+  void cork() override { this->corked_ = true; }
+  APIError uncork() override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -178,6 +207,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   size_t rx_buf_len_ = 0;
 
   std::vector<uint8_t> tx_buf_;
+  bool corked_{false};
 
   enum class State {
     INITIALIZE = 1,
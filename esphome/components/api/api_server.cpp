@@ -23,7 +23,7 @@ static const char *const TAG = "api";
 // APIServer
 void APIServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Home Assistant API server...");
-  this->setup_controller();
+  App.state_table.init();
   socket_ = socket::socket_ip(SOCK_STREAM, 0);
   if (socket_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket.");
@@ -69,6 +69,17 @@ void APIServer::setup() {
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
     logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
+#ifdef USE_NETWORK_TASK
+      if (!App.in_task(TaskAffinity::NETWORK)) {
+        App.run_in_task(TaskAffinity::NETWORK, [this, level, tag, line = std::string(message)]() {
+          for (auto &c : this->clients_) {
+            if (!c->remove_)
+              c->send_log_message(level, tag, line.c_str());
+          }
+        });
+        return;
+      }
+#endif
       for (auto &c : this->clients_) {
         if (!c->remove_)
           c->send_log_message(level, tag, message);
@@ -111,7 +122,13 @@ void APIServer::loop() {
                                 [](const std::unique_ptr<APIConnection> &conn) { return !conn->remove_; });
   // print disconnection messages
   for (auto it = new_end; it != this->clients_.end(); ++it) {
+#ifdef USE_NETWORK_TASK
+    App.run_in_task(TaskAffinity::CONTROL, [this, info = (*it)->client_info_, peer = (*it)->client_peername_]() {
+      this->client_disconnected_trigger_->trigger(info, peer);
+    });
+#else
     this->client_disconnected_trigger_->trigger((*it)->client_info_, (*it)->client_peername_);
+#endif
     ESP_LOGV(TAG, "Removing connection to %s", (*it)->client_info_.c_str());
   }
   // resize vector
@@ -126,7 +143,11 @@ void APIServer::loop() {
     if (!this->is_connected()) {
       if (now - this->last_connected_ > this->reboot_timeout_) {
         ESP_LOGE(TAG, "No client connected to API. Rebooting...");
+#ifdef USE_NETWORK_TASK
+        App.run_in_task(TaskAffinity::CONTROL, []() { App.reboot(); });
+#else
         App.reboot();
+#endif
       }
       this->status_set_warning();
     } else {
@@ -174,129 +195,18 @@ bool APIServer::check_password(const std::string &password) const {
   return result == 0;
 }
 void APIServer::handle_disconnect(APIConnection *conn) {}
-#ifdef USE_BINARY_SENSOR
-void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_binary_sensor_state(obj, state);
-}
-#endif
-
-#ifdef USE_COVER
-void APIServer::on_cover_update(cover::Cover *obj) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_cover_state(obj);
-}
-#endif
-
-#ifdef USE_FAN
-void APIServer::on_fan_update(fan::Fan *obj) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_fan_state(obj);
-}
-#endif
-
-#ifdef USE_LIGHT
-void APIServer::on_light_update(light::LightState *obj) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_light_state(obj);
-}
-#endif
-
-#ifdef USE_SENSOR
-void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_sensor_state(obj, state);
-}
-#endif
-
-#ifdef USE_SWITCH
-void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_switch_state(obj, state);
-}
-#endif
-
-#ifdef USE_TEXT_SENSOR
-void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_text_sensor_state(obj, state);
-}
-#endif
-
-#ifdef USE_CLIMATE
-void APIServer::on_climate_update(climate::Climate *obj) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_climate_state(obj);
-}
-#endif
-
-#ifdef USE_NUMBER
-void APIServer::on_number_update(number::Number *obj, float state) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_number_state(obj, state);
-}
-#endif
-
-#ifdef USE_TEXT
-void APIServer::on_text_update(text::Text *obj, const std::string &state) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_text_state(obj, state);
-}
-#endif
-
-#ifdef USE_SELECT
-void APIServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_select_state(obj, state);
-}
-#endif
-
-#ifdef USE_LOCK
-void APIServer::on_lock_update(lock::Lock *obj) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_lock_state(obj, obj->state);
-}
-#endif
-
-#ifdef USE_MEDIA_PLAYER
-void APIServer::on_media_player_update(media_player::MediaPlayer *obj) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_media_player_state(obj);
-}
-#endif
-
 float APIServer::get_setup_priority() const { return setup_priority::AFTER_WIFI; }
 void APIServer::set_port(uint16_t port) { this->port_ = port; }
 APIServer *global_api_server = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 void APIServer::set_password(const std::string &password) { this->password_ = password; }
 void APIServer::send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
+#ifdef USE_NETWORK_TASK
+  if (!App.in_task(TaskAffinity::NETWORK)) {
+    App.run_in_task(TaskAffinity::NETWORK, [this, call]() { this->send_homeassistant_service_call(call); });
+    return;
+  }
+#endif
   for (auto &client : this->clients_) {
     client->send_homeassistant_service_call(call);
   }
@@ -318,6 +228,12 @@ uint16_t APIServer::get_port() const { return this->port_; }
 void APIServer::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
 #ifdef USE_HOMEASSISTANT_TIME
 void APIServer::request_time() {
+#ifdef USE_NETWORK_TASK
+  if (!App.in_task(TaskAffinity::NETWORK)) {
+    App.run_in_task(TaskAffinity::NETWORK, [this]() { this->request_time(); });
+    return;
+  }
+#endif
   for (auto &client : this->clients_) {
     if (!client->remove_ && client->is_authenticated())
       client->send_time_request();
@@ -332,14 +248,5 @@ void APIServer::on_shutdown() {
   delay(10);
 }
 
-#ifdef USE_ALARM_CONTROL_PANEL
-void APIServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
-  if (obj->is_internal())
-    return;
-  for (auto &c : this->clients_)
-    c->send_alarm_control_panel_state(obj);
-}
-#endif
-
 }  // namespace api
 }  // namespace esphome
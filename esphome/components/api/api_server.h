@@ -6,7 +6,6 @@
 #include "esphome/components/socket/socket.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
-#include "esphome/core/controller.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/log.h"
 #include "list_entities.h"
@@ -18,12 +17,15 @@
 namespace esphome {
 namespace api {
 
-class APIServer : public Component, public Controller {
+class APIServer : public Component {
  public:
   APIServer();
   void setup() override;
   uint16_t get_port() const;
   float get_setup_priority() const override;
+#ifdef USE_NETWORK_TASK
+  TaskAffinity get_task_affinity() const override { return TaskAffinity::NETWORK; }
+#endif
   void loop() override;
   void dump_config() override;
   void on_shutdown() override;
@@ -39,55 +41,12 @@ class APIServer : public Component, public Controller {
 #endif  // USE_API_NOISE
 
   void handle_disconnect(APIConnection *conn);
-#ifdef USE_BINARY_SENSOR
-  void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
-#endif
-#ifdef USE_COVER
-  void on_cover_update(cover::Cover *obj) override;
-#endif
-#ifdef USE_FAN
-  void on_fan_update(fan::Fan *obj) override;
-#endif
-#ifdef USE_LIGHT
-  void on_light_update(light::LightState *obj) override;
-#endif
-#ifdef USE_SENSOR
-  void on_sensor_update(sensor::Sensor *obj, float state) override;
-#endif
-#ifdef USE_SWITCH
-  void on_switch_update(switch_::Switch *obj, bool state) override;
-#endif
-#ifdef USE_TEXT_SENSOR
-  void on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) override;
-#endif
-#ifdef USE_CLIMATE
-  void on_climate_update(climate::Climate *obj) override;
-#endif
-#ifdef USE_NUMBER
-  void on_number_update(number::Number *obj, float state) override;
-#endif
-#ifdef USE_TEXT
-  void on_text_update(text::Text *obj, const std::string &state) override;
-#endif
-#ifdef USE_SELECT
-  void on_select_update(select::Select *obj, const std::string &state, size_t index) override;
-#endif
-#ifdef USE_LOCK
-  void on_lock_update(lock::Lock *obj) override;
-#endif
-#ifdef USE_MEDIA_PLAYER
-  void on_media_player_update(media_player::MediaPlayer *obj) override;
-#endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call);
   void register_user_service(UserServiceDescriptor *descriptor) { this->user_services_.push_back(descriptor); }
 #ifdef USE_HOMEASSISTANT_TIME
   void request_time();
 #endif
 
-#ifdef USE_ALARM_CONTROL_PANEL
-  void on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) override;
-#endif
-
   bool is_connected() const;
 
   struct HomeAssistantStateSubscription {
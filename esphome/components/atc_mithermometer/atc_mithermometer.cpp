@@ -58,14 +58,18 @@ optional<ParseResult> ATCMiThermometer::parse_header_(const esp32_ble_tracker::S
     return {};
   }
 
-  auto raw = service_data.data;
+  const auto &raw = service_data.data;
+  if (raw.size() <= 12) {
+    ESP_LOGVV(TAG, "parse_header(): payload has wrong size (%d)!", raw.size());
+    return {};
+  }
 
-  static uint8_t last_frame_count = 0;
-  if (last_frame_count == raw[12]) {
-    ESP_LOGVV(TAG, "parse_header(): duplicate data packet received (%hhu).", last_frame_count);
+  // Skip the repeated advertisements of a measurement before parsing them
+  if (this->last_frame_count_.has_value() && *this->last_frame_count_ == raw[12]) {
+    ESP_LOGVV(TAG, "parse_header(): duplicate data packet received (%hhu).", raw[12]);
     return {};
   }
-  last_frame_count = raw[12];
+  this->last_frame_count_ = raw[12];
 
   return result;
 }
@@ -1,9 +1,13 @@
 #include "bluetooth_connection.h"
 
 #include "esphome/components/api/api_pb2.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 #ifdef USE_ESP32
 
 #include "bluetooth_proxy.h"
@@ -12,6 +16,12 @@ namespace esphome {
 namespace bluetooth_proxy {
 
 static const char *const TAG = "bluetooth_proxy.connection";
+/// Operations handed to the stack at once, within its command queue of each connection.
+static const uint8_t MAX_IN_FLIGHT = 4;
+static const size_t MAX_QUEUED_OPERATIONS = 64;
+/// Notifications held for the proxy loop, more are sent right away.
+static const size_t MAX_PENDING_NOTIFICATIONS = 16;
+static const uint32_t STATS_INTERVAL = 60000;
 
 bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                                               esp_ble_gattc_cb_param_t *param) {
@@ -20,6 +30,8 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
 
   switch (event) {
     case ESP_GATTC_DISCONNECT_EVT: {
+      this->proxy_->send_notifications();
+      this->clear_operations_();
       this->proxy_->send_device_connection(this->address_, false, 0, param->disconnect.reason);
       this->set_address(0);
       this->proxy_->send_connections_free();
@@ -67,10 +79,21 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
       this->proxy_->send_connections_free();
       break;
     }
+    case ESP_GATTC_CONGEST_EVT: {
+      if (param->congest.conn_id != this->conn_id_)
+        break;
+      this->congested_ = param->congest.congested;
+      if (!this->congested_)
+        this->issue_operations_();
+      break;
+    }
     case ESP_GATTC_READ_DESCR_EVT:
     case ESP_GATTC_READ_CHAR_EVT: {
       if (param->read.conn_id != this->conn_id_)
         break;
+      this->complete_operation_(false, param->read.handle);
+      // Notifications received before this response go out before it
+      this->proxy_->send_notifications();
       if (param->read.status != ESP_GATT_OK) {
         ESP_LOGW(TAG, "[%d] [%s] Error reading char/descriptor at handle 0x%2X, status=%d", this->connection_index_,
                  this->address_str_.c_str(), param->read.handle, param->read.status);
@@ -91,6 +114,9 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
     case ESP_GATTC_WRITE_DESCR_EVT: {
       if (param->write.conn_id != this->conn_id_)
         break;
+      // The descriptor write of a notification registration is not one of ours and completes nothing
+      this->complete_operation_(true, param->write.handle);
+      this->proxy_->send_notifications();
       if (param->write.status != ESP_GATT_OK) {
         ESP_LOGW(TAG, "[%d] [%s] Error writing char/descriptor at handle 0x%2X, status=%d", this->connection_index_,
                  this->address_str_.c_str(), param->write.handle, param->write.status);
@@ -104,6 +130,7 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
       break;
     }
     case ESP_GATTC_UNREG_FOR_NOTIFY_EVT: {
+      this->proxy_->send_notifications();
       if (param->unreg_for_notify.status != ESP_GATT_OK) {
         ESP_LOGW(TAG, "[%d] [%s] Error unregistering notifications for handle 0x%2X, status=%d",
                  this->connection_index_, this->address_str_.c_str(), param->unreg_for_notify.handle,
@@ -118,6 +145,7 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
       break;
     }
     case ESP_GATTC_REG_FOR_NOTIFY_EVT: {
+      this->proxy_->send_notifications();
       if (param->reg_for_notify.status != ESP_GATT_OK) {
         ESP_LOGW(TAG, "[%d] [%s] Error registering notifications for handle 0x%2X, status=%d", this->connection_index_,
                  this->address_str_.c_str(), param->reg_for_notify.handle, param->reg_for_notify.status);
@@ -135,14 +163,15 @@ bool BluetoothConnection::gattc_event_handler(esp_gattc_cb_event_t event, esp_ga
         break;
       ESP_LOGV(TAG, "[%d] [%s] ESP_GATTC_NOTIFY_EVT: handle=0x%2X", this->connection_index_, this->address_str_.c_str(),
                param->notify.handle);
-      api::BluetoothGATTNotifyDataResponse resp;
+      // Sent together with the other notifications of this loop iteration
+      this->notifications_.emplace_back();
+      api::BluetoothGATTNotifyDataResponse &resp = this->notifications_.back();
       resp.address = this->address_;
       resp.handle = param->notify.handle;
-      resp.data.reserve(param->notify.value_len);
-      for (uint16_t i = 0; i < param->notify.value_len; i++) {
-        resp.data.push_back(param->notify.value[i]);
-      }
-      this->proxy_->get_api_connection()->send_bluetooth_gatt_notify_data_response(resp);
+      resp.data.assign(param->notify.value, param->notify.value + param->notify.value_len);
+      this->stats_notifications_++;
+      if (this->notifications_.size() >= MAX_PENDING_NOTIFICATIONS)
+        this->proxy_->send_notifications();
       break;
     }
     default:
@@ -170,82 +199,140 @@ void BluetoothConnection::gap_event_handler(esp_gap_ble_cb_event_t event, esp_bl
 }
 
 esp_err_t BluetoothConnection::read_characteristic(uint16_t handle) {
-  if (!this->connected()) {
-    ESP_LOGW(TAG, "[%d] [%s] Cannot read GATT characteristic, not connected.", this->connection_index_,
-             this->address_str_.c_str());
-    return ESP_GATT_NOT_CONNECTED;
-  }
-
   ESP_LOGV(TAG, "[%d] [%s] Reading GATT characteristic handle %d", this->connection_index_, this->address_str_.c_str(),
            handle);
-
-  esp_err_t err = esp_ble_gattc_read_char(this->gattc_if_, this->conn_id_, handle, ESP_GATT_AUTH_REQ_NONE);
-  if (err != ERR_OK) {
-    ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_read_char error, err=%d", this->connection_index_,
-             this->address_str_.c_str(), err);
-    return err;
-  }
-  return ESP_OK;
+  return this->queue_operation_(GATTOperation::READ_CHARACTERISTIC, handle, {}, true);
 }
 
 esp_err_t BluetoothConnection::write_characteristic(uint16_t handle, const std::string &data, bool response) {
-  if (!this->connected()) {
-    ESP_LOGW(TAG, "[%d] [%s] Cannot write GATT characteristic, not connected.", this->connection_index_,
-             this->address_str_.c_str());
-    return ESP_GATT_NOT_CONNECTED;
-  }
   ESP_LOGV(TAG, "[%d] [%s] Writing GATT characteristic handle %d", this->connection_index_, this->address_str_.c_str(),
            handle);
-
-  esp_err_t err =
-      esp_ble_gattc_write_char(this->gattc_if_, this->conn_id_, handle, data.size(), (uint8_t *) data.data(),
-                               response ? ESP_GATT_WRITE_TYPE_RSP : ESP_GATT_WRITE_TYPE_NO_RSP, ESP_GATT_AUTH_REQ_NONE);
-  if (err != ERR_OK) {
-    ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_write_char error, err=%d", this->connection_index_,
-             this->address_str_.c_str(), err);
-    return err;
-  }
-  return ESP_OK;
+  return this->queue_operation_(GATTOperation::WRITE_CHARACTERISTIC, handle, data, response);
 }
 
 esp_err_t BluetoothConnection::read_descriptor(uint16_t handle) {
-  if (!this->connected()) {
-    ESP_LOGW(TAG, "[%d] [%s] Cannot read GATT descriptor, not connected.", this->connection_index_,
-             this->address_str_.c_str());
-    return ESP_GATT_NOT_CONNECTED;
-  }
   ESP_LOGV(TAG, "[%d] [%s] Reading GATT descriptor handle %d", this->connection_index_, this->address_str_.c_str(),
            handle);
-
-  esp_err_t err = esp_ble_gattc_read_char_descr(this->gattc_if_, this->conn_id_, handle, ESP_GATT_AUTH_REQ_NONE);
-  if (err != ERR_OK) {
-    ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_read_char_descr error, err=%d", this->connection_index_,
-             this->address_str_.c_str(), err);
-    return err;
-  }
-  return ESP_OK;
+  return this->queue_operation_(GATTOperation::READ_DESCRIPTOR, handle, {}, true);
 }
 
 esp_err_t BluetoothConnection::write_descriptor(uint16_t handle, const std::string &data, bool response) {
-  if (!this->connected()) {
-    ESP_LOGW(TAG, "[%d] [%s] Cannot write GATT descriptor, not connected.", this->connection_index_,
-             this->address_str_.c_str());
-    return ESP_GATT_NOT_CONNECTED;
-  }
   ESP_LOGV(TAG, "[%d] [%s] Writing GATT descriptor handle %d", this->connection_index_, this->address_str_.c_str(),
            handle);
+  return this->queue_operation_(GATTOperation::WRITE_DESCRIPTOR, handle, data, response);
+}
 
-  esp_err_t err = esp_ble_gattc_write_char_descr(
-      this->gattc_if_, this->conn_id_, handle, data.size(), (uint8_t *) data.data(),
-      response ? ESP_GATT_WRITE_TYPE_RSP : ESP_GATT_WRITE_TYPE_NO_RSP, ESP_GATT_AUTH_REQ_NONE);
-  if (err != ERR_OK) {
-    ESP_LOGW(TAG, "[%d] [%s] esp_ble_gattc_write_char_descr error, err=%d", this->connection_index_,
-             this->address_str_.c_str(), err);
-    return err;
+esp_err_t BluetoothConnection::queue_operation_(GATTOperation::Type type, uint16_t handle, const std::string &data,
+                                                bool response) {
+  if (!this->connected()) {
+    ESP_LOGW(TAG, "[%d] [%s] Cannot access GATT handle %d, not connected.", this->connection_index_,
+             this->address_str_.c_str(), handle);
+    return ESP_GATT_NOT_CONNECTED;
+  }
+  if (this->operations_.size() >= MAX_QUEUED_OPERATIONS) {
+    ESP_LOGW(TAG, "[%d] [%s] Cannot access GATT handle %d, %u operations queued already.", this->connection_index_,
+             this->address_str_.c_str(), handle, (unsigned) this->operations_.size());
+    return ESP_GATT_NO_RESOURCES;
   }
+  this->operations_.push_back(GATTOperation{type, response, handle, millis(), data});
+  this->stats_max_depth_ = std::max<uint16_t>(this->stats_max_depth_, this->operations_.size());
+  this->issue_operations_();
   return ESP_OK;
 }
 
+void BluetoothConnection::issue_operations_() {
+  // The stack keeps the order of the operations handed to it, completions are matched by handle though
+  while (this->in_flight_ < MAX_IN_FLIGHT && this->in_flight_ < this->operations_.size() && !this->congested_) {
+    auto &op = this->operations_[this->in_flight_];
+    const esp_gatt_write_type_t write_type = op.response ? ESP_GATT_WRITE_TYPE_RSP : ESP_GATT_WRITE_TYPE_NO_RSP;
+    const char *call;
+    esp_err_t err;
+    switch (op.type) {
+      case GATTOperation::READ_CHARACTERISTIC:
+        call = "esp_ble_gattc_read_char";
+        err = esp_ble_gattc_read_char(this->gattc_if_, this->conn_id_, op.handle, ESP_GATT_AUTH_REQ_NONE);
+        break;
+      case GATTOperation::WRITE_CHARACTERISTIC:
+        call = "esp_ble_gattc_write_char";
+        err = esp_ble_gattc_write_char(this->gattc_if_, this->conn_id_, op.handle, op.data.size(),
+                                       (uint8_t *) op.data.data(), write_type, ESP_GATT_AUTH_REQ_NONE);
+        break;
+      case GATTOperation::READ_DESCRIPTOR:
+        call = "esp_ble_gattc_read_char_descr";
+        err = esp_ble_gattc_read_char_descr(this->gattc_if_, this->conn_id_, op.handle, ESP_GATT_AUTH_REQ_NONE);
+        break;
+      case GATTOperation::WRITE_DESCRIPTOR:
+      default:
+        call = "esp_ble_gattc_write_char_descr";
+        err = esp_ble_gattc_write_char_descr(this->gattc_if_, this->conn_id_, op.handle, op.data.size(),
+                                             (uint8_t *) op.data.data(), write_type, ESP_GATT_AUTH_REQ_NONE);
+        break;
+    }
+    if (err == ESP_OK) {
+      // The stack copied the data
+      op.data.clear();
+      op.data.shrink_to_fit();
+      this->in_flight_++;
+      continue;
+    }
+    // Nothing will complete this one, fail it and go on with the next
+    ESP_LOGW(TAG, "[%d] [%s] %s error, err=%d", this->connection_index_, this->address_str_.c_str(), call, err);
+    const uint16_t handle = op.handle;
+    this->operations_.erase(this->operations_.begin() + this->in_flight_);
+    this->proxy_->send_gatt_error(this->address_, handle, err);
+  }
+}
+
+bool BluetoothConnection::complete_operation_(bool write, uint16_t handle) {
+  // Completions come in issue order, but the client base issues writes of its own, so match the handle
+  for (uint8_t i = 0; i < this->in_flight_; i++) {
+    auto it = this->operations_.begin() + i;
+    const bool is_write =
+        it->type == GATTOperation::WRITE_CHARACTERISTIC || it->type == GATTOperation::WRITE_DESCRIPTOR;
+    if (is_write != write || it->handle != handle)
+      continue;
+    const uint32_t latency = millis() - it->queued;
+    this->stats_operations_++;
+    this->stats_latency_ += latency;
+    this->stats_max_latency_ = std::max(this->stats_max_latency_, latency);
+    this->operations_.erase(it);
+    this->in_flight_--;
+    this->issue_operations_();
+    return true;
+  }
+  ESP_LOGV(TAG, "[%d] [%s] GATT completion for handle 0x%2X without an operation in flight", this->connection_index_,
+           this->address_str_.c_str(), handle);
+  return false;
+}
+
+void BluetoothConnection::clear_operations_() {
+  this->operations_.clear();
+  this->in_flight_ = 0;
+  this->congested_ = false;
+  this->notifications_.clear();
+}
+
+void BluetoothConnection::log_stats_() {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->stats_start_;
+  if (elapsed < STATS_INTERVAL)
+    return;
+  if (this->stats_operations_ != 0 || this->stats_notifications_ != 0) {
+    ESP_LOGD(TAG,
+             "[%d] [%s] GATT: %" PRIu32 " operations, latency %" PRIu32 " ms average, %" PRIu32
+             " ms max, queue depth max %u, %" PRIu32 " notifications",
+             this->connection_index_, this->address_str_.c_str(), this->stats_operations_,
+             this->stats_operations_ != 0 ? this->stats_latency_ / this->stats_operations_ : 0,
+             this->stats_max_latency_, this->stats_max_depth_, this->stats_notifications_);
+  }
+  this->stats_operations_ = 0;
+  this->stats_latency_ = 0;
+  this->stats_max_latency_ = 0;
+  this->stats_max_depth_ = this->operations_.size();
+  this->stats_notifications_ = 0;
+  this->stats_start_ = now;
+}
+
 esp_err_t BluetoothConnection::notify_characteristic(uint16_t handle, bool enable) {
   if (!this->connected()) {
     ESP_LOGW(TAG, "[%d] [%s] Cannot notify GATT characteristic, not connected.", this->connection_index_,
@@ -2,8 +2,13 @@
 
 #ifdef USE_ESP32
 
+#include "esphome/components/api/api_pb2.h"
 #include "esphome/components/esp32_ble_client/ble_client_base.h"
 
+#include <deque>
+#include <string>
+#include <vector>
+
 namespace esphome {
 namespace bluetooth_proxy {
 
@@ -25,10 +30,47 @@ class BluetoothConnection : public esp32_ble_client::BLEClientBase {
 
  protected:
   friend class BluetoothProxy;
+
+  /// A read or write from the API, waiting for or in flight on the air.
+  struct GATTOperation {
+    enum Type : uint8_t {
+      READ_CHARACTERISTIC,
+      WRITE_CHARACTERISTIC,
+      READ_DESCRIPTOR,
+      WRITE_DESCRIPTOR,
+    } type;
+    bool response;
+    uint16_t handle;
+    uint32_t queued;
+    std::string data;
+  };
+
+  esp_err_t queue_operation_(GATTOperation::Type type, uint16_t handle, const std::string &data, bool response);
+  /// Hand queued operations to the stack, as many as it accepts without answering busy.
+  void issue_operations_();
+  /// An operation in flight got its completion event, false if none matches the handle.
+  bool complete_operation_(bool write, uint16_t handle);
+  void clear_operations_();
+  void log_stats_();
+
   bool seen_mtu_or_services_{false};
 
   int16_t send_service_{-2};
   BluetoothProxy *proxy_;
+
+  // Operations in order, the first in_flight_ of them were handed to the stack already
+  std::deque<GATTOperation> operations_;
+  uint8_t in_flight_{0};
+  bool congested_{false};
+  // Notifications received since the proxy last sent them to the API
+  std::vector<api::BluetoothGATTNotifyDataResponse> notifications_;
+
+  uint32_t stats_operations_{0};
+  uint32_t stats_latency_{0};
+  uint32_t stats_max_latency_{0};
+  uint16_t stats_max_depth_{0};
+  uint32_t stats_notifications_{0};
+  uint32_t stats_start_{0};
 };
 
 }  // namespace bluetooth_proxy
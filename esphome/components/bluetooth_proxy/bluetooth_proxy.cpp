@@ -10,6 +10,12 @@ namespace bluetooth_proxy {
 
 static const char *const TAG = "bluetooth_proxy";
 static const int DONE_SENDING_SERVICES = -2;
+/// Bytes of services in one response, keeps it within a TCP segment.
+static const size_t MAX_SERVICES_RESPONSE_SIZE = 1360;
+/// Upper bounds of the encoded entries, the uuids take most of them.
+static const size_t ENCODED_SERVICE_SIZE = 30;
+static const size_t ENCODED_CHARACTERISTIC_SIZE = 34;
+static const size_t ENCODED_DESCRIPTOR_SIZE = 30;
 
 std::vector<uint64_t> get_128bit_uuid_vec(esp_bt_uuid_t uuid_source) {
   esp_bt_uuid_t uuid = espbt::ESPBTUUID::from_uuid(uuid_source).as_128bit().get_uuid();
@@ -112,7 +118,10 @@ void BluetoothProxy::loop() {
     }
     return;
   }
+  this->send_notifications();
   for (auto *connection : this->connections_) {
+    if (connection->get_address() != 0)
+      connection->log_stats_();
     if (connection->send_service_ == connection->service_count_) {
       connection->send_service_ = DONE_SENDING_SERVICES;
       this->send_gatt_services_done(connection->get_address());
@@ -121,81 +130,128 @@ void BluetoothProxy::loop() {
         connection->release_services();
       }
     } else if (connection->send_service_ >= 0) {
-      esp_gattc_service_elem_t service_result;
-      uint16_t service_count = 1;
-      esp_gatt_status_t service_status =
-          esp_ble_gattc_get_service(connection->get_gattc_if(), connection->get_conn_id(), nullptr, &service_result,
-                                    &service_count, connection->send_service_);
-      connection->send_service_++;
-      if (service_status != ESP_GATT_OK) {
-        ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_service error at offset=%d, status=%d",
-                 connection->get_connection_index(), connection->address_str().c_str(), connection->send_service_ - 1,
-                 service_status);
-        continue;
+      this->send_services_(connection);
+    }
+  }
+}
+
+void BluetoothProxy::send_services_(BluetoothConnection *connection) {
+  // As many services as fit a TCP segment go out in one response
+  api::BluetoothGATTGetServicesResponse resp;
+  resp.address = connection->get_address();
+  size_t size = 0;
+  int16_t next = connection->send_service_;
+  while (next < connection->service_count_) {
+    api::BluetoothGATTService service_resp;
+    size_t service_size;
+    if (!this->get_service_(connection, next, service_resp, service_size)) {
+      next++;
+      continue;
+    }
+    if (!resp.services.empty() && size + service_size > MAX_SERVICES_RESPONSE_SIZE)
+      break;
+    resp.services.push_back(std::move(service_resp));
+    size += service_size;
+    next++;
+  }
+  // Only move on once the services went out, otherwise try again on the next loop
+  if (resp.services.empty() || this->api_connection_->send_bluetooth_gatt_get_services_response(resp))
+    connection->send_service_ = next;
+}
+
+bool BluetoothProxy::get_service_(BluetoothConnection *connection, int16_t index,
+                                  api::BluetoothGATTService &service_resp, size_t &size) {
+  esp_gattc_service_elem_t service_result;
+  uint16_t service_count = 1;
+  esp_gatt_status_t service_status = esp_ble_gattc_get_service(
+      connection->get_gattc_if(), connection->get_conn_id(), nullptr, &service_result, &service_count, index);
+  if (service_status != ESP_GATT_OK) {
+    ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_service error at offset=%d, status=%d",
+             connection->get_connection_index(), connection->address_str().c_str(), index, service_status);
+    return false;
+  }
+  if (service_count == 0) {
+    ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_service missing, service_count=%d", connection->get_connection_index(),
+             connection->address_str().c_str(), service_count);
+    return false;
+  }
+  size = ENCODED_SERVICE_SIZE;
+  service_resp.uuid = get_128bit_uuid_vec(service_result.uuid);
+  service_resp.handle = service_result.start_handle;
+  uint16_t char_offset = 0;
+  esp_gattc_char_elem_t char_result;
+  while (true) {  // characteristics
+    uint16_t char_count = 1;
+    esp_gatt_status_t char_status = esp_ble_gattc_get_all_char(
+        connection->get_gattc_if(), connection->get_conn_id(), service_result.start_handle,
+        service_result.end_handle, &char_result, &char_count, char_offset);
+    if (char_status == ESP_GATT_INVALID_OFFSET || char_status == ESP_GATT_NOT_FOUND) {
+      break;
+    }
+    if (char_status != ESP_GATT_OK) {
+      ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_all_char error, status=%d", connection->get_connection_index(),
+               connection->address_str().c_str(), char_status);
+      break;
+    }
+    if (char_count == 0) {
+      break;
+    }
+    api::BluetoothGATTCharacteristic characteristic_resp;
+    characteristic_resp.uuid = get_128bit_uuid_vec(char_result.uuid);
+    characteristic_resp.handle = char_result.char_handle;
+    characteristic_resp.properties = char_result.properties;
+    char_offset++;
+    uint16_t desc_offset = 0;
+    esp_gattc_descr_elem_t desc_result;
+    while (true) {  // descriptors
+      uint16_t desc_count = 1;
+      esp_gatt_status_t desc_status =
+          esp_ble_gattc_get_all_descr(connection->get_gattc_if(), connection->get_conn_id(),
+                                      char_result.char_handle, &desc_result, &desc_count, desc_offset);
+      if (desc_status == ESP_GATT_INVALID_OFFSET || desc_status == ESP_GATT_NOT_FOUND) {
+        break;
       }
-      if (service_count == 0) {
-        ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_service missing, service_count=%d",
-                 connection->get_connection_index(), connection->address_str().c_str(), service_count);
-        continue;
+      if (desc_status != ESP_GATT_OK) {
+        ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_all_descr error, status=%d", connection->get_connection_index(),
+                 connection->address_str().c_str(), desc_status);
+        break;
       }
-      api::BluetoothGATTGetServicesResponse resp;
-      resp.address = connection->get_address();
-      api::BluetoothGATTService service_resp;
-      service_resp.uuid = get_128bit_uuid_vec(service_result.uuid);
-      service_resp.handle = service_result.start_handle;
-      uint16_t char_offset = 0;
-      esp_gattc_char_elem_t char_result;
-      while (true) {  // characteristics
-        uint16_t char_count = 1;
-        esp_gatt_status_t char_status = esp_ble_gattc_get_all_char(
-            connection->get_gattc_if(), connection->get_conn_id(), service_result.start_handle,
-            service_result.end_handle, &char_result, &char_count, char_offset);
-        if (char_status == ESP_GATT_INVALID_OFFSET || char_status == ESP_GATT_NOT_FOUND) {
-          break;
-        }
-        if (char_status != ESP_GATT_OK) {
-          ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_all_char error, status=%d", connection->get_connection_index(),
-                   connection->address_str().c_str(), char_status);
-          break;
-        }
-        if (char_count == 0) {
-          break;
-        }
-        api::BluetoothGATTCharacteristic characteristic_resp;
-        characteristic_resp.uuid = get_128bit_uuid_vec(char_result.uuid);
-        characteristic_resp.handle = char_result.char_handle;
-        characteristic_resp.properties = char_result.properties;
-        char_offset++;
-        uint16_t desc_offset = 0;
-        esp_gattc_descr_elem_t desc_result;
-        while (true) {  // descriptors
-          uint16_t desc_count = 1;
-          esp_gatt_status_t desc_status =
-              esp_ble_gattc_get_all_descr(connection->get_gattc_if(), connection->get_conn_id(),
-                                          char_result.char_handle, &desc_result, &desc_count, desc_offset);
-          if (desc_status == ESP_GATT_INVALID_OFFSET || desc_status == ESP_GATT_NOT_FOUND) {
-            break;
-          }
-          if (desc_status != ESP_GATT_OK) {
-            ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_all_descr error, status=%d", connection->get_connection_index(),
-                     connection->address_str().c_str(), desc_status);
-            break;
-          }
-          if (desc_count == 0) {
-            break;
-          }
-          api::BluetoothGATTDescriptor descriptor_resp;
-          descriptor_resp.uuid = get_128bit_uuid_vec(desc_result.uuid);
-          descriptor_resp.handle = desc_result.handle;
-          characteristic_resp.descriptors.push_back(std::move(descriptor_resp));
-          desc_offset++;
-        }
-        service_resp.characteristics.push_back(std::move(characteristic_resp));
+      if (desc_count == 0) {
+        break;
       }
-      resp.services.push_back(std::move(service_resp));
-      this->api_connection_->send_bluetooth_gatt_get_services_response(resp);
+      api::BluetoothGATTDescriptor descriptor_resp;
+      descriptor_resp.uuid = get_128bit_uuid_vec(desc_result.uuid);
+      descriptor_resp.handle = desc_result.handle;
+      characteristic_resp.descriptors.push_back(std::move(descriptor_resp));
+      size += ENCODED_DESCRIPTOR_SIZE;
+      desc_offset++;
+    }
+    service_resp.characteristics.push_back(std::move(characteristic_resp));
+    size += ENCODED_CHARACTERISTIC_SIZE;
+  }
+  return true;
+}
+
+void BluetoothProxy::send_notifications() {
+  bool corked = false;
+  for (auto *connection : this->connections_) {
+    if (connection->notifications_.empty())
+      continue;
+    if (this->api_connection_ == nullptr) {
+      connection->notifications_.clear();
+      continue;
+    }
+    // There is no message carrying several notifications, so they are written into the socket together instead
+    if (!corked) {
+      this->api_connection_->cork();
+      corked = true;
     }
+    for (auto &notification : connection->notifications_)
+      this->api_connection_->send_bluetooth_gatt_notify_data_response(notification);
+    connection->notifications_.clear();
   }
+  if (corked)
+    this->api_connection_->uncork();
 }
 
 esp32_ble_tracker::AdvertisementParserType BluetoothProxy::get_advertisement_parser_type() {
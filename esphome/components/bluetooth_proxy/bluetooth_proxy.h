@@ -80,6 +80,8 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   void send_device_pairing(uint64_t address, bool paired, esp_err_t error = ESP_OK);
   void send_device_unpairing(uint64_t address, bool success, esp_err_t error = ESP_OK);
   void send_device_clear_cache(uint64_t address, bool success, esp_err_t error = ESP_OK);
+  /// Send the notifications the connections received, in as few socket writes as possible
+  void send_notifications();
 
   static void uint64_to_bd_addr(uint64_t address, esp_bd_addr_t bd_addr) {
     bd_addr[0] = (address >> 40) & 0xff;
@@ -118,6 +120,9 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   void send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device);
 
   BluetoothConnection *get_connection_(uint64_t address, bool reserve);
+  void send_services_(BluetoothConnection *connection);
+  bool get_service_(BluetoothConnection *connection, int16_t index, api::BluetoothGATTService &service_resp,
+                    size_t &size);
 
   bool active_;
 
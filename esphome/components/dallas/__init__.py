@@ -1,6 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
+from esphome.components import warm_state
 from esphome.const import CONF_ID, CONF_PIN
 
 MULTI_CONF = True
@@ -23,3 +24,4 @@ async def to_code(config):
 
     pin = await cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
+    await warm_state.register_warm_state(var, config)
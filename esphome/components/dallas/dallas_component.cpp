@@ -1,6 +1,9 @@
 #include "dallas_component.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace dallas {
 
@@ -40,7 +43,13 @@ void DallasComponent::setup() {
   one_wire_ = new ESPOneWire(pin_);  // NOLINT(cppcoreguidelines-owning-memory)
 
   std::vector<uint64_t> raw_sensors;
-  raw_sensors = this->one_wire_->search_vec();
+  if (this->is_warm_start() && !this->found_sensors_.empty()) {
+    // The bus was scanned before the deep sleep or reboot, skip the search
+    ESP_LOGD(TAG, "Reusing %zu sensor addresses from warm state", this->found_sensors_.size());
+  } else {
+    this->found_sensors_.clear();
+    raw_sensors = this->one_wire_->search_vec();
+  }
 
   for (auto &address : raw_sensors) {
     auto *address8 = reinterpret_cast<uint8_t *>(&address);
@@ -71,6 +80,29 @@ void DallasComponent::setup() {
     }
   }
 }
+#ifdef USE_WARM_STATE
+size_t DallasComponent::max_warm_addresses_() const {
+  size_t count = this->sensors_.size();
+  for (auto *sensor : this->sensors_) {
+    if (sensor->get_index().has_value())
+      count = std::max<size_t>(count, *sensor->get_index() + 1);
+  }
+  return std::min<size_t>(count, 255);
+}
+void DallasComponent::save_warm_state(uint8_t *data) {
+  const size_t count = std::min(this->found_sensors_.size(), this->max_warm_addresses_());
+  data[0] = count;
+  memcpy(&data[1], this->found_sensors_.data(), count * sizeof(uint64_t));
+}
+bool DallasComponent::restore_warm_state(const uint8_t *data) {
+  if (data[0] == 0 || data[0] > this->max_warm_addresses_())
+    return false;
+  this->found_sensors_.resize(data[0]);
+  memcpy(this->found_sensors_.data(), &data[1], data[0] * sizeof(uint64_t));
+  return true;
+}
+#endif
+
 void DallasComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "DallasComponent:");
   LOG_PIN("  Pin: ", this->pin_);
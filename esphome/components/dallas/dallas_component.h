@@ -22,9 +22,20 @@ class DallasComponent : public PollingComponent {
 
   void update() override;
 
+#ifdef USE_WARM_STATE
+  size_t get_warm_state_size() const override { return 1 + 8 * this->max_warm_addresses_(); }
+  void save_warm_state(uint8_t *data) override;
+  bool restore_warm_state(const uint8_t *data) override;
+#endif
+
  protected:
   friend DallasTemperatureSensor;
 
+#ifdef USE_WARM_STATE
+  /// Number of bus addresses kept across warm restarts, enough for all configured sensors and indices.
+  size_t max_warm_addresses_() const;
+#endif
+
   InternalGPIOPin *pin_;
   ESPOneWire *one_wire_;
   std::vector<DallasTemperatureSensor *> sensors_;
@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -406,6 +407,12 @@ void DebugComponent::loop() {
 }
 
 void DebugComponent::update() {
+  size_t active_loops = App.get_active_looping_component_count();
+  if (active_loops != this->active_loops_) {
+    this->active_loops_ = active_loops;
+    ESP_LOGD(TAG, "Looping components: %zu of %zu active", active_loops, App.get_looping_component_count());
+  }
+
 #ifdef USE_SENSOR
   if (this->free_sensor_ != nullptr) {
     this->free_sensor_->publish_state(get_free_heap());
@@ -434,6 +441,12 @@ void DebugComponent::update() {
     this->max_loop_time_ = 0;
   }
 
+#ifdef USE_NETWORK_TASK
+  if (this->network_loop_time_sensor_ != nullptr) {
+    this->network_loop_time_sensor_->publish_state(App.take_network_max_loop_time());
+  }
+#endif
+
 #ifdef USE_ESP32
   if (this->psram_sensor_ != nullptr) {
     this->psram_sensor_->publish_state(heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
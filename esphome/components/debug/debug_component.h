@@ -33,12 +33,18 @@ class DebugComponent : public PollingComponent {
   void set_fragmentation_sensor(sensor::Sensor *fragmentation_sensor) { fragmentation_sensor_ = fragmentation_sensor; }
 #endif
   void set_loop_time_sensor(sensor::Sensor *loop_time_sensor) { loop_time_sensor_ = loop_time_sensor; }
+#ifdef USE_NETWORK_TASK
+  void set_network_loop_time_sensor(sensor::Sensor *network_loop_time_sensor) {
+    network_loop_time_sensor_ = network_loop_time_sensor;
+  }
+#endif
 #ifdef USE_ESP32
   void set_psram_sensor(sensor::Sensor *psram_sensor) { this->psram_sensor_ = psram_sensor; }
 #endif  // USE_ESP32
 #endif  // USE_SENSOR
  protected:
   uint32_t free_heap_{};
+  size_t active_loops_{SIZE_MAX};
 
 #ifdef USE_SENSOR
   uint32_t last_loop_timetag_{0};
@@ -50,6 +56,9 @@ class DebugComponent : public PollingComponent {
   sensor::Sensor *fragmentation_sensor_{nullptr};
 #endif
   sensor::Sensor *loop_time_sensor_{nullptr};
+#ifdef USE_NETWORK_TASK
+  sensor::Sensor *network_loop_time_sensor_{nullptr};
+#endif
 #ifdef USE_ESP32
   sensor::Sensor *psram_sensor_{nullptr};
 #endif  // USE_ESP32
@@ -13,11 +13,21 @@ from esphome.const import (
     ICON_COUNTER,
     ICON_TIMER,
 )
+from esphome.core import CORE
+from esphome.components.esp32.const import KEY_ESP32, KEY_NETWORK_TASK
 from . import CONF_DEBUG_ID, DebugComponent
 
 DEPENDENCIES = ["debug"]
 
 CONF_PSRAM = "psram"
+CONF_NETWORK_LOOP_TIME = "network_loop_time"
+
+
+def _require_network_task(value):
+    if not CORE.data.get(KEY_ESP32, {}).get(KEY_NETWORK_TASK, False):
+        raise cv.Invalid("The network task is not enabled in the esp32 configuration")
+    return value
+
 
 CONFIG_SCHEMA = {
     cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -49,6 +59,15 @@ CONFIG_SCHEMA = {
         accuracy_decimals=0,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
+    cv.Optional(CONF_NETWORK_LOOP_TIME): cv.All(
+        _require_network_task,
+        sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=0,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    ),
     cv.Optional(CONF_PSRAM): cv.All(
         cv.only_on_esp32,
         cv.requires_component("psram"),
@@ -81,6 +100,10 @@ async def to_code(config):
         sens = await sensor.new_sensor(loop_time_conf)
         cg.add(debug_component.set_loop_time_sensor(sens))
 
+    if network_loop_time_conf := config.get(CONF_NETWORK_LOOP_TIME):
+        sens = await sensor.new_sensor(network_loop_time_conf)
+        cg.add(debug_component.set_network_loop_time_sensor(sens))
+
     if psram_conf := config.get(CONF_PSRAM):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
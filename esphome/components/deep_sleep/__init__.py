@@ -1,8 +1,12 @@
 import esphome.codegen as cg
-from esphome.components import time
+from esphome.components import sensor, time
+from esphome.components.warm_state import CONF_WARM_STATE, rtc_words
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome import pins, automation
 from esphome.const import (
+    CONF_BUFFER_SIZE,
+    CONF_DELTA,
     CONF_HOUR,
     CONF_ID,
     CONF_MINUTE,
@@ -11,12 +15,16 @@ from esphome.const import (
     CONF_PINS,
     CONF_RUN_DURATION,
     CONF_SECOND,
+    CONF_SIZE,
+    CONF_SENSOR_ID,
+    CONF_SENSORS,
     CONF_SLEEP_DURATION,
     CONF_TIME_ID,
     CONF_WAKEUP_PIN,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
 )
+from esphome.core import CORE
 
 from esphome.components.esp32 import get_esp32_variant
 from esphome.components.esp32.const import (
@@ -114,6 +122,21 @@ def validate_pin_number(value):
     return value
 
 
+def validate_wake_cycle_buffer_size(value):
+    value = cv.int_range(min=1, max=255)(value)
+    # RTC user memory on the ESP8266 is only 512 bytes and shared with other preferences
+    if CORE.is_esp8266 and value > 16:
+        raise cv.Invalid("The ESP8266 can buffer at most 16 readings in RTC memory")
+    return value
+
+
+def wake_cycle_rtc_words(buffer_size):
+    """Words of RTC user memory the wake cycle state takes as an ESP8266 preference."""
+    # sizeof(WakeCycleState): 60 bytes of counters and last uploaded values and 12 per
+    # reading, plus the CRC word of the preference
+    return (60 + 12 * buffer_size + 3) // 4 + 1
+
+
 def validate_config(config):
     if get_esp32_variant() == VARIANT_ESP32C3 and CONF_ESP32_EXT1_WAKEUP in config:
         raise cv.Invalid("ESP32-C3 does not support wakeup from touch.")
@@ -158,6 +181,35 @@ CONF_DEFAULT = "default"
 CONF_GPIO_WAKEUP_REASON = "gpio_wakeup_reason"
 CONF_TOUCH_WAKEUP_REASON = "touch_wakeup_reason"
 CONF_UNTIL = "until"
+CONF_WAKE_CYCLE = "wake_cycle"
+CONF_NETWORK_INTERVAL = "network_interval"
+CONF_UPLOAD_TIMEOUT = "upload_timeout"
+CONF_ON_UPLOAD = "on_upload"
+
+# Must match WAKE_CYCLE_MAX_SENSORS in deep_sleep_component.h
+WAKE_CYCLE_MAX_SENSORS = 8
+
+WAKE_CYCLE_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_NETWORK_INTERVAL, default=1): cv.positive_not_null_int,
+        cv.Optional(CONF_BUFFER_SIZE, default=16): validate_wake_cycle_buffer_size,
+        cv.Optional(
+            CONF_UPLOAD_TIMEOUT, default="30s"
+        ): cv.positive_time_period_milliseconds,
+        cv.Required(CONF_SENSORS): cv.All(
+            cv.ensure_list(
+                cv.Schema(
+                    {
+                        cv.Required(CONF_SENSOR_ID): cv.use_id(sensor.Sensor),
+                        cv.Optional(CONF_DELTA): cv.positive_float,
+                    }
+                )
+            ),
+            cv.Length(min=1, max=WAKE_CYCLE_MAX_SENSORS),
+        ),
+        cv.Optional(CONF_ON_UPLOAD): automation.validate_automation(single=True),
+    }
+)
 
 WAKEUP_CAUSES_SCHEMA = cv.Schema(
     {
@@ -196,12 +248,38 @@ CONFIG_SCHEMA = cv.All(
                 ),
             ),
             cv.Optional(CONF_TOUCH_WAKEUP): cv.All(cv.only_on_esp32, cv.boolean),
+            cv.Optional(CONF_WAKE_CYCLE): cv.All(
+                cv.requires_component("wifi"), WAKE_CYCLE_SCHEMA
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266]),
 )
 
 
+def _final_validate(config):
+    if not CORE.is_esp8266 or CONF_WAKE_CYCLE not in config:
+        return config
+    # A preference that does not fit into the 96 words of RTC user memory only gets the
+    # 32 words of the eboot area, anything larger can not be created
+    buffer_size = config[CONF_WAKE_CYCLE][CONF_BUFFER_SIZE]
+    warm_state = fv.full_config.get().get(CONF_WARM_STATE)
+    if (
+        warm_state is not None
+        and wake_cycle_rtc_words(buffer_size) + rtc_words(warm_state[CONF_SIZE]) > 96
+    ):
+        raise cv.Invalid(
+            f"The wake cycle buffer of {buffer_size} readings and the warm_state of "
+            f"{warm_state[CONF_SIZE]} bytes do not fit into RTC memory together, "
+            "reduce the buffer_size or the warm_state size",
+            path=[CONF_WAKE_CYCLE, CONF_BUFFER_SIZE],
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
@@ -250,6 +328,28 @@ async def to_code(config):
     if CONF_TOUCH_WAKEUP in config:
         cg.add(var.set_touch_wakeup(config[CONF_TOUCH_WAKEUP]))
 
+    if CONF_WAKE_CYCLE in config:
+        conf = config[CONF_WAKE_CYCLE]
+        cg.add_define("USE_DEEP_SLEEP_WAKE_CYCLE")
+        cg.add_define("DEEP_SLEEP_WAKE_CYCLE_BUFFER_SIZE", conf[CONF_BUFFER_SIZE])
+        cg.add(var.set_network_interval(conf[CONF_NETWORK_INTERVAL]))
+        cg.add(var.set_upload_timeout(conf[CONF_UPLOAD_TIMEOUT]))
+        for sensor_conf in conf[CONF_SENSORS]:
+            sens = await cg.get_variable(sensor_conf[CONF_SENSOR_ID])
+            cg.add(
+                var.add_wake_cycle_sensor(
+                    sens, sensor_conf.get(CONF_DELTA, float("nan"))
+                )
+            )
+        if CONF_ON_UPLOAD in conf:
+            await automation.build_automation(
+                var.get_upload_trigger(),
+                [(sensor.SensorPtr, "sensor"), (float, "x"), (cg.uint32, "age")],
+                conf[CONF_ON_UPLOAD],
+            )
+        # Runs before App.setup(), WiFi has to know whether to start already
+        cg.add(var.begin_wake_cycle())
+
     cg.add_define("USE_DEEP_SLEEP")
 
 
@@ -1,5 +1,7 @@
 #include "deep_sleep_component.h"
 #include <cinttypes>
+#include <cmath>
+#include <cstring>
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
@@ -7,6 +9,20 @@
 #include <Esp.h>
 #endif
 
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+#include "esphome/components/network/util.h"
+#include "esphome/components/wifi/wifi_component.h"
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
+#ifdef USE_MQTT
+#include "esphome/components/mqtt/mqtt_client.h"
+#endif
+#ifdef USE_ESP32
+#include <esp_attr.h>
+#endif
+#endif
+
 namespace esphome {
 namespace deep_sleep {
 
@@ -14,6 +30,10 @@ static const char *const TAG = "deep_sleep";
 
 bool global_has_deep_sleep = false;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
+#if defined(USE_DEEP_SLEEP_WAKE_CYCLE) && defined(USE_ESP32)
+static RTC_DATA_ATTR WakeCycleState rtc_wake_cycle_state;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
 optional<uint32_t> DeepSleepComponent::get_run_duration_() const {
 #ifdef USE_ESP32
   if (this->wakeup_cause_to_run_duration_.has_value()) {
@@ -44,6 +64,9 @@ void DeepSleepComponent::setup() {
   } else {
     ESP_LOGD(TAG, "Not scheduling Deep Sleep, as no run duration is configured.");
   }
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+  this->phases_.setup_done = millis();
+#endif
 }
 void DeepSleepComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Setting up Deep Sleep...");
@@ -65,8 +88,26 @@ void DeepSleepComponent::dump_config() {
     ESP_LOGCONFIG(TAG, "  GPIO Wakeup Run Duration: %" PRIu32 " ms", this->wakeup_cause_to_run_duration_->gpio_cause);
   }
 #endif
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+  ESP_LOGCONFIG(TAG, "  Wake Cycle:");
+  ESP_LOGCONFIG(TAG, "    Network Interval: every %" PRIu32 " wakes", this->network_interval_);
+  ESP_LOGCONFIG(TAG, "    Upload Timeout: %" PRIu32 " ms", this->upload_timeout_);
+  ESP_LOGCONFIG(TAG, "    Buffer: %u/%u readings", this->state_.count, DEEP_SLEEP_WAKE_CYCLE_BUFFER_SIZE);
+  ESP_LOGCONFIG(TAG, "    Wake: %" PRIu32 " (%s)", this->state_.wake_count,
+                this->network_wake_ ? "network" : "sample-only");
+  ESP_LOGCONFIG(TAG, "    Network Wakes: %" PRIu32, this->state_.network_wakes);
+  ESP_LOGCONFIG(TAG, "    Total Awake Time: %" PRIu32 " ms sampling, %" PRIu32 " ms networking",
+                this->state_.sample_awake_ms, this->state_.network_awake_ms);
+#endif
 }
 void DeepSleepComponent::loop() {
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+  if (this->network_wake_ && this->phases_.network_connected == 0 && network::is_connected()) {
+    this->phases_.network_connected = millis();
+  }
+  if (this->upload_pending_() && this->upload_ready_())
+    this->upload_();
+#endif
   if (this->next_enter_deep_sleep_)
     this->begin_sleep();
 }
@@ -101,6 +142,19 @@ void DeepSleepComponent::begin_sleep(bool manual) {
     this->next_enter_deep_sleep_ = true;
     return;
   }
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+  if (!manual && this->network_wake_ && this->upload_pending_()) {
+    if (millis() - this->phases_.network_start < this->upload_timeout_) {
+      // Give the buffered readings a chance to go out before sleeping again
+      this->next_enter_deep_sleep_ = true;
+      return;
+    }
+    if (this->phases_.network_connected != 0) {
+      ESP_LOGW(TAG, "No API or MQTT client connected within the upload timeout, uploading without one");
+      this->upload_();
+    }
+  }
+#endif
 #ifdef USE_ESP32
   if (this->wakeup_pin_mode_ == WAKEUP_PIN_MODE_KEEP_AWAKE && this->wakeup_pin_ != nullptr &&
       !this->sleep_duration_.has_value() && this->wakeup_pin_->digital_read()) {
@@ -118,6 +172,9 @@ void DeepSleepComponent::begin_sleep(bool manual) {
   if (this->sleep_duration_.has_value()) {
     ESP_LOGI(TAG, "Sleeping for %" PRId64 "us", *this->sleep_duration_);
   }
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+  this->end_wake_cycle_();
+#endif
   App.run_safe_shutdown_hooks();
 
 #if defined(USE_ESP32)
@@ -163,5 +220,176 @@ float DeepSleepComponent::get_setup_priority() const { return setup_priority::LA
 void DeepSleepComponent::prevent_deep_sleep() { this->prevent_ = true; }
 void DeepSleepComponent::allow_deep_sleep() { this->prevent_ = false; }
 
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+void DeepSleepComponent::add_wake_cycle_sensor(sensor::Sensor *sensor, float delta) {
+  uint8_t index = this->wake_cycle_sensors_.size();
+  this->wake_cycle_sensors_.push_back(sensor);
+  this->wake_cycle_deltas_.push_back(delta);
+  sensor->add_on_state_callback([this, index](float state) { this->record_reading_(index, state); });
+}
+
+void DeepSleepComponent::begin_wake_cycle() {
+  const uint32_t magic = fnv1_hash(App.get_compilation_time());
+#ifdef USE_ESP32
+  this->state_ = rtc_wake_cycle_state;
+#endif
+#ifdef USE_ESP8266
+  this->rtc_ = global_preferences->make_preference<WakeCycleState>(magic, false);
+  if (!this->rtc_.is_valid())
+    ESP_LOGE(TAG, "RTC memory is full, wake cycle readings can not be kept across deep sleep");
+  if (!this->rtc_.load(&this->state_))
+    this->state_.magic = 0;
+#endif
+  if (this->state_.magic != magic || !this->woke_from_deep_sleep_()) {
+    // Cold boot or new firmware: start a fresh cycle
+    this->state_ = WakeCycleState{};
+    this->state_.magic = magic;
+    for (float &last : this->state_.last_uploaded)
+      last = NAN;
+  }
+
+  this->state_.wake_count++;
+  this->network_wake_ = this->state_.force_network || (this->state_.wake_count - 1) % this->network_interval_ == 0;
+  this->state_.force_network = false;
+  if (!this->network_wake_ && wifi::global_wifi_component != nullptr) {
+    // Keep the radio off, networking is only started again if a threshold is crossed
+    wifi::global_wifi_component->set_enable_on_boot(false);
+  }
+  this->save_wake_cycle_state_();
+}
+
+uint32_t DeepSleepComponent::get_network_time() const {
+  if (this->phases_.network_connected == 0)
+    return 0;
+  return this->phases_.network_connected - this->phases_.network_start;
+}
+
+uint32_t DeepSleepComponent::get_upload_time() const {
+  if (this->phases_.upload_done == 0)
+    return 0;
+  return this->phases_.upload_done - this->phases_.network_connected;
+}
+
+bool DeepSleepComponent::woke_from_deep_sleep_() const {
+#if defined(USE_ESP32)
+  return esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_UNDEFINED;
+#elif defined(USE_ESP8266)
+  return ESP.getResetInfoPtr()->reason == REASON_DEEP_SLEEP_AWAKE;  // NOLINT
+#else
+  return false;
+#endif
+}
+
+void DeepSleepComponent::save_wake_cycle_state_() {
+#ifdef USE_ESP32
+  rtc_wake_cycle_state = this->state_;
+#endif
+#ifdef USE_ESP8266
+  this->rtc_.save(&this->state_);
+#endif
+}
+
+void DeepSleepComponent::record_reading_(uint8_t index, float value) {
+  if (std::isnan(value))
+    return;
+  if (this->network_wake_) {
+    // Readings go out live, they only serve as reference for the thresholds
+    if (this->upload_ready_())
+      this->state_.last_uploaded[index] = value;
+    return;
+  }
+
+  WakeCycleState &state = this->state_;
+  if (state.count == DEEP_SLEEP_WAKE_CYCLE_BUFFER_SIZE) {
+    ESP_LOGW(TAG, "Wake cycle buffer full, dropping oldest reading");
+    memmove(&state.readings[0], &state.readings[1], sizeof(WakeCycleReading) * (state.count - 1));
+    state.count--;
+  }
+  WakeCycleReading &reading = state.readings[state.count++];
+  reading.timestamp = state.clock + millis() / 1000;
+  reading.value = value;
+  reading.sensor = index;
+  // Upload on the next wake at the latest, before readings start getting dropped
+  if (state.count == DEEP_SLEEP_WAKE_CYCLE_BUFFER_SIZE)
+    state.force_network = true;
+  this->save_wake_cycle_state_();
+
+  const float delta = this->wake_cycle_deltas_[index];
+  const float last = state.last_uploaded[index];
+  if (!std::isnan(delta) && (std::isnan(last) || std::fabs(value - last) >= delta)) {
+    ESP_LOGD(TAG, "'%s' crossed its wake cycle threshold, starting network",
+             this->wake_cycle_sensors_[index]->get_name().c_str());
+    this->start_network_();
+  }
+}
+
+void DeepSleepComponent::start_network_() {
+  if (this->network_wake_)
+    return;
+  this->network_wake_ = true;
+  this->phases_.network_start = millis();
+  if (wifi::global_wifi_component != nullptr)
+    wifi::global_wifi_component->enable();
+}
+
+bool DeepSleepComponent::upload_pending_() const { return this->state_.count != 0; }
+
+bool DeepSleepComponent::upload_ready_() const {
+  if (this->phases_.network_connected == 0)
+    return false;
+#if defined(USE_API) || defined(USE_MQTT)
+  // The readings reach the outside through the API or MQTT client, not through the network alone
+#ifdef USE_API
+  if (api::global_api_server != nullptr && api::global_api_server->is_connected())
+    return true;
+#endif
+#ifdef USE_MQTT
+  if (mqtt::global_mqtt_client != nullptr && mqtt::global_mqtt_client->is_connected())
+    return true;
+#endif
+  return false;
+#else
+  return true;
+#endif
+}
+
+void DeepSleepComponent::upload_() {
+  WakeCycleState &state = this->state_;
+  const uint32_t now = state.clock + millis() / 1000;
+  ESP_LOGD(TAG, "Uploading %u buffered readings", state.count);
+  for (uint8_t i = 0; i < state.count; i++) {
+    const WakeCycleReading &reading = state.readings[i];
+    this->upload_trigger_->trigger(this->wake_cycle_sensors_[reading.sensor], reading.value, now - reading.timestamp);
+    state.last_uploaded[reading.sensor] = reading.value;
+  }
+  for (uint8_t i = 0; i < this->wake_cycle_sensors_.size(); i++) {
+    if (this->wake_cycle_sensors_[i]->has_state())
+      state.last_uploaded[i] = this->wake_cycle_sensors_[i]->get_state();
+  }
+  state.count = 0;
+  this->phases_.upload_done = millis();
+  this->save_wake_cycle_state_();
+}
+
+void DeepSleepComponent::end_wake_cycle_() {
+  WakeCycleState &state = this->state_;
+  const uint32_t awake = millis();
+  if (this->network_wake_) {
+    state.network_wakes++;
+    state.network_awake_ms += awake;
+  } else {
+    state.sample_awake_ms += awake;
+  }
+  state.clock += (awake + 500) / 1000 + this->sleep_duration_.value_or(0) / 1000000;
+  ESP_LOGI(TAG, "Wake %" PRIu32 " (%s) took %" PRIu32 " ms: setup %" PRIu32 " ms, network %" PRIu32 " ms, "
+           "upload %" PRIu32 " ms",
+           state.wake_count, this->network_wake_ ? "network" : "sample-only", awake, this->get_setup_time(),
+           this->get_network_time(), this->get_upload_time());
+  ESP_LOGD(TAG, "Total awake time: %" PRIu32 " ms sampling, %" PRIu32 " ms in %" PRIu32 " network wakes",
+           state.sample_awake_ms, state.network_awake_ms, state.network_wakes);
+  this->save_wake_cycle_state_();
+}
+#endif
+
 }  // namespace deep_sleep
 }  // namespace esphome
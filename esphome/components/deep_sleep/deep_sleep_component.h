@@ -2,8 +2,10 @@
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
 
 #ifdef USE_ESP32
 #include <esp_sleep.h>
@@ -14,7 +16,12 @@
 #include "esphome/core/time.h"
 #endif
 
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+#include "esphome/components/sensor/sensor.h"
+#endif
+
 #include <cinttypes>
+#include <vector>
 
 namespace esphome {
 namespace deep_sleep {
@@ -50,6 +57,45 @@ struct WakeupCauseToRunDuration {
 
 #endif
 
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+
+static const uint8_t WAKE_CYCLE_MAX_SENSORS = 8;
+
+/// A single reading taken during a sample-only wake, waiting to be uploaded.
+struct WakeCycleReading {
+  uint32_t timestamp;  ///< Seconds on the wake-cycle clock when the reading was taken.
+  float value;
+  uint8_t sensor;  ///< Index into the configured wake cycle sensors.
+};
+
+/** Wake cycle bookkeeping that is retained across deep sleep.
+ *
+ * Lives in RTC slow memory on the ESP32 and in RTC user memory (non-flash preferences) on the ESP8266,
+ * so it survives deep sleep but not a power loss.
+ */
+struct WakeCycleState {
+  uint32_t magic;
+  uint32_t wake_count;
+  uint32_t clock;  ///< Seconds spent awake and asleep since the first wake, used to timestamp readings.
+  uint32_t network_wakes;
+  uint32_t sample_awake_ms;   ///< Total awake time of sample-only wakes.
+  uint32_t network_awake_ms;  ///< Total awake time of network wakes.
+  uint8_t force_network;
+  uint8_t count;
+  float last_uploaded[WAKE_CYCLE_MAX_SENSORS];
+  WakeCycleReading readings[DEEP_SLEEP_WAKE_CYCLE_BUFFER_SIZE];
+};
+
+/// Time spent in each phase of the current wake, in milliseconds since boot.
+struct WakeCyclePhases {
+  uint32_t setup_done{0};
+  uint32_t network_start{0};
+  uint32_t network_connected{0};
+  uint32_t upload_done{0};
+};
+
+#endif
+
 template<typename... Ts> class EnterDeepSleepAction;
 
 template<typename... Ts> class PreventDeepSleepAction;
@@ -101,6 +147,41 @@ class DeepSleepComponent : public Component {
   void prevent_deep_sleep();
   void allow_deep_sleep();
 
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+  /// Bring networking up on every nth wake only, buffering readings of the wake cycle sensors in between.
+  void set_network_interval(uint32_t network_interval) { this->network_interval_ = network_interval; }
+  void set_upload_timeout(uint32_t upload_timeout) { this->upload_timeout_ = upload_timeout; }
+  /** Add a sensor whose readings are buffered during sample-only wakes.
+   *
+   * @param sensor The sensor to sample.
+   * @param delta Bring networking up as soon as the reading differs from the last uploaded value by at least this
+   * much. NAN disables the threshold.
+   */
+  void add_wake_cycle_sensor(sensor::Sensor *sensor, float delta);
+
+  /** Load the retained wake cycle state and decide whether this wake brings networking up.
+   *
+   * Called from the generated main before App.setup(), so that WiFi can be kept off during sample-only wakes.
+   */
+  void begin_wake_cycle();
+
+  /// Whether networking is up during this wake.
+  bool is_network_wake() const { return this->network_wake_; }
+  uint32_t get_wake_count() const { return this->state_.wake_count; }
+  uint8_t get_buffered_count() const { return this->state_.count; }
+  /// Time from boot until all components were set up, in ms.
+  uint32_t get_setup_time() const { return this->phases_.setup_done; }
+  /// Time from enabling networking until the network was connected, in ms. 0 if not connected (yet).
+  uint32_t get_network_time() const;
+  /// Time from the network connecting until the buffered readings were uploaded, in ms.
+  uint32_t get_upload_time() const;
+
+  /** Trigger called for every buffered reading once an API or MQTT client (or without either, the network) is
+   * connected, or the upload timeout expired with the network up. Age is in seconds.
+   */
+  Trigger<sensor::Sensor *, float, uint32_t> *get_upload_trigger() const { return this->upload_trigger_; }
+#endif
+
  protected:
   // Returns nullopt if no run duration is set. Otherwise, returns the run
   // duration before entering deep sleep.
@@ -117,6 +198,30 @@ class DeepSleepComponent : public Component {
   optional<uint32_t> run_duration_;
   bool next_enter_deep_sleep_{false};
   bool prevent_{false};
+
+#ifdef USE_DEEP_SLEEP_WAKE_CYCLE
+  bool woke_from_deep_sleep_() const;
+  void save_wake_cycle_state_();
+  void record_reading_(uint8_t index, float value);
+  void start_network_();
+  bool upload_pending_() const;
+  /// Whether the network and, when built in, an API or MQTT client are connected.
+  bool upload_ready_() const;
+  void upload_();
+  void end_wake_cycle_();
+
+  uint32_t network_interval_{1};
+  uint32_t upload_timeout_{30000};
+  std::vector<sensor::Sensor *> wake_cycle_sensors_;
+  std::vector<float> wake_cycle_deltas_;
+  WakeCycleState state_{};
+  WakeCyclePhases phases_{};
+  bool network_wake_{true};
+#ifdef USE_ESP8266
+  ESPPreferenceObject rtc_;
+#endif
+  Trigger<sensor::Sensor *, float, uint32_t> *upload_trigger_ = new Trigger<sensor::Sensor *, float, uint32_t>();
+#endif
 };
 
 extern bool global_has_deep_sleep;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -1,7 +1,10 @@
+import logging
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import core, automation
 from esphome.automation import maybe_simple_id
+from esphome.components import binary_sensor, sensor, text_sensor, time
 from esphome.const import (
     CONF_AUTO_CLEAR_ENABLED,
     CONF_ID,
@@ -11,10 +14,13 @@ from esphome.const import (
     CONF_ROTATION,
     CONF_FROM,
     CONF_TO,
+    CONF_TIME_ID,
     CONF_TRIGGER_ID,
 )
 from esphome.core import coroutine_with_priority
 
+_LOGGER = logging.getLogger(__name__)
+
 IS_PLATFORM_COMPONENT = True
 
 display_ns = cg.esphome_ns.namespace("display")
@@ -38,6 +44,26 @@ DisplayOnPageChangeTrigger = display_ns.class_(
 )
 
 CONF_ON_PAGE_CHANGE = "on_page_change"
+CONF_RENDER_ON_CHANGE = "render_on_change"
+CONF_DEPENDS_ON = "depends_on"
+CONF_TIME_GRANULARITY = "time_granularity"
+
+# Entity types a page can track, the ones used in its lambda are tracked automatically
+PAGE_DEPENDENCY_TYPES = [
+    sensor.Sensor,
+    binary_sensor.BinarySensor,
+    text_sensor.TextSensor,
+]
+# Types that change while a page is shown without the page noticing, warned about when
+# a page using render_on_change references them. Matched exactly, not by inheritance, as
+# e.g. Animation derives from the static Image.
+UNTRACKED_PAGE_DEPENDENCY_TYPES = [
+    cg.esphome_ns.namespace("graph").class_("Graph"),
+    cg.esphome_ns.namespace("animation").class_("Animation"),
+    cg.esphome_ns.namespace("globals").class_("GlobalsComponent"),
+    cg.esphome_ns.namespace("globals").class_("RestoringGlobalsComponent"),
+    cg.esphome_ns.namespace("globals").class_("RestoringGlobalStringComponent"),
+]
 
 DISPLAY_ROTATIONS = {
     0: display_ns.DISPLAY_ROTATION_0_DEGREES,
@@ -68,6 +94,14 @@ FULL_DISPLAY_SCHEMA = BASIC_DISPLAY_SCHEMA.extend(
                 {
                     cv.GenerateID(): cv.declare_id(DisplayPage),
                     cv.Required(CONF_LAMBDA): cv.lambda_,
+                    cv.Optional(CONF_RENDER_ON_CHANGE, default=False): cv.boolean,
+                    cv.Optional(CONF_DEPENDS_ON): cv.ensure_list(
+                        cv.use_id(cg.EntityBase)
+                    ),
+                    cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+                    cv.Optional(
+                        CONF_TIME_GRANULARITY, default="1s"
+                    ): cv.positive_time_period_seconds,
                 }
             ),
             cv.Length(min=1),
@@ -101,6 +135,8 @@ async def setup_display_core_(var, config):
             )
             page = cg.new_Pvariable(conf[CONF_ID], lambda_)
             pages.append(page)
+            if conf[CONF_RENDER_ON_CHANGE]:
+                await setup_page_dependencies_(page, conf)
         cg.add(var.set_pages(pages))
     for conf in config.get(CONF_ON_PAGE_CHANGE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
@@ -115,6 +151,43 @@ async def setup_display_core_(var, config):
         )
 
 
+async def setup_page_dependencies_(page, conf):
+    cg.add(page.set_render_on_change(True))
+    time_ = None
+    if CONF_TIME_ID in conf:
+        time_ = await cg.get_variable(conf[CONF_TIME_ID])
+    depends_on = conf.get(CONF_DEPENDS_ON, [])
+    dependencies = []
+    untracked = []
+    for id_ in depends_on + conf[CONF_LAMBDA].requires_ids:
+        full_id, dep = await cg.get_variable_with_full_id(id_)
+        if full_id.type.inherits_from(time.RealTimeClock):
+            if time_ is None:
+                time_ = dep
+        elif any(full_id.type.inherits_from(t) for t in PAGE_DEPENDENCY_TYPES):
+            if full_id.id not in dependencies:
+                dependencies.append(full_id.id)
+                cg.add(page.add_dependency(dep))
+        elif full_id.id in untracked:
+            continue
+        elif id_ in depends_on or _is_untracked_page_dependency(full_id.type):
+            untracked.append(full_id.id)
+            _LOGGER.warning(
+                "Page %s can't track changes of '%s', call invalidate() on the page "
+                "when it changes",
+                conf[CONF_ID],
+                full_id.id,
+            )
+    if time_ is not None:
+        cg.add(page.set_time(time_, conf[CONF_TIME_GRANULARITY]))
+
+
+def _is_untracked_page_dependency(type_):
+    # Templated types like GlobalsComponent<int> are matched by their template
+    base = str(type_).split("<", 1)[0]
+    return any(base == str(t) for t in UNTRACKED_PAGE_DEPENDENCY_TYPES)
+
+
 async def register_display(var, config):
     await cg.register_component(var, config)
     await setup_display_core_(var, config)
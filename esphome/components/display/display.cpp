@@ -1,7 +1,10 @@
 #include "display.h"
 
+#include <cinttypes>
+#include <cmath>
 #include <utility>
 
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -14,7 +17,11 @@ const Color COLOR_ON(255, 255, 255, 255);
 
 void Display::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
 void Display::clear() { this->fill(COLOR_OFF); }
-void Display::set_rotation(DisplayRotation rotation) { this->rotation_ = rotation; }
+void Display::set_rotation(DisplayRotation rotation) {
+  this->rotation_ = rotation;
+  // the buffer has to be drawn again in the new orientation
+  this->rendered_page_ = nullptr;
+}
 void HOT Display::line(int x1, int y1, int x2, int y2, Color color) {
   const int32_t dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
   const int32_t dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
@@ -302,16 +309,22 @@ void Display::show_page(DisplayPage *page) {
 }
 void Display::show_next_page() { this->page_->show_next(); }
 void Display::show_prev_page() { this->page_->show_prev(); }
-void Display::do_update_() {
+bool Display::do_update_() {
+  if (this->page_ != nullptr && !this->page_->needs_render(this->page_ != this->rendered_page_)) {
+    this->page_->skip_render();
+    return false;
+  }
   if (this->auto_clear_enabled_) {
     this->clear();
   }
   if (this->page_ != nullptr) {
-    this->page_->get_writer()(*this);
+    this->page_->render(*this);
   } else if (this->writer_.has_value()) {
     (*this->writer_)(*this);
   }
+  this->rendered_page_ = this->page_;
   this->clear_clipping_();
+  return true;
 }
 void DisplayOnPageChangeTrigger::process(DisplayPage *from, DisplayPage *to) {
   if ((this->from_ == nullptr || this->from_ == from) && (this->to_ == nullptr || this->to_ == to))
@@ -415,6 +428,63 @@ void DisplayPage::set_parent(Display *parent) { this->parent_ = parent; }
 void DisplayPage::set_prev(DisplayPage *prev) { this->prev_ = prev; }
 void DisplayPage::set_next(DisplayPage *next) { this->next_ = next; }
 const display_writer_t &DisplayPage::get_writer() const { return this->writer_; }
+#ifdef USE_SENSOR
+void DisplayPage::add_dependency(sensor::Sensor *sensor) {
+  float last = NAN;
+  sensor->add_on_state_callback([this, last](float state) mutable {
+    if (state == last || (std::isnan(state) && std::isnan(last)))
+      return;
+    last = state;
+    this->invalidate();
+  });
+}
+#endif
+#ifdef USE_BINARY_SENSOR
+void DisplayPage::add_dependency(binary_sensor::BinarySensor *binary_sensor) {
+  binary_sensor->add_on_state_callback([this](bool state) { this->invalidate(); });
+}
+#endif
+#ifdef USE_TEXT_SENSOR
+void DisplayPage::add_dependency(text_sensor::TextSensor *text_sensor) {
+  std::string last;
+  text_sensor->add_on_state_callback([this, last](const std::string &state) mutable {
+    if (state == last)
+      return;
+    last = state;
+    this->invalidate();
+  });
+}
+#endif
+#ifdef USE_TIME
+void DisplayPage::set_time(time::RealTimeClock *time, uint32_t granularity) {
+  this->time_ = time;
+  this->time_granularity_ = std::max<uint32_t>(granularity, 1);
+}
+#endif
+bool DisplayPage::needs_render(bool page_changed) {
+  if (!this->render_on_change_ || page_changed || this->dirty_)
+    return true;
+#ifdef USE_TIME
+  if (this->time_ != nullptr && this->time_->timestamp_now() / this->time_granularity_ != this->time_bucket_)
+    return true;
+#endif
+  return false;
+}
+void DisplayPage::render(Display &display) {
+  // cleared before the writer runs, so a change it causes itself renders the page again on the next update
+  this->dirty_ = false;
+#ifdef USE_TIME
+  if (this->time_ != nullptr)
+    this->time_bucket_ = this->time_->timestamp_now() / this->time_granularity_;
+#endif
+  const uint32_t start = micros();
+  this->writer_(display);
+  this->last_render_time_ = micros() - start;
+  this->total_render_time_ += this->last_render_time_;
+  this->render_count_++;
+  ESP_LOGV(TAG, "Rendered page %p in %" PRIu32 " us (%" PRIu32 " renders, %" PRIu32 " skipped)", this,
+           this->last_render_time_, this->render_count_, this->skip_count_);
+}
 
 }  // namespace display
 }  // namespace esphome
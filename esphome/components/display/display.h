@@ -22,6 +22,22 @@
 #include "esphome/components/graphical_display_menu/graphical_display_menu.h"
 #endif
 
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
+
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
+
 namespace esphome {
 namespace display {
 
@@ -529,13 +545,20 @@ class Display : public PollingComponent {
   bool clamp_y_(int y, int h, int &min_y, int &max_y);
   void vprintf_(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, va_list arg);
 
-  void do_update_();
+  /** Clear the buffer and run the writer of the active page.
+   *
+   * @return false if the active page renders on change and nothing it depends on changed, the buffer then still
+   * holds the previous frame and does not need to be transferred to the display.
+   */
+  bool do_update_();
   void clear_clipping_();
 
   DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
   optional<display_writer_t> writer_{};
   DisplayPage *page_{nullptr};
   DisplayPage *previous_page_{nullptr};
+  /// The page the buffer was last rendered with, a page that renders on change is always rendered after a switch.
+  DisplayPage *rendered_page_{nullptr};
   std::vector<DisplayOnPageChangeTrigger *> on_page_change_triggers_;
   bool auto_clear_enabled_{true};
   std::vector<Rect> clipping_rectangle_;
@@ -552,11 +575,62 @@ class DisplayPage {
   void set_next(DisplayPage *next);
   const display_writer_t &get_writer() const;
 
+  /** Only run the writer when something the page depends on changed since it was last rendered.
+   *
+   * The display keeps showing the previous frame otherwise, so the clear, the writer and the transfer are skipped.
+   */
+  void set_render_on_change(bool render_on_change) { this->render_on_change_ = render_on_change; }
+  bool get_render_on_change() const { return this->render_on_change_; }
+  /// Render the page on the next update, for state the page does not track by itself (globals, lambdas, ...).
+  void invalidate() { this->dirty_ = true; }
+
+#ifdef USE_SENSOR
+  void add_dependency(sensor::Sensor *sensor);
+#endif
+#ifdef USE_BINARY_SENSOR
+  void add_dependency(binary_sensor::BinarySensor *binary_sensor);
+#endif
+#ifdef USE_TEXT_SENSOR
+  void add_dependency(text_sensor::TextSensor *text_sensor);
+#endif
+#ifdef USE_TIME
+  /// Render the page each time the time crosses a multiple of granularity seconds.
+  void set_time(time::RealTimeClock *time, uint32_t granularity);
+#endif
+
+  /// Internal method called by the display to decide whether the page has to be rendered.
+  bool needs_render(bool page_changed);
+  /// Internal method called by the display to run the writer and record its statistics.
+  void render(Display &display);
+  /// Internal method called by the display when the render was skipped.
+  void skip_render() { this->skip_count_++; }
+
+  /// Number of times the writer ran.
+  uint32_t get_render_count() const { return this->render_count_; }
+  /// Number of updates which kept the previous frame because nothing changed.
+  uint32_t get_skip_count() const { return this->skip_count_; }
+  /// Duration of the last run of the writer in microseconds.
+  uint32_t get_last_render_time() const { return this->last_render_time_; }
+  /// Sum of the durations of all runs of the writer in microseconds.
+  uint64_t get_total_render_time() const { return this->total_render_time_; }
+
  protected:
   Display *parent_;
   display_writer_t writer_;
   DisplayPage *prev_{nullptr};
   DisplayPage *next_{nullptr};
+
+  bool render_on_change_{false};
+  bool dirty_{true};
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+  uint32_t time_granularity_{1};
+  time_t time_bucket_{0};
+#endif
+  uint32_t render_count_{0};
+  uint32_t skip_count_{0};
+  uint32_t last_render_time_{0};
+  uint64_t total_render_time_{0};
 };
 
 template<typename... Ts> class DisplayPageShowAction : public Action<Ts...> {
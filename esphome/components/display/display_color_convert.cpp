@@ -0,0 +1,65 @@
+#include "display_color_convert.h"
+#include "display_color_utils.h"
+
+#include <cstdlib>
+
+#include "esphome/core/helpers.h"
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+
+namespace esphome {
+namespace display {
+
+void PixelConverter::set_rgb332() {
+  for (size_t i = 0; i != 256; i++) {
+    uint16_t color = ColorUtil::color_to_565(ColorUtil::rgb332_to_color(i));
+    this->table_[i][0] = color >> 8;
+    this->table_[i][1] = color;
+  }
+}
+
+void PixelConverter::set_palette888(const uint8_t *palette) {
+  for (size_t i = 0; i != 256; i++) {
+    uint16_t color = ColorUtil::color_to_565(ColorUtil::index8_to_color_palette888(i, palette));
+    this->table_[i][0] = color >> 8;
+    this->table_[i][1] = color;
+  }
+}
+
+void HOT PixelConverter::convert_to_565(const uint8_t *src, uint8_t *dst, size_t count) const {
+  for (const uint8_t *end = src + count; src != end; src++) {
+    const uint8_t *entry = this->table_[*src];
+    *dst++ = entry[0];
+    *dst++ = entry[1];
+  }
+}
+
+void HOT PixelConverter::convert_to_666(const uint8_t *src, uint8_t *dst, size_t count) const {
+  for (const uint8_t *end = src + count; src != end; src++) {
+    const uint8_t *entry = this->table_[*src];
+    *dst++ = entry[0] & 0xF8;
+    *dst++ = ((entry[0] << 5) | (entry[1] >> 3)) & 0xFC;
+    *dst++ = entry[1] << 3;
+  }
+}
+
+void HOT PixelConverter::convert_565_to_666(const uint8_t *src, uint8_t *dst, size_t count) {
+  for (const uint8_t *end = src + count * 2; src != end; src += 2) {
+    *dst++ = src[0] & 0xF8;
+    *dst++ = ((src[0] << 5) | (src[1] >> 3)) & 0xFC;
+    *dst++ = src[1] << 3;
+  }
+}
+
+uint8_t *allocate_transfer_buffer(size_t size) {
+#ifdef USE_ESP32
+  return static_cast<uint8_t *>(heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT));
+#else
+  return static_cast<uint8_t *>(malloc(size));  // NOLINT(cppcoreguidelines-owning-memory,cppcoreguidelines-no-malloc)
+#endif
+}
+
+}  // namespace display
+}  // namespace esphome
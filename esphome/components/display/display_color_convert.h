@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace display {
+
+/** Converts rows of a display buffer to the pixel format a panel expects on the wire.
+ *
+ * 8 bit buffers (RGB332 or palette indexes) go through a 256 entry table holding the big endian RGB565 bytes of
+ * each value, so converting a pixel is a table lookup instead of going through Color. The results are identical to
+ * `ColorUtil::color_to_565(ColorUtil::rgb332_to_color(...))` and `index8_to_color_palette888(...)`.
+ */
+class PixelConverter {
+ public:
+  /// Build the table for buffers holding RGB332 pixels.
+  void set_rgb332();
+  /// Build the table for buffers holding indexes into a 256 color RGB888 palette.
+  void set_palette888(const uint8_t *palette);
+
+  /// Convert count 8 bit pixels to big endian RGB565, 2 bytes per pixel.
+  void convert_to_565(const uint8_t *src, uint8_t *dst, size_t count) const;
+  /// Convert count 8 bit pixels to RGB666, 3 bytes per pixel with the color in the upper bits of each byte.
+  void convert_to_666(const uint8_t *src, uint8_t *dst, size_t count) const;
+  /// Convert count big endian RGB565 pixels to RGB666, 3 bytes per pixel.
+  static void convert_565_to_666(const uint8_t *src, uint8_t *dst, size_t count);
+
+ protected:
+  /// Big endian RGB565 of each 8 bit buffer value.
+  uint8_t table_[256][2]{};
+};
+
+/** Allocate a buffer the SPI driver can send without copying it first.
+ *
+ * On the ESP32 this is DMA capable internal memory, the display buffer itself may live in PSRAM. Returns nullptr
+ * when there is not enough memory, release the buffer with free().
+ */
+uint8_t *allocate_transfer_buffer(size_t size);
+
+}  // namespace display
+}  // namespace esphome
@@ -35,18 +35,26 @@ void MenuItem::on_leave() { this->on_leave_callbacks_.call(); }
 void MenuItem::on_value_() { this->on_value_callbacks_.call(); }
 
 #ifdef USE_SELECT
-std::string MenuItemSelect::get_value_text() const {
-  std::string result;
+void MenuItemSelect::set_select_variable(select::Select *var) {
+  this->select_var_ = var;
+  this->value_text_valid_ = false;
+  var->add_on_state_callback([this](const std::string &value, size_t index) { this->value_text_valid_ = false; });
+}
 
+std::string MenuItemSelect::get_value_text() const {
   if (this->value_getter_.has_value()) {
-    result = this->value_getter_.value()(this);
-  } else {
+    return this->value_getter_.value()(this);
+  }
+
+  if (!this->value_text_valid_) {
+    this->value_text_.clear();
     if (this->select_var_ != nullptr) {
-      result = this->select_var_->state;
+      this->value_text_ = this->select_var_->state;
     }
+    this->value_text_valid_ = true;
   }
 
-  return result;
+  return this->value_text_;
 }
 
 bool MenuItemSelect::select_next() {
@@ -73,18 +81,25 @@ bool MenuItemSelect::select_prev() {
 #endif  // USE_SELECT
 
 #ifdef USE_NUMBER
-std::string MenuItemNumber::get_value_text() const {
-  std::string result;
+void MenuItemNumber::set_number_variable(number::Number *var) {
+  this->number_var_ = var;
+  this->value_text_valid_ = false;
+  var->add_on_state_callback([this](float value) { this->value_text_valid_ = false; });
+}
 
+std::string MenuItemNumber::get_value_text() const {
   if (this->value_getter_.has_value()) {
-    result = this->value_getter_.value()(this);
-  } else {
+    return this->value_getter_.value()(this);
+  }
+
+  if (!this->value_text_valid_) {
     char data[32];
     snprintf(data, sizeof(data), this->format_.c_str(), get_number_value_());
-    result = data;
+    this->value_text_ = data;
+    this->value_text_valid_ = true;
   }
 
-  return result;
+  return this->value_text_;
 }
 
 bool MenuItemNumber::select_next() {
@@ -137,16 +152,23 @@ float MenuItemNumber::get_number_value_() const {
 #endif  // USE_NUMBER
 
 #ifdef USE_SWITCH
-std::string MenuItemSwitch::get_value_text() const {
-  std::string result;
+void MenuItemSwitch::set_switch_variable(switch_::Switch *var) {
+  this->switch_var_ = var;
+  this->value_text_valid_ = false;
+  var->add_on_state_callback([this](bool state) { this->value_text_valid_ = false; });
+}
 
+std::string MenuItemSwitch::get_value_text() const {
   if (this->value_getter_.has_value()) {
-    result = this->value_getter_.value()(this);
-  } else {
-    result = this->get_switch_state_() ? this->switch_on_text_ : this->switch_off_text_;
+    return this->value_getter_.value()(this);
   }
 
-  return result;
+  if (!this->value_text_valid_) {
+    this->value_text_ = this->get_switch_state_() ? this->switch_on_text_ : this->switch_off_text_;
+    this->value_text_valid_ = true;
+  }
+
+  return this->value_text_;
 }
 
 bool MenuItemSwitch::select_next() { return this->toggle_switch_(); }
@@ -95,13 +95,16 @@ class MenuItemEditable : public MenuItem {
  protected:
   bool immediate_edit_{false};
   optional<value_getter_t> value_getter_{};
+  /// Value text built from the state of the entity, only rebuilt after the state changed.
+  mutable std::string value_text_;
+  mutable bool value_text_valid_{false};
 };
 
 #ifdef USE_SELECT
 class MenuItemSelect : public MenuItemEditable {
  public:
   explicit MenuItemSelect() : MenuItemEditable(MENU_ITEM_SELECT) {}
-  void set_select_variable(select::Select *var) { this->select_var_ = var; }
+  void set_select_variable(select::Select *var);
 
   bool has_value() const override { return true; }
   std::string get_value_text() const override;
@@ -118,8 +121,11 @@ class MenuItemSelect : public MenuItemEditable {
 class MenuItemNumber : public MenuItemEditable {
  public:
   explicit MenuItemNumber() : MenuItemEditable(MENU_ITEM_NUMBER) {}
-  void set_number_variable(number::Number *var) { this->number_var_ = var; }
-  void set_format(const std::string &fmt) { this->format_ = fmt; }
+  void set_number_variable(number::Number *var);
+  void set_format(const std::string &fmt) {
+    this->format_ = fmt;
+    this->value_text_valid_ = false;
+  }
 
   bool has_value() const override { return true; }
   std::string get_value_text() const override;
@@ -139,9 +145,15 @@ class MenuItemNumber : public MenuItemEditable {
 class MenuItemSwitch : public MenuItemEditable {
  public:
   explicit MenuItemSwitch() : MenuItemEditable(MENU_ITEM_SWITCH) {}
-  void set_switch_variable(switch_::Switch *var) { this->switch_var_ = var; }
-  void set_on_text(const std::string &t) { this->switch_on_text_ = t; }
-  void set_off_text(const std::string &t) { this->switch_off_text_ = t; }
+  void set_switch_variable(switch_::Switch *var);
+  void set_on_text(const std::string &t) {
+    this->switch_on_text_ = t;
+    this->value_text_valid_ = false;
+  }
+  void set_off_text(const std::string &t) {
+    this->switch_off_text_ = t;
+    this->value_text_valid_ = false;
+  }
 
   bool has_value() const override { return true; }
   std::string get_value_text() const override;
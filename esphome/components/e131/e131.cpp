@@ -57,6 +57,12 @@ void E131Component::loop() {
   int universe = 0;
   uint8_t buf[1460];
 
+  // Nobody to hand packets to until an effect is started
+  if (this->light_effects_.empty()) {
+    this->disable_loop();
+    return;
+  }
+
   ssize_t len = this->socket_->read(buf, sizeof(buf));
   if (len == -1) {
     return;
@@ -83,6 +89,7 @@ void E131Component::add_effect(E131AddressableLightEffect *light_effect) {
            light_effect->get_first_universe(), light_effect->get_last_universe());
 
   light_effects_.insert(light_effect);
+  this->enable_loop();
 
   for (auto universe = light_effect->get_first_universe(); universe <= light_effect->get_last_universe(); ++universe) {
     join_(universe);
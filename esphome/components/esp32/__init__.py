@@ -43,6 +43,7 @@ from .const import (  # noqa
     KEY_COMPONENTS,
     KEY_ESP32,
     KEY_EXTRA_BUILD_FILES,
+    KEY_NETWORK_TASK,
     KEY_PATH,
     KEY_REF,
     KEY_REFRESH,
@@ -50,6 +51,8 @@ from .const import (  # noqa
     KEY_SDKCONFIG_OPTIONS,
     KEY_SUBMODULES,
     KEY_VARIANT,
+    VARIANT_ESP32,
+    VARIANT_ESP32S3,
     VARIANT_FRIENDLY,
     VARIANTS,
 )
@@ -80,6 +83,7 @@ def set_core_data(config):
     CORE.data[KEY_ESP32][KEY_BOARD] = config[CONF_BOARD]
     CORE.data[KEY_ESP32][KEY_VARIANT] = config[CONF_VARIANT]
     CORE.data[KEY_ESP32][KEY_EXTRA_BUILD_FILES] = {}
+    CORE.data[KEY_ESP32][KEY_NETWORK_TASK] = config[CONF_NETWORK_TASK]
 
     return config
 
@@ -331,6 +335,14 @@ def _detect_variant(value):
 
 
 def final_validate(config):
+    if config[CONF_NETWORK_TASK]:
+        for component in NETWORK_TASK_INCOMPATIBLE:
+            if component in fv.full_config.get():
+                raise cv.Invalid(
+                    f"The network task cannot be used together with {component} yet",
+                    path=[CONF_NETWORK_TASK],
+                )
+
     if CONF_PLATFORMIO_OPTIONS not in fv.full_config.get()[CONF_ESPHOME]:
         return config
 
@@ -425,6 +437,24 @@ FLASH_SIZES = [
 
 CONF_FLASH_SIZE = "flash_size"
 CONF_PARTITIONS = "partitions"
+CONF_NETWORK_TASK = "network_task"
+
+# Components talking to API clients from the main loop, which would race with the network task
+NETWORK_TASK_INCOMPATIBLE = ["bluetooth_proxy", "esp32_camera", "voice_assistant"]
+
+
+def _validate_network_task(config):
+    if config[CONF_NETWORK_TASK] and config[CONF_VARIANT] not in (
+        VARIANT_ESP32,
+        VARIANT_ESP32S3,
+    ):
+        raise cv.Invalid(
+            f"The network task needs a dual-core ESP32, {config[CONF_VARIANT]} has a single core",
+            path=[CONF_NETWORK_TASK],
+        )
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -435,9 +465,11 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_PARTITIONS): cv.file_,
             cv.Optional(CONF_VARIANT): cv.one_of(*VARIANTS, upper=True),
             cv.Optional(CONF_FRAMEWORK, default={}): FRAMEWORK_SCHEMA,
+            cv.Optional(CONF_NETWORK_TASK, default=False): cv.boolean,
         }
     ),
     _detect_variant,
+    _validate_network_task,
     set_core_data,
 )
 
@@ -452,6 +484,8 @@ async def to_code(config):
     cg.add_define("ESPHOME_BOARD", config[CONF_BOARD])
     cg.add_build_flag(f"-DUSE_ESP32_VARIANT_{config[CONF_VARIANT]}")
     cg.add_define("ESPHOME_VARIANT", VARIANT_FRIENDLY[config[CONF_VARIANT]])
+    if config[CONF_NETWORK_TASK]:
+        cg.add_define("USE_NETWORK_TASK")
 
     cg.add_platformio_option("lib_ldf_mode", "off")
 
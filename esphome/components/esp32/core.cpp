@@ -72,7 +72,12 @@ void loop_task(void *pv_params) {
 
 extern "C" void app_main() {
   esp32::setup_preferences();
+#ifdef USE_NETWORK_TASK
+  // Keep the main loop on the APP CPU, the network task runs on the PRO CPU with the WiFi and lwIP tasks
+  xTaskCreatePinnedToCore(loop_task, "loopTask", 8192, nullptr, 1, &loop_task_handle, 1);
+#else
   xTaskCreate(loop_task, "loopTask", 8192, nullptr, 1, &loop_task_handle);
+#endif
 }
 #endif  // USE_ESP_IDF
 
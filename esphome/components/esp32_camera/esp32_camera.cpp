@@ -31,8 +31,8 @@ void ESP32Camera::setup() {
   this->update_camera_parameters();
 
   /* initialize RTOS */
-  this->framebuffer_get_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
-  this->framebuffer_return_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
+  this->framebuffer_get_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
+  this->framebuffer_return_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
   xTaskCreatePinnedToCore(&ESP32Camera::framebuffer_task,
                           "framebuffer_task",  // name
                           1024,                // stack size
@@ -127,7 +127,7 @@ void ESP32Camera::dump_config() {
   sensor_t *s = esp_camera_sensor_get();
   auto st = s->status;
   ESP_LOGCONFIG(TAG, "  JPEG Quality: %u", st.quality);
-  // ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
+  ESP_LOGCONFIG(TAG, "  Frame Buffer Count: %zu", conf.fb_count);
   ESP_LOGCONFIG(TAG, "  Contrast: %d", st.contrast);
   ESP_LOGCONFIG(TAG, "  Brightness: %d", st.brightness);
   ESP_LOGCONFIG(TAG, "  Saturation: %d", st.saturation);
@@ -153,13 +153,7 @@ void ESP32Camera::dump_config() {
 }
 
 void ESP32Camera::loop() {
-  // check if we can return the image
-  if (this->can_return_image_()) {
-    // return image
-    auto *fb = this->current_image_->get_raw_buffer();
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    this->current_image_.reset();
-  }
+  this->return_images_();
 
   // request idle image every idle_update_interval
   const uint32_t now = millis();
@@ -171,8 +165,8 @@ void ESP32Camera::loop() {
   // Check if we should fetch a new image
   if (!this->has_requested_image_())
     return;
-  if (this->current_image_.use_count() > 1) {
-    // image is still in use
+  if (this->images_.size() >= this->config_.fb_count) {
+    // all frame buffers are still in use
     return;
   }
   if (now - this->last_update_ <= this->max_update_interval_)
@@ -185,16 +179,23 @@ void ESP32Camera::loop() {
     ESP_LOGVV(TAG, "No frame ready");
     return;
   }
+  // latest frame wins, older ones that queued up meanwhile go straight back to the driver
+  camera_fb_t *newer_fb;
+  while (xQueueReceive(this->framebuffer_get_queue_, &newer_fb, 0L) == pdTRUE) {
+    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    fb = newer_fb;
+  }
 
   if (fb == nullptr) {
     ESP_LOGW(TAG, "Got invalid frame from camera!");
     xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
     return;
   }
-  this->current_image_ = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  auto image = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  this->images_.push_back(image);
 
   ESP_LOGD(TAG, "Got Image: len=%u", fb->len);
-  this->new_image_callback_.call(this->current_image_);
+  this->new_image_callback_.call(image);
   this->last_update_ = now;
   this->single_requesters_ = 0;
 }
@@ -333,6 +334,8 @@ void ESP32Camera::set_max_update_interval(uint32_t max_update_interval) {
 void ESP32Camera::set_idle_update_interval(uint32_t idle_update_interval) {
   this->idle_update_interval_ = idle_update_interval;
 }
+/* set frame buffers */
+void ESP32Camera::set_frame_buffer_count(uint8_t count) { this->config_.fb_count = count; }
 
 /* ---------------- public API (specific) ---------------- */
 void ESP32Camera::add_image_callback(std::function<void(std::shared_ptr<CameraImage>)> &&callback) {
@@ -379,14 +382,33 @@ void ESP32Camera::update_camera_parameters() {
 
 /* ---------------- Internal methods ---------------- */
 bool ESP32Camera::has_requested_image_() const { return this->single_requesters_ || this->stream_requesters_; }
-bool ESP32Camera::can_return_image_() const { return this->current_image_.use_count() == 1; }
+void ESP32Camera::return_images_() {
+  for (auto it = this->images_.begin(); it != this->images_.end();) {
+    if (it->use_count() > 1) {
+      // image is still in use
+      ++it;
+      continue;
+    }
+    auto *fb = (*it)->get_raw_buffer();
+    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    it = this->images_.erase(it);
+  }
+}
 void ESP32Camera::framebuffer_task(void *pv) {
+  const size_t count = global_esp32_camera->config_.fb_count;
+  size_t taken = 0;
   while (true) {
     camera_fb_t *framebuffer = esp_camera_fb_get();
     xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
-    // return is no-op for config with 1 fb
-    xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
-    esp_camera_fb_return(framebuffer);
+    taken++;
+    // the driver fills the free frame buffers meanwhile, only wait for a return once all of them are taken
+    TickType_t wait = taken >= count ? portMAX_DELAY : 0;
+    while (xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, wait) == pdTRUE) {
+      // return is no-op for config with 1 fb
+      esp_camera_fb_return(framebuffer);
+      taken--;
+      wait = 0;
+    }
   }
 }
 
@@ -394,6 +416,13 @@ ESP32Camera *global_esp32_camera;  // NOLINT(cppcoreguidelines-avoid-non-const-g
 
 /* ---------------- CameraImageReader class ---------------- */
 void CameraImageReader::set_image(std::shared_ptr<CameraImage> image) {
+  if (this->image_) {
+    // finish the current image first, a newer one replaces the one waiting
+    if (this->next_image_)
+      this->stats_.dropped++;
+    this->next_image_ = std::move(image);
+    return;
+  }
   this->image_ = std::move(image);
   this->offset_ = 0;
 }
@@ -403,12 +432,27 @@ size_t CameraImageReader::available() const {
 
   return this->image_->get_data_length() - this->offset_;
 }
-void CameraImageReader::return_image() { this->image_.reset(); }
+void CameraImageReader::return_image() {
+  if (this->image_ && this->offset_ == this->image_->get_data_length()) {
+    const uint32_t latency = millis() - this->image_->get_timestamp();
+    this->stats_.frames++;
+    this->stats_.latency_sum += latency;
+    this->stats_.latency_max = std::max(this->stats_.latency_max, latency);
+  }
+  this->image_ = std::move(this->next_image_);
+  this->offset_ = 0;
+}
+CameraImageReader::Stats CameraImageReader::take_stats() {
+  Stats stats = this->stats_;
+  this->stats_ = Stats{};
+  return stats;
+}
 void CameraImageReader::consume_data(size_t consumed) { this->offset_ += consumed; }
 uint8_t *CameraImageReader::peek_data_buffer() { return this->image_->get_data_buffer() + this->offset_; }
 
 /* ---------------- CameraImage class ---------------- */
-CameraImage::CameraImage(camera_fb_t *buffer, uint8_t requesters) : buffer_(buffer), requesters_(requesters) {}
+CameraImage::CameraImage(camera_fb_t *buffer, uint8_t requesters)
+    : buffer_(buffer), requesters_(requesters), timestamp_(millis()) {}
 
 camera_fb_t *CameraImage::get_raw_buffer() { return this->buffer_; }
 uint8_t *CameraImage::get_data_buffer() { return this->buffer_->buf; }
@@ -9,6 +9,7 @@
 #include <esp_camera.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <vector>
 
 namespace esphome {
 namespace esp32_camera {
@@ -80,10 +81,13 @@ class CameraImage {
   uint8_t *get_data_buffer();
   size_t get_data_length();
   bool was_requested_by(CameraRequester requester) const;
+  /// millis() when the image was taken from the camera.
+  uint32_t get_timestamp() const { return this->timestamp_; }
 
  protected:
   camera_fb_t *buffer_;
   uint8_t requesters_;
+  uint32_t timestamp_;
 };
 
 struct CameraImageData {
@@ -92,17 +96,34 @@ struct CameraImageData {
 };
 
 /* ---------------- CameraImageReader class ---------------- */
+/** Reads the images for one consumer, a new image arriving while one is being read waits for it to finish.
+ *
+ * Only the newest waiting image is kept, so a slow consumer skips frames instead of holding up the camera.
+ */
 class CameraImageReader {
  public:
+  struct Stats {
+    uint32_t frames{0};
+    uint32_t dropped{0};
+    /// Sum and maximum of the time from taking a frame to reading its last byte, in ms.
+    uint32_t latency_sum{0};
+    uint32_t latency_max{0};
+  };
+
   void set_image(std::shared_ptr<CameraImage> image);
   size_t available() const;
   uint8_t *peek_data_buffer();
   void consume_data(size_t consumed);
   void return_image();
 
+  /// Statistics since the previous call.
+  Stats take_stats();
+
  protected:
   std::shared_ptr<CameraImage> image_;
+  std::shared_ptr<CameraImage> next_image_;
   size_t offset_{0};
+  Stats stats_{};
 };
 
 /* ---------------- ESP32Camera class ---------------- */
@@ -145,6 +166,8 @@ class ESP32Camera : public Component, public EntityBase {
   /* -- framerates */
   void set_max_update_interval(uint32_t max_update_interval);
   void set_idle_update_interval(uint32_t idle_update_interval);
+  /* -- frame buffers */
+  void set_frame_buffer_count(uint8_t count);
 
   /* public API (derivated) */
   void setup() override;
@@ -164,7 +187,7 @@ class ESP32Camera : public Component, public EntityBase {
  protected:
   /* internal methods */
   bool has_requested_image_() const;
-  bool can_return_image_() const;
+  void return_images_();
 
   static void framebuffer_task(void *pv);
 
@@ -196,7 +219,8 @@ class ESP32Camera : public Component, public EntityBase {
   uint32_t idle_update_interval_{15000};
 
   esp_err_t init_error_{ESP_OK};
-  std::shared_ptr<CameraImage> current_image_;
+  /// Images handed out to consumers, each holds one of the frame buffers.
+  std::vector<std::shared_ptr<CameraImage>> images_;
   uint8_t single_requesters_{0};
   uint8_t stream_requesters_{0};
   QueueHandle_t framebuffer_get_queue_;
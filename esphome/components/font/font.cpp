@@ -86,9 +86,32 @@ int Font::match_next_glyph(const char *str, int *match_length) {
     return -1;
   return lo;
 }
-void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
-  *baseline = this->baseline_;
-  *height = this->height_;
+const Font::TextLayout &Font::get_layout_(const char *str) {
+  // FNV-1 over the bytes of the text, fnv1_hash() would need a std::string copy of it
+  uint32_t hash = 2166136261UL;
+  for (const char *c = str; *c != '\0'; c++) {
+    hash *= 16777619UL;
+    hash ^= static_cast<uint8_t>(*c);
+  }
+
+  this->layout_uses_++;
+  TextLayout *layout = &this->layouts_[0];
+  for (auto &candidate : this->layouts_) {
+    if (candidate.valid && candidate.hash == hash && candidate.text == str) {
+      candidate.last_used = this->layout_uses_;
+      this->layout_hits_++;
+      return candidate;
+    }
+    if (candidate.last_used < layout->last_used)
+      layout = &candidate;
+  }
+
+  this->layout_misses_++;
+  layout->hash = hash;
+  layout->text.assign(str);
+  layout->glyphs.clear();
+  layout->last_used = this->layout_uses_;
+  layout->valid = true;
   int i = 0;
   int min_x = 0;
   bool has_char = false;
@@ -96,6 +119,7 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   while (str[i] != '\0') {
     int match_length;
     int glyph_n = this->match_next_glyph(str + i, &match_length);
+    layout->glyphs.push_back(glyph_n);
     if (glyph_n < 0) {
       // Unknown char, skip
       if (!this->get_glyphs().empty())
@@ -115,15 +139,22 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
     i += match_length;
     has_char = true;
   }
-  *x_offset = min_x;
-  *width = x - min_x;
+  layout->x_offset = min_x;
+  layout->width = x - min_x;
+  return *layout;
+}
+void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
+  *baseline = this->baseline_;
+  *height = this->height_;
+  const TextLayout &layout = this->get_layout_(str);
+  *x_offset = layout.x_offset;
+  *width = layout.width;
 }
 void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text) {
+  const TextLayout &layout = this->get_layout_(text);
   int i = 0;
   int x_at = x_start;
-  while (text[i] != '\0') {
-    int match_length;
-    int glyph_n = this->match_next_glyph(text + i, &match_length);
+  for (int16_t glyph_n : layout.glyphs) {
     if (glyph_n < 0) {
       // Unknown char, skip
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
@@ -141,7 +172,7 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
     glyph.draw(x_at, y_start, display, color);
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
-    i += match_length;
+    i += strlen(glyph.get_char());
   }
 }
 
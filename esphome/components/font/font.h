@@ -7,6 +7,9 @@
 namespace esphome {
 namespace font {
 
+/// Number of strings a font keeps the layout of, a page or a menu rarely shows more at once.
+static const uint8_t FONT_LAYOUT_CACHE_SIZE = 8;
+
 class Font;
 
 struct GlyphData {
@@ -57,10 +60,39 @@ class Font : public display::BaseFont {
 
   const std::vector<Glyph, ExternalRAMAllocator<Glyph>> &get_glyphs() const { return glyphs_; }
 
+  /// Number of measure() and print() calls that found the layout of their text in the cache.
+  uint32_t get_layout_hits() const { return this->layout_hits_; }
+  /// Number of measure() and print() calls that had to look up the glyphs of their text.
+  uint32_t get_layout_misses() const { return this->layout_misses_; }
+
  protected:
+  /** The glyphs and measured bounds of a text.
+   *
+   * Printing text usually measures it first for the alignment, and the same texts are drawn on every update, so
+   * keeping the result of the glyph lookups for the last few texts saves most of them.
+   */
+  struct TextLayout {
+    uint32_t hash{0};
+    std::string text;
+    int width{0};
+    int x_offset{0};
+    /// Index of the glyph of each character, -1 for characters without representation in the font
+    std::vector<int16_t> glyphs;
+    /// Value of layout_uses_ when last returned, 0 for a never used slot
+    uint64_t last_used{0};
+    bool valid{false};
+  };
+
+  /// Return the layout of str from the cache, or replace the least recently used layout with it.
+  const TextLayout &get_layout_(const char *str);
+
   std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
   int baseline_;
   int height_;
+  TextLayout layouts_[FONT_LAYOUT_CACHE_SIZE];
+  uint64_t layout_uses_{0};
+  uint32_t layout_hits_{0};
+  uint32_t layout_misses_{0};
 };
 
 }  // namespace font
@@ -21,18 +21,29 @@ RestoringGlobalStringComponent = globals_ns.class_(
 GlobalVarSetAction = globals_ns.class_("GlobalVarSetAction", automation.Action)
 
 CONF_MAX_RESTORE_DATA_LENGTH = "max_restore_data_length"
+CONF_WRITE_INTERVAL = "write_interval"
+
+
+def validate_write_interval(config):
+    if CONF_WRITE_INTERVAL in config and not config[CONF_RESTORE_VALUE]:
+        raise cv.Invalid(f"'{CONF_WRITE_INTERVAL}' requires 'restore_value: true'")
+    return config
 
 
 MULTI_CONF = True
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.Required(CONF_ID): cv.declare_id(GlobalsComponent),
-        cv.Required(CONF_TYPE): cv.string_strict,
-        cv.Optional(CONF_INITIAL_VALUE): cv.string_strict,
-        cv.Optional(CONF_RESTORE_VALUE, default=False): cv.boolean,
-        cv.Optional(CONF_MAX_RESTORE_DATA_LENGTH): cv.int_range(0, 254),
-    }
-).extend(cv.COMPONENT_SCHEMA)
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.declare_id(GlobalsComponent),
+            cv.Required(CONF_TYPE): cv.string_strict,
+            cv.Optional(CONF_INITIAL_VALUE): cv.string_strict,
+            cv.Optional(CONF_RESTORE_VALUE, default=False): cv.boolean,
+            cv.Optional(CONF_MAX_RESTORE_DATA_LENGTH): cv.int_range(0, 254),
+            cv.Optional(CONF_WRITE_INTERVAL): cv.positive_time_period_milliseconds,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    validate_write_interval,
+)
 
 
 # Run with low priority so that namespaces are registered first
@@ -66,6 +77,8 @@ async def to_code(config):
             value = value.encode()
         hash_ = int(hashlib.md5(value).hexdigest()[:8], 16)
         cg.add(glob.set_name_hash(hash_))
+        if CONF_WRITE_INTERVAL in config:
+            cg.add(glob.set_write_interval(config[CONF_WRITE_INTERVAL]))
 
 
 @automation.register_action(
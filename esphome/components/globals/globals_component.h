@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
 #include <cstring>
 
 namespace esphome {
@@ -24,7 +25,41 @@ template<typename T> class GlobalsComponent : public Component {
   T value_{};
 };
 
-template<typename T> class RestoringGlobalsComponent : public Component {
+/** Common part of the globals restored from preferences.
+ *
+ * Lambdas and actions reach the value through value(), which hands out a reference that may be written. So every
+ * call marks the global dirty, and the scheduler stores it once the write interval passed. Globals nobody touched
+ * cost nothing in the main loop, and a global changing rapidly is written at most once per interval.
+ */
+class RestoringGlobalBase : public Component {
+ public:
+  float get_setup_priority() const override { return setup_priority::HARDWARE; }
+
+  void on_shutdown() override { this->store_value_(); }
+
+  void set_name_hash(uint32_t name_hash) { this->name_hash_ = name_hash; }
+  void set_write_interval(uint32_t write_interval) { this->write_interval_ = write_interval; }
+
+ protected:
+  virtual void store_value_() = 0;
+
+  void mark_dirty_() {
+    if (this->dirty_)
+      return;
+    this->dirty_ = true;
+    this->set_timeout("store", this->write_interval_, [this]() {
+      this->dirty_ = false;
+      this->store_value_();
+    });
+  }
+
+  bool dirty_{false};
+  uint32_t write_interval_{1000};
+  uint32_t name_hash_{};
+  ESPPreferenceObject rtc_;
+};
+
+template<typename T> class RestoringGlobalsComponent : public RestoringGlobalBase {
  public:
   using value_type = T;
   explicit RestoringGlobalsComponent() = default;
@@ -34,7 +69,10 @@ template<typename T> class RestoringGlobalsComponent : public Component {
     memcpy(this->value_, initial_value.data(), sizeof(T));
   }
 
-  T &value() { return this->value_; }
+  T &value() {
+    this->mark_dirty_();
+    return this->value_;
+  }
 
   void setup() override {
     this->rtc_ = global_preferences->make_preference<T>(1944399030U ^ this->name_hash_);
@@ -42,16 +80,8 @@ template<typename T> class RestoringGlobalsComponent : public Component {
     memcpy(&this->prev_value_, &this->value_, sizeof(T));
   }
 
-  float get_setup_priority() const override { return setup_priority::HARDWARE; }
-
-  void loop() override { store_value_(); }
-
-  void on_shutdown() override { store_value_(); }
-
-  void set_name_hash(uint32_t name_hash) { this->name_hash_ = name_hash; }
-
  protected:
-  void store_value_() {
+  void store_value_() override {
     int diff = memcmp(&this->value_, &this->prev_value_, sizeof(T));
     if (diff != 0) {
       this->rtc_.save(&this->value_);
@@ -61,12 +91,10 @@ template<typename T> class RestoringGlobalsComponent : public Component {
 
   T value_{};
   T prev_value_{};
-  uint32_t name_hash_{};
-  ESPPreferenceObject rtc_;
 };
 
 // Use with string or subclasses of strings
-template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public Component {
+template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public RestoringGlobalBase {
  public:
   using value_type = T;
   explicit RestoringGlobalStringComponent() = default;
@@ -76,7 +104,10 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
     memcpy(this->value_, initial_value.data(), sizeof(T));
   }
 
-  T &value() { return this->value_; }
+  T &value() {
+    this->mark_dirty_();
+    return this->value_;
+  }
 
   void setup() override {
     char temp[SZ];
@@ -88,16 +119,8 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
     this->prev_value_.assign(this->value_);
   }
 
-  float get_setup_priority() const override { return setup_priority::HARDWARE; }
-
-  void loop() override { store_value_(); }
-
-  void on_shutdown() override { store_value_(); }
-
-  void set_name_hash(uint32_t name_hash) { this->name_hash_ = name_hash; }
-
  protected:
-  void store_value_() {
+  void store_value_() override {
     int diff = this->value_.compare(this->prev_value_);
     if (diff != 0) {
       // Make it into a length prefixed thing
@@ -119,8 +142,6 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
 
   T value_{};
   T prev_value_{};
-  uint32_t name_hash_{};
-  ESPPreferenceObject rtc_;
 };
 
 template<class C, typename... Ts> class GlobalVarSetAction : public Action<Ts...> {
@@ -1,7 +1,9 @@
 from esphome.components.font import Font
 from esphome.components import sensor, color
+from esphome.components.history import HistorySeries
 import esphome.config_validation as cv
 import esphome.codegen as cg
+import esphome.final_validate as fv
 from esphome.const import (
     CONF_COLOR,
     CONF_DIRECTION,
@@ -31,6 +33,8 @@ from esphome.const import (
 
 CODEOWNERS = ["@synco"]
 
+CONF_HISTORY_ID = "history_id"
+
 DEPENDENCIES = ["display", "sensor"]
 MULTI_CONF = True
 
@@ -66,6 +70,7 @@ GRAPH_TRACE_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(GraphTrace),
         cv.Required(CONF_SENSOR): cv.use_id(sensor.Sensor),
+        cv.Optional(CONF_HISTORY_ID): cv.use_id(HistorySeries),
         cv.Optional(CONF_NAME): cv.string,
         cv.Optional(CONF_LINE_THICKNESS): cv.positive_int,
         cv.Optional(CONF_LINE_TYPE): cv.enum(LINE_TYPE, upper=True),
@@ -100,6 +105,7 @@ GRAPH_SCHEMA = cv.Schema(
         cv.Optional(CONF_BORDER): cv.boolean,
         # Single trace options in base
         cv.Optional(CONF_SENSOR): cv.use_id(sensor.Sensor),
+        cv.Optional(CONF_HISTORY_ID): cv.use_id(HistorySeries),
         cv.Optional(CONF_LINE_THICKNESS): cv.positive_int,
         cv.Optional(CONF_LINE_TYPE): cv.enum(LINE_TYPE, upper=True),
         cv.Optional(CONF_COLOR): cv.use_id(color.ColorStruct),
@@ -147,6 +153,25 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+def _validate_history(config):
+    fconf = fv.full_config.get()
+    for i, trace in enumerate(config[CONF_TRACES]):
+        if CONF_HISTORY_ID not in trace:
+            continue
+        path = fconf.get_path_for_id(trace[CONF_HISTORY_ID])[:-1]
+        series = fconf.get_config_for_path(path)
+        if series[CONF_SENSOR].id != trace[CONF_SENSOR].id:
+            raise cv.Invalid(
+                f"History '{trace[CONF_HISTORY_ID]}' records '{series[CONF_SENSOR]}', "
+                f"not the sensor '{trace[CONF_SENSOR]}' of this trace",
+                [CONF_TRACES, i, CONF_HISTORY_ID],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _validate_history
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_duration(config[CONF_DURATION]))
@@ -175,6 +200,9 @@ async def to_code(config):
         tr = cg.new_Pvariable(trace[CONF_ID], GraphTrace())
         sens = await cg.get_variable(trace[CONF_SENSOR])
         cg.add(tr.set_sensor(sens))
+        if CONF_HISTORY_ID in trace:
+            hist = await cg.get_variable(trace[CONF_HISTORY_ID])
+            cg.add(tr.set_history(hist))
         if CONF_NAME in trace:
             cg.add(tr.set_name(trace[CONF_NAME]))
         else:
@@ -49,14 +49,46 @@ void HistoryData::take_sample(float data) {
   }
 }
 
+#ifdef USE_HISTORY
+void HistoryData::load_history(const history::HistorySeries *series, uint32_t duration) {
+  const uint32_t now = history::uptime_seconds();
+  const uint32_t from = now > duration ? now - duration : 0;
+  std::fill(this->samples_.begin(), this->samples_.end(), NAN);
+  this->count_ = 0;
+  this->recent_min_ = NAN;
+  this->recent_max_ = NAN;
+  series->query(from, now, [this, now, duration](uint32_t timestamp, float value) {
+    // get_value(idx) returns the sample idx steps before now
+    const int idx = int(uint64_t(now - timestamp) * this->length_ / std::max<uint32_t>(duration, 1));
+    if (idx < this->length_)
+      this->samples_[this->length_ - 1 - idx] = value;
+    if (std::isnan(this->recent_max_) || this->recent_max_ < value)
+      this->recent_max_ = value;
+    if (std::isnan(this->recent_min_) || this->recent_min_ > value)
+      this->recent_min_ = value;
+  });
+}
+#endif
+
 void GraphTrace::init(Graph *g) {
   ESP_LOGI(TAG, "Init trace for sensor %s", this->get_name().c_str());
   this->data_.init(g->get_width());
+#ifdef USE_HISTORY
+  // The samples are loaded from the history before drawing
+  if (this->history_ != nullptr)
+    return;
+#endif
   sensor_->add_on_state_callback([this](float state) { this->data_.take_sample(state); });
   this->data_.set_update_time_ms(g->get_duration() * 1000 / g->get_width());
 }
 
 void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color color) {
+#ifdef USE_HISTORY
+  for (auto *trace : traces_) {
+    if (trace->history_ != nullptr)
+      trace->data_.load_history(trace->history_, this->duration_);
+  }
+#endif
   /// Plot border
   if (this->border_) {
     buff->horizontal_line(x_offset, y_offset, this->width_, color);
@@ -5,6 +5,11 @@
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/core/color.h"
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+
+#ifdef USE_HISTORY
+#include "esphome/components/history/history.h"
+#endif
 
 namespace esphome {
 
@@ -89,6 +94,10 @@ class HistoryData {
   ~HistoryData();
   void set_update_time_ms(uint32_t update_time_ms) { update_time_ = update_time_ms; }
   void take_sample(float data);
+#ifdef USE_HISTORY
+  /// Replace the samples with the last duration seconds of series.
+  void load_history(const history::HistorySeries *series, uint32_t duration);
+#endif
   int get_length() const { return length_; }
   float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
   float get_recent_max() const { return recent_max_; }
@@ -110,6 +119,9 @@ class GraphTrace {
   void init(Graph *g);
   void set_name(std::string name) { name_ = std::move(name); }
   void set_sensor(sensor::Sensor *sensor) { sensor_ = sensor; }
+#ifdef USE_HISTORY
+  void set_history(history::HistorySeries *history) { history_ = history; }
+#endif
   uint8_t get_line_thickness() { return this->line_thickness_; }
   void set_line_thickness(uint8_t val) { this->line_thickness_ = val; }
   enum LineType get_line_type() { return this->line_type_; }
@@ -121,6 +133,9 @@ class GraphTrace {
 
  protected:
   sensor::Sensor *sensor_{nullptr};
+#ifdef USE_HISTORY
+  history::HistorySeries *history_{nullptr};
+#endif
   std::string name_{""};
   uint8_t line_thickness_{3};
   enum LineType line_type_ { LINE_TYPE_SOLID };
@@ -0,0 +1,93 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor, time, web_server_base
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
+from esphome.const import (
+    CONF_ID,
+    CONF_RESOLUTION,
+    CONF_SENSOR,
+    CONF_SIZE,
+    CONF_TIME_ID,
+)
+
+CODEOWNERS = ["@esphome/core"]
+DEPENDENCIES = ["sensor"]
+
+CONF_PSRAM = "psram"
+CONF_SERIES = "series"
+CONF_TIERS = "tiers"
+
+history_ns = cg.esphome_ns.namespace("history")
+HistoryComponent = history_ns.class_("HistoryComponent", cg.Component)
+HistorySeries = history_ns.class_("HistorySeries")
+
+# Each buffer block is 256 bytes
+BLOCK_SIZE = 256
+
+
+def validate_tiers(value):
+    resolutions = [tier[CONF_RESOLUTION].total_seconds for tier in value]
+    if resolutions != sorted(set(resolutions)):
+        raise cv.Invalid(
+            "Tiers have to be listed from the finest to the coarsest resolution"
+        )
+    return value
+
+
+TIER_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_RESOLUTION, default="0s"): cv.positive_time_period_seconds,
+        cv.Required(CONF_SIZE): cv.All(
+            cv.validate_bytes, cv.int_range(min=BLOCK_SIZE)
+        ),
+    }
+)
+
+SERIES_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(HistorySeries),
+        cv.Required(CONF_SENSOR): cv.use_id(sensor.Sensor),
+        cv.Optional(CONF_PSRAM): cv.All(
+            cv.only_on_esp32, cv.requires_component("psram"), cv.boolean
+        ),
+        cv.Required(CONF_TIERS): cv.All(
+            cv.ensure_list(TIER_SCHEMA), cv.Length(min=1, max=4), validate_tiers
+        ),
+    }
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(HistoryComponent),
+        cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+        cv.Optional(CONF_WEB_SERVER_BASE_ID): cv.All(
+            cv.only_with_arduino, cv.use_id(web_server_base.WebServerBase)
+        ),
+        cv.Required(CONF_SERIES): cv.ensure_list(SERIES_SCHEMA),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add_define("USE_HISTORY")
+
+    if CONF_TIME_ID in config:
+        clock = await cg.get_variable(config[CONF_TIME_ID])
+        cg.add(var.set_time(clock))
+    if CONF_WEB_SERVER_BASE_ID in config:
+        cg.add_define("USE_HISTORY_WEB_SERVER")
+        base = await cg.get_variable(config[CONF_WEB_SERVER_BASE_ID])
+        cg.add(var.set_web_server_base(base))
+
+    for conf in config[CONF_SERIES]:
+        sens = await cg.get_variable(conf[CONF_SENSOR])
+        series = cg.new_Pvariable(conf[CONF_ID], sens)
+        if conf.get(CONF_PSRAM, False):
+            cg.add(series.set_psram(True))
+        for tier in conf[CONF_TIERS]:
+            cg.add(
+                series.add_tier(tier[CONF_RESOLUTION].total_seconds, tier[CONF_SIZE])
+            )
+        cg.add(var.add_series(series))
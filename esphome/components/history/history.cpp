@@ -0,0 +1,188 @@
+#include "history.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstring>
+
+#ifdef USE_HISTORY_WEB_SERVER
+#include "esphome/core/application.h"
+#endif
+
+namespace esphome {
+namespace history {
+
+static const char *const TAG = "history";
+
+uint32_t uptime_seconds() {
+  static uint32_t last_millis = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static uint32_t millis_major = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  const uint32_t now = millis();
+  if (now < last_millis)
+    millis_major++;
+  last_millis = now;
+  return ((uint64_t(millis_major) << 32) | now) / 1000;
+}
+
+void HistorySeries::add_tier(uint32_t resolution, size_t size) {
+  Tier tier{};
+  tier.resolution = resolution;
+  tier.size = size;
+  this->tiers_.push_back(std::move(tier));
+}
+
+void HistorySeries::setup() {
+  for (auto &tier : this->tiers_) {
+    if (!tier.buffer.init(tier.size, this->psram_))
+      ESP_LOGE(TAG, "Could not allocate %zu bytes for the history of '%s'", tier.size, this->sensor_->get_name().c_str());
+  }
+  this->sensor_->add_on_state_callback([this](float state) { this->add_value_(state); });
+}
+
+void HistorySeries::dump_config() {
+  ESP_LOGCONFIG(TAG, "  Sensor '%s':", this->sensor_->get_name().c_str());
+  for (auto &tier : this->tiers_) {
+    ESP_LOGCONFIG(TAG, "    Resolution: %" PRIu32 "s, %zu values, %zu of %zu bytes used", tier.resolution,
+                  tier.buffer.count(), tier.buffer.used(), tier.buffer.capacity());
+  }
+}
+
+void HistorySeries::query(uint32_t from, uint32_t to, const std::function<void(uint32_t, float)> &callback) const {
+  // Walk from the coarsest to the finest tier, each one up to where the next finer tier takes over
+  for (size_t i = this->tiers_.size(); i-- > 0;) {
+    uint32_t end = to;
+    if (i > 0) {
+      auto finer = this->tiers_[i - 1].buffer.oldest();
+      if (finer.has_value()) {
+        if (*finer == 0)
+          continue;
+        end = std::min(end, *finer - 1);
+      }
+    }
+    if (end < from)
+      continue;
+    this->tiers_[i].buffer.read(from, end, callback);
+    if (end >= to)
+      return;
+    from = end + 1;
+  }
+}
+
+void HistorySeries::add_value_(float value) {
+  if (std::isnan(value))
+    return;
+  const uint32_t now = uptime_seconds();
+  for (auto &tier : this->tiers_) {
+    if (tier.resolution == 0) {
+      tier.buffer.append(now, this->round_(value));
+      continue;
+    }
+    const uint32_t window = now - now % tier.resolution;
+    if (tier.samples != 0 && tier.window != window) {
+      tier.buffer.append(tier.window, this->round_(tier.sum / tier.samples));
+      tier.samples = 0;
+      tier.sum = 0.0f;
+    }
+    tier.window = window;
+    tier.sum += value;
+    tier.samples++;
+  }
+}
+
+float HistorySeries::round_(float value) const {
+  // Dropping the digits below the sensor accuracy makes repeated values identical, which compresses to a single bit
+  const int8_t accuracy = this->sensor_->get_accuracy_decimals();
+  if (accuracy < 0 || accuracy > 6)
+    return value;
+  const float multiplier = powf(10.0f, accuracy);
+  return roundf(value * multiplier) / multiplier;
+}
+
+void HistoryComponent::setup() {
+  for (auto *series : this->series_)
+    series->setup();
+#ifdef USE_HISTORY_WEB_SERVER
+  if (this->base_ != nullptr) {
+    this->base_->init();
+    this->base_->add_handler(new HistoryWebHandler(this));  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+#endif
+}
+
+void HistoryComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "History:");
+  for (auto *series : this->series_)
+    series->dump_config();
+}
+
+HistorySeries *HistoryComponent::get_series(sensor::Sensor *sensor) const {
+  for (auto *series : this->series_) {
+    if (series->get_sensor() == sensor)
+      return series;
+  }
+  return nullptr;
+}
+
+uint32_t HistoryComponent::get_epoch_offset() const {
+#ifdef USE_TIME
+  if (this->time_ != nullptr) {
+    auto now = this->time_->utcnow();
+    if (now.is_valid())
+      return now.timestamp - uptime_seconds();
+  }
+#endif
+  return 0;
+}
+
+#ifdef USE_HISTORY_WEB_SERVER
+static const char *const URL_PREFIX = "/history/";
+
+static sensor::Sensor *find_sensor(const std::string &object_id) {
+  for (auto *obj : App.get_sensors()) {
+    if (obj->get_object_id() == object_id)
+      return obj;
+  }
+  return nullptr;
+}
+
+bool HistoryWebHandler::canHandle(AsyncWebServerRequest *request) {
+  return request->method() == HTTP_GET && str_startswith(request->url().c_str(), URL_PREFIX);
+}
+
+void HistoryWebHandler::handleRequest(AsyncWebServerRequest *req) {
+  const std::string url = req->url().c_str();
+  auto *sensor = find_sensor(url.substr(strlen(URL_PREFIX)));
+  auto *series = sensor == nullptr ? nullptr : this->parent_->get_series(sensor);
+  if (series == nullptr) {
+    req->send(404);
+    return;
+  }
+
+  // Timestamps are UNIX time once the time is known, seconds since boot before
+  const uint32_t offset = this->parent_->get_epoch_offset();
+  uint32_t from = 0;
+  if (req->hasParam("from")) {
+    auto value = parse_number<uint32_t>(req->getParam("from")->value().c_str());
+    if (value.has_value())
+      from = *value > offset ? *value - offset : 0;
+  }
+
+  AsyncResponseStream *stream = req->beginResponseStream("application/json");
+  stream->printf(R"({"id":"%s","epoch":%s,"values":[)", sensor->get_object_id().c_str(),
+                 offset != 0 ? "true" : "false");
+  const int8_t accuracy = sensor->get_accuracy_decimals();
+  bool first = true;
+  series->query(from, UINT32_MAX, [&](uint32_t timestamp, float value) {
+    stream->printf(R"(%s[%)" PRIu32 ",%s]", first ? "" : ",", timestamp + offset,
+                   value_accuracy_to_string(value, accuracy).c_str());
+    first = false;
+  });
+  stream->print("]}");
+  req->send(stream);
+}
+#endif
+
+}  // namespace history
+}  // namespace esphome
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/components/sensor/sensor.h"
+#include "time_series.h"
+
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
+#ifdef USE_HISTORY_WEB_SERVER
+#include "esphome/components/web_server_base/web_server_base.h"
+#endif
+
+namespace esphome {
+namespace history {
+
+/// Seconds since boot, not wrapping after 49 days like millis().
+uint32_t uptime_seconds();
+
+/** History of a single sensor, kept in one or more tiers of decreasing resolution.
+ *
+ * Every tier averages the sensor values over windows of its resolution (0 stores every value) and keeps them in its
+ * own compressed buffer, so a small fine tier can cover the last hours and a coarse tier the last days.
+ */
+class HistorySeries {
+ public:
+  explicit HistorySeries(sensor::Sensor *sensor) : sensor_(sensor) {}
+
+  /** Add a tier, tiers have to be added from the finest to the coarsest resolution.
+   *
+   * @param resolution Window in seconds the values are averaged over, 0 to store every value.
+   * @param size Memory budget of the tier in bytes.
+   */
+  void add_tier(uint32_t resolution, size_t size);
+  void set_psram(bool psram) { this->psram_ = psram; }
+
+  void setup();
+  void dump_config();
+
+  /** Call callback for all stored values with from <= timestamp <= to, oldest first.
+   *
+   * Each time range is served from the finest tier still covering it. Timestamps are in uptime_seconds().
+   */
+  void query(uint32_t from, uint32_t to, const std::function<void(uint32_t, float)> &callback) const;
+
+  sensor::Sensor *get_sensor() const { return this->sensor_; }
+
+ protected:
+  struct Tier {
+    uint32_t resolution;
+    size_t size;
+    TimeSeriesBuffer buffer;
+    uint32_t window{0};
+    float sum{0.0f};
+    uint16_t samples{0};
+  };
+
+  void add_value_(float value);
+  float round_(float value) const;
+
+  sensor::Sensor *sensor_;
+  bool psram_{false};
+  std::vector<Tier> tiers_;
+};
+
+#ifdef USE_HISTORY_WEB_SERVER
+class HistoryComponent;
+
+/// Serves the history of a sensor as JSON on /history/<object_id>.
+class HistoryWebHandler : public AsyncWebHandler {
+ public:
+  explicit HistoryWebHandler(HistoryComponent *parent) : parent_(parent) {}
+
+  bool canHandle(AsyncWebServerRequest *request) override;
+  void handleRequest(AsyncWebServerRequest *req) override;
+
+ protected:
+  HistoryComponent *parent_;
+};
+#endif
+
+class HistoryComponent : public Component {
+ public:
+  void add_series(HistorySeries *series) { this->series_.push_back(series); }
+#ifdef USE_TIME
+  void set_time(time::RealTimeClock *time) { this->time_ = time; }
+#endif
+#ifdef USE_HISTORY_WEB_SERVER
+  void set_web_server_base(web_server_base::WebServerBase *base) { this->base_ = base; }
+#endif
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override {
+    // After the sensors, before WiFi
+    return setup_priority::DATA;
+  }
+
+  /// The series recording the given sensor, nullptr if there is none.
+  HistorySeries *get_series(sensor::Sensor *sensor) const;
+
+  /// Offset to add to uptime_seconds() timestamps to get UNIX time, 0 if the time is not known.
+  uint32_t get_epoch_offset() const;
+
+ protected:
+  std::vector<HistorySeries *> series_;
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
+#ifdef USE_HISTORY_WEB_SERVER
+  web_server_base::WebServerBase *base_{nullptr};
+#endif
+};
+
+}  // namespace history
+}  // namespace esphome
@@ -0,0 +1,218 @@
+#include "time_series.h"
+#include "esphome/core/helpers.h"
+
+#include <cstring>
+
+namespace esphome {
+namespace history {
+
+// Worst case size of a sample: 4 + 32 bits timestamp, 2 + 5 + 5 + 32 bits value
+static const uint16_t MAX_SAMPLE_BITS = 80;
+static const uint8_t NO_WINDOW = 0xFF;
+
+static uint64_t read_bits(const uint8_t *data, uint16_t &pos, uint8_t bits) {
+  uint64_t value = 0;
+  for (uint8_t i = 0; i < bits; i++, pos++)
+    value = (value << 1) | ((data[pos >> 3] >> (7 - (pos & 7))) & 1);
+  return value;
+}
+
+static uint32_t float_bits(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static float bits_float(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+bool TimeSeriesBuffer::init(size_t size, bool psram) {
+  const size_t count = std::max<size_t>(size / BLOCK_SIZE, 1);
+  if (psram) {
+    ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    this->data_ = allocator.allocate(count * BLOCK_SIZE);
+  } else {
+    this->data_ = new (std::nothrow) uint8_t[count * BLOCK_SIZE];  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+  if (this->data_ == nullptr)
+    return false;
+  this->blocks_.resize(count);
+  return true;
+}
+
+void TimeSeriesBuffer::append(uint32_t timestamp, float value) {
+  if (this->data_ == nullptr)
+    return;
+  if (this->used_ == 0) {
+    this->start_block_(timestamp, value);
+    return;
+  }
+
+  Block &block = this->blocks_[this->head_];
+  if (timestamp < this->cursor_.timestamp)
+    timestamp = this->cursor_.timestamp;
+  if (block.count == UINT16_MAX || size_t(block.bits) + MAX_SAMPLE_BITS > BLOCK_SIZE * 8) {
+    this->start_block_(timestamp, value);
+    return;
+  }
+
+  Cursor &cursor = this->cursor_;
+  const int64_t delta = int64_t(timestamp) - cursor.timestamp;
+  const int64_t dod = delta - cursor.delta;
+  if (dod == 0) {
+    this->write_bits_(0b0, 1);
+  } else if (dod >= -63 && dod <= 64) {
+    this->write_bits_(0b10, 2);
+    this->write_bits_(dod + 63, 7);
+  } else if (dod >= -255 && dod <= 256) {
+    this->write_bits_(0b110, 3);
+    this->write_bits_(dod + 255, 9);
+  } else if (dod >= -2047 && dod <= 2048) {
+    this->write_bits_(0b1110, 4);
+    this->write_bits_(dod + 2047, 12);
+  } else {
+    // Store the plain delta, it always fits
+    this->write_bits_(0b1111, 4);
+    this->write_bits_(delta, 32);
+  }
+  cursor.timestamp = timestamp;
+  cursor.delta = delta;
+
+  const uint32_t bits = float_bits(value);
+  const uint32_t xored = bits ^ cursor.value;
+  if (xored == 0) {
+    this->write_bits_(0b0, 1);
+  } else {
+    const uint8_t leading = std::min(__builtin_clz(xored), 31);
+    const uint8_t trailing = __builtin_ctz(xored);
+    if (cursor.leading != NO_WINDOW && leading >= cursor.leading && trailing >= cursor.trailing) {
+      // Fits in the window of meaningful bits of the previous value
+      this->write_bits_(0b10, 2);
+      this->write_bits_(xored >> cursor.trailing, 32 - cursor.leading - cursor.trailing);
+    } else {
+      const uint8_t length = 32 - leading - trailing;
+      this->write_bits_(0b11, 2);
+      this->write_bits_(leading, 5);
+      this->write_bits_(length - 1, 5);
+      this->write_bits_(xored >> trailing, length);
+      cursor.leading = leading;
+      cursor.trailing = trailing;
+    }
+  }
+  cursor.value = bits;
+
+  block.count++;
+  block.last = timestamp;
+}
+
+void TimeSeriesBuffer::read(uint32_t from, uint32_t to, const std::function<void(uint32_t, float)> &callback) const {
+  for (size_t age = 0; age < this->used_; age++) {
+    const size_t index = this->block_index_(age);
+    const Block &block = this->blocks_[index];
+    if (block.last < from)
+      continue;
+    if (block.first > to)
+      break;
+    this->decode_block_(index, from, to, callback);
+  }
+}
+
+optional<uint32_t> TimeSeriesBuffer::oldest() const {
+  if (this->used_ == 0)
+    return {};
+  return this->blocks_[this->block_index_(0)].first;
+}
+
+size_t TimeSeriesBuffer::count() const {
+  size_t count = 0;
+  for (size_t age = 0; age < this->used_; age++)
+    count += this->blocks_[this->block_index_(age)].count;
+  return count;
+}
+
+size_t TimeSeriesBuffer::used() const {
+  size_t bits = 0;
+  for (size_t age = 0; age < this->used_; age++)
+    bits += this->blocks_[this->block_index_(age)].bits;
+  return (bits + 7) / 8;
+}
+
+size_t TimeSeriesBuffer::block_index_(size_t age) const {
+  const size_t count = this->blocks_.size();
+  return (this->head_ + count + 1 - this->used_ + age) % count;
+}
+
+void TimeSeriesBuffer::start_block_(uint32_t timestamp, float value) {
+  if (this->used_ != 0)
+    this->head_ = (this->head_ + 1) % this->blocks_.size();
+  if (this->used_ < this->blocks_.size())
+    this->used_++;
+
+  memset(this->block_data_(this->head_), 0, BLOCK_SIZE);
+  this->blocks_[this->head_] = Block{timestamp, timestamp, 1, 0};
+  const uint32_t bits = float_bits(value);
+  this->write_bits_(timestamp, 32);
+  this->write_bits_(bits, 32);
+  this->cursor_ = Cursor{timestamp, 0, bits, NO_WINDOW, 0};
+}
+
+void TimeSeriesBuffer::write_bits_(uint64_t value, uint8_t bits) {
+  Block &block = this->blocks_[this->head_];
+  uint8_t *data = this->block_data_(this->head_);
+  for (int i = bits - 1; i >= 0; i--, block.bits++) {
+    if ((value >> i) & 1)
+      data[block.bits >> 3] |= 0x80 >> (block.bits & 7);
+  }
+}
+
+void TimeSeriesBuffer::decode_block_(size_t index, uint32_t from, uint32_t to,
+                                     const std::function<void(uint32_t, float)> &callback) const {
+  const Block &block = this->blocks_[index];
+  const uint8_t *data = this->block_data_(index);
+  uint16_t pos = 0;
+
+  Cursor cursor{};
+  cursor.timestamp = read_bits(data, pos, 32);
+  cursor.value = read_bits(data, pos, 32);
+  cursor.leading = NO_WINDOW;
+  if (cursor.timestamp >= from && cursor.timestamp <= to)
+    callback(cursor.timestamp, bits_float(cursor.value));
+
+  for (uint16_t i = 1; i < block.count; i++) {
+    int64_t delta;
+    if (read_bits(data, pos, 1) == 0) {
+      delta = cursor.delta;
+    } else if (read_bits(data, pos, 1) == 0) {
+      delta = cursor.delta + int64_t(read_bits(data, pos, 7)) - 63;
+    } else if (read_bits(data, pos, 1) == 0) {
+      delta = cursor.delta + int64_t(read_bits(data, pos, 9)) - 255;
+    } else if (read_bits(data, pos, 1) == 0) {
+      delta = cursor.delta + int64_t(read_bits(data, pos, 12)) - 2047;
+    } else {
+      delta = read_bits(data, pos, 32);
+    }
+    cursor.timestamp += delta;
+    cursor.delta = delta;
+
+    if (read_bits(data, pos, 1) == 1) {
+      if (read_bits(data, pos, 1) == 1) {
+        cursor.leading = read_bits(data, pos, 5);
+        const uint8_t length = read_bits(data, pos, 5) + 1;
+        cursor.trailing = 32 - cursor.leading - length;
+      }
+      const uint8_t length = 32 - cursor.leading - cursor.trailing;
+      cursor.value ^= uint32_t(read_bits(data, pos, length)) << cursor.trailing;
+    }
+
+    if (cursor.timestamp > to)
+      return;
+    if (cursor.timestamp >= from)
+      callback(cursor.timestamp, bits_float(cursor.value));
+  }
+}
+
+}  // namespace history
+}  // namespace esphome
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "esphome/core/optional.h"
+
+namespace esphome {
+namespace history {
+
+/** A compressed time series of (timestamp, float) samples in a fixed memory budget.
+ *
+ * Samples are encoded like Facebook's Gorilla: timestamps as delta-of-delta, values as the XOR with the previous
+ * value, which takes a single bit for a repeated timestamp interval or value. The memory is split into blocks of
+ * BLOCK_SIZE bytes, each starting with a raw sample so it can be decoded on its own. Once all blocks are used, the
+ * oldest block is dropped.
+ *
+ * Timestamps are in seconds and must not decrease.
+ */
+class TimeSeriesBuffer {
+ public:
+  static const size_t BLOCK_SIZE = 256;
+
+  /** Allocate the buffer.
+   *
+   * @param size Memory budget in bytes, rounded down to whole blocks (at least one).
+   * @param psram Whether to allocate the blocks in external RAM, if available.
+   * @return Whether the allocation succeeded.
+   */
+  bool init(size_t size, bool psram);
+
+  void append(uint32_t timestamp, float value);
+
+  /// Call callback for every sample with from <= timestamp <= to, oldest first.
+  void read(uint32_t from, uint32_t to, const std::function<void(uint32_t, float)> &callback) const;
+
+  /// Timestamp of the oldest sample still stored.
+  optional<uint32_t> oldest() const;
+  /// Number of samples stored.
+  size_t count() const;
+  /// Number of bytes allocated for samples.
+  size_t capacity() const { return this->blocks_.size() * BLOCK_SIZE; }
+  /// Number of bytes used by encoded samples.
+  size_t used() const;
+
+ protected:
+  struct Block {
+    uint32_t first;  ///< Timestamp of the first sample.
+    uint32_t last;   ///< Timestamp of the last sample.
+    uint16_t count;  ///< Number of samples.
+    uint16_t bits;   ///< Number of bits written.
+  };
+
+  /// Encoder/decoder state carried from one sample to the next within a block.
+  struct Cursor {
+    uint32_t timestamp;
+    int64_t delta;
+    uint32_t value;
+    uint8_t leading;
+    uint8_t trailing;
+  };
+
+  uint8_t *block_data_(size_t index) const { return this->data_ + index * BLOCK_SIZE; }
+  size_t block_index_(size_t age) const;
+  void start_block_(uint32_t timestamp, float value);
+  void write_bits_(uint64_t value, uint8_t bits);
+  void decode_block_(size_t index, uint32_t from, uint32_t to,
+                     const std::function<void(uint32_t, float)> &callback) const;
+
+  uint8_t *data_{nullptr};
+  std::vector<Block> blocks_;
+  size_t head_{0};  ///< Block currently written to.
+  size_t used_{0};  ///< Number of blocks holding samples.
+  Cursor cursor_{};
+};
+
+}  // namespace history
+}  // namespace esphome
@@ -2,10 +2,21 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace esphome {
 namespace hx711 {
 
 static const char *const TAG = "hx711";
+/// Pulses clocked per loop() in continuous mode, a conversion takes three to four loops.
+static const uint8_t PULSES_PER_LOOP = 8;
+
+static int32_t sign_extend(uint32_t data) {
+  if (data & 0x800000ULL)
+    data |= 0xFF000000ULL;
+  return static_cast<int32_t>(data);
+}
 
 void HX711Sensor::setup() {
   ESP_LOGCONFIG(TAG, "Setting up HX711 '%s'...", this->name_.c_str());
@@ -13,61 +24,137 @@ void HX711Sensor::setup() {
   this->dout_pin_->setup();
   this->sck_pin_->digital_write(false);
 
+  this->setup_acquisition_();
+}
+
+void HX711Sensor::setup_acquisition_() {
+  this->window_.resize(this->samples_);
+  if (this->continuous_)
+    this->high_freq_.start();
+
   // Read sensor once without publishing to set the gain
   this->read_sensor_(nullptr);
 }
 
+void HX711Sensor::loop() {
+  if (!this->continuous_)
+    return;
+  // DOUT only signals a ready conversion before its first pulse, then it carries the bits
+  if (this->read_pulses_ == 0 && !this->is_ready_())
+    return;
+  uint32_t data;
+  if (this->read_step_(&data))
+    this->add_sample_(sign_extend(data));
+}
+
 void HX711Sensor::dump_config() {
   LOG_SENSOR("", "HX711", this);
   LOG_PIN("  DOUT Pin: ", this->dout_pin_);
   LOG_PIN("  SCK Pin: ", this->sck_pin_);
+  ESP_LOGCONFIG(TAG, "  Continuous: %s", YESNO(this->continuous_));
+  ESP_LOGCONFIG(TAG, "  Samples: %u", this->samples_);
+  if (this->zero_tracking_ != 0)
+    ESP_LOGCONFIG(TAG, "  Zero Tracking: %" PRIu32, this->zero_tracking_);
   LOG_UPDATE_INTERVAL(this);
 }
 float HX711Sensor::get_setup_priority() const { return setup_priority::DATA; }
 void HX711Sensor::update() {
-  uint32_t result;
-  if (this->read_sensor_(&result)) {
-    int32_t value = static_cast<int32_t>(result);
-    ESP_LOGD(TAG, "'%s': Got value %" PRId32, this->name_.c_str(), value);
-    this->publish_state(value);
+  if (!this->continuous_) {
+    uint32_t result;
+    if (!this->read_sensor_(&result))
+      return;
+    this->add_sample_(static_cast<int32_t>(result));
+  }
+  if (this->new_samples_ == 0) {
+    ESP_LOGW(TAG, "'%s': No new samples since the last update", this->name_.c_str());
+    this->status_set_warning();
+    return;
+  }
+  this->status_clear_warning();
+  this->new_samples_ = 0;
+
+  int32_t value = static_cast<int32_t>(this->window_sum_ / static_cast<int64_t>(this->window_count_)) - this->tare_;
+  if (this->zero_tracking_ != 0 && this->tare_remaining_ == 0 &&
+      static_cast<uint32_t>(std::abs(value)) <= this->zero_tracking_) {
+    // Follow slow drift of an empty scale
+    this->tare_ += value / 4;
+  }
+  ESP_LOGD(TAG, "'%s': Got value %" PRId32, this->name_.c_str(), value);
+  this->publish_state(value);
+}
+void HX711Sensor::tare() {
+  this->tare_remaining_ = this->samples_;
+  this->tare_sum_ = 0;
+}
+void HX711Sensor::add_sample_(int32_t value) {
+  if (this->tare_remaining_ != 0) {
+    this->tare_sum_ += value;
+    if (--this->tare_remaining_ == 0) {
+      this->tare_ = static_cast<int32_t>(this->tare_sum_ / this->samples_);
+      ESP_LOGD(TAG, "'%s': Tare %" PRId32, this->name_.c_str(), this->tare_);
+    }
+  }
+
+  if (this->window_count_ == this->window_.size()) {
+    this->window_sum_ -= this->window_[this->window_index_];
+  } else {
+    this->window_count_++;
   }
+  this->window_[this->window_index_] = value;
+  this->window_sum_ += value;
+  this->window_index_ = (this->window_index_ + 1) % this->window_.size();
+  this->new_samples_++;
 }
 bool HX711Sensor::read_sensor_(uint32_t *result) {
-  if (this->dout_pin_->digital_read()) {
+  if (!this->is_ready_()) {
     ESP_LOGW(TAG, "HX711 is not ready for new measurements yet!");
     this->status_set_warning();
     return false;
   }
 
   this->status_clear_warning();
+  const int32_t data = sign_extend(this->read_bits_());
+  if (result != nullptr)
+    *result = static_cast<uint32_t>(data);
+  return true;
+}
+uint32_t HX711Sensor::read_bits_() {
   uint32_t data = 0;
-
+  for (uint8_t i = 0; i < 24; i++)
+    data |= uint32_t(this->clock_pulse_()) << (23 - i);
+  // Cycle clock pin for gain setting
+  for (uint8_t i = 0; i < this->gain_; i++)
+    this->clock_pulse_();
+  return data;
+}
+bool HX711Sensor::read_step_(uint32_t *data) {
+  // The HX711 waits with the clock low for as long as it takes, only a high clock has a time limit
+  const uint8_t pulses = 24 + this->gain_;
+  const uint8_t end = std::min<uint8_t>(this->read_pulses_ + PULSES_PER_LOOP, pulses);
+  for (; this->read_pulses_ < end; this->read_pulses_++) {
+    const bool bit = this->clock_pulse_();
+    if (this->read_pulses_ < 24)
+      this->read_data_ |= uint32_t(bit) << (23 - this->read_pulses_);
+  }
+  if (this->read_pulses_ < pulses)
+    return false;
+  *data = this->read_data_;
+  this->read_pulses_ = 0;
+  this->read_data_ = 0;
+  return true;
+}
+bool HX711Sensor::clock_pulse_() {
+  bool bit;
   {
+    // SCK high for more than 60 µs powers the HX711 down, so no interrupt may stretch the pulse
     InterruptLock lock;
-    for (uint8_t i = 0; i < 24; i++) {
-      this->sck_pin_->digital_write(true);
-      delayMicroseconds(1);
-      data |= uint32_t(this->dout_pin_->digital_read()) << (23 - i);
-      this->sck_pin_->digital_write(false);
-      delayMicroseconds(1);
-    }
-
-    // Cycle clock pin for gain setting
-    for (uint8_t i = 0; i < this->gain_; i++) {
-      this->sck_pin_->digital_write(true);
-      delayMicroseconds(1);
-      this->sck_pin_->digital_write(false);
-      delayMicroseconds(1);
-    }
+    this->sck_pin_->digital_write(true);
+    delayMicroseconds(1);
+    bit = this->dout_pin_->digital_read();
+    this->sck_pin_->digital_write(false);
   }
-
-  if (data & 0x800000ULL) {
-    data |= 0xFF000000ULL;
-  }
-
-  if (result != nullptr)
-    *result = data;
-  return true;
+  delayMicroseconds(1);
+  return bit;
 }
 
 }  // namespace hx711
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/sensor/sensor.h"
 
 #include <cinttypes>
+#include <vector>
 
 namespace esphome {
 namespace hx711 {
@@ -20,18 +23,67 @@ class HX711Sensor : public sensor::Sensor, public PollingComponent {
   void set_dout_pin(GPIOPin *dout_pin) { dout_pin_ = dout_pin; }
   void set_sck_pin(GPIOPin *sck_pin) { sck_pin_ = sck_pin; }
   void set_gain(HX711Gain gain) { gain_ = gain; }
+  /// Read every conversion from loop() instead of a single one per update.
+  void set_continuous(bool continuous) { continuous_ = continuous; }
+  /// Publish the average of the last samples.
+  void set_samples(uint16_t samples) { samples_ = samples; }
+  /// Let the tare follow readings within this many counts of zero.
+  void set_zero_tracking(uint32_t zero_tracking) { zero_tracking_ = zero_tracking; }
+
+  /// Zero the published value on the average of the next samples.
+  void tare();
+  int32_t get_tare() const { return this->tare_; }
 
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override;
   void update() override;
 
  protected:
+  /// Allocate the sample window and set the gain with a first conversion.
+  void setup_acquisition_();
+  /// DOUT goes low once a conversion is ready.
+  virtual bool is_ready_() { return !this->dout_pin_->digital_read(); }
+  /// Clock out the 24 bits of a ready conversion followed by the gain pulses.
+  virtual uint32_t read_bits_();
+  /** Clock out the next few bits of a ready conversion, so that loop() only blocks for microseconds at a time.
+   *
+   * @return true once the conversion is complete in data
+   */
+  virtual bool read_step_(uint32_t *data);
+  /// A single SCK pulse, returns DOUT sampled while the clock is high.
+  bool clock_pulse_();
   bool read_sensor_(uint32_t *result);
+  void add_sample_(int32_t value);
 
-  GPIOPin *dout_pin_;
-  GPIOPin *sck_pin_;
+  GPIOPin *dout_pin_{nullptr};
+  GPIOPin *sck_pin_{nullptr};
   HX711Gain gain_{HX711_GAIN_128};
+  bool continuous_{false};
+  HighFrequencyLoopRequester high_freq_;
+  /// Pulses clocked of the conversion read by read_step_(), and its bits so far.
+  uint8_t read_pulses_{0};
+  uint32_t read_data_{0};
+
+  uint16_t samples_{1};
+  /// Ring buffer of the last samples and their sum.
+  std::vector<int32_t> window_;
+  size_t window_index_{0};
+  size_t window_count_{0};
+  int64_t window_sum_{0};
+  /// Samples added since the last publish.
+  uint32_t new_samples_{0};
+
+  int32_t tare_{0};
+  uint16_t tare_remaining_{0};
+  int64_t tare_sum_{0};
+  uint32_t zero_tracking_{0};
+};
+
+template<typename... Ts> class TareAction : public Action<Ts...>, public Parented<HX711Sensor> {
+ public:
+  void play(Ts... x) override { this->parent_->tare(); }
 };
 
 }  // namespace hx711
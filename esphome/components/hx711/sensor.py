@@ -1,18 +1,24 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome import pins
+from esphome import automation, pins
+from esphome.automation import maybe_simple_id
 from esphome.components import sensor
 from esphome.const import (
     CONF_CLK_PIN,
     CONF_GAIN,
+    CONF_ID,
     ICON_SCALE,
     STATE_CLASS_MEASUREMENT,
 )
 
 hx711_ns = cg.esphome_ns.namespace("hx711")
 HX711Sensor = hx711_ns.class_("HX711Sensor", sensor.Sensor, cg.PollingComponent)
+TareAction = hx711_ns.class_("TareAction", automation.Action)
 
+CONF_CONTINUOUS = "continuous"
 CONF_DOUT_PIN = "dout_pin"
+CONF_SAMPLES = "samples"
+CONF_ZERO_TRACKING = "zero_tracking"
 
 HX711Gain = hx711_ns.enum("HX711Gain")
 GAINS = {
@@ -21,7 +27,7 @@ GAINS = {
     64: HX711Gain.HX711_GAIN_64,
 }
 
-CONFIG_SCHEMA = (
+CONFIG_SCHEMA_BASE = (
     sensor.sensor_schema(
         HX711Sensor,
         icon=ICON_SCALE,
@@ -30,21 +36,54 @@ CONFIG_SCHEMA = (
     )
     .extend(
         {
-            cv.Required(CONF_DOUT_PIN): pins.gpio_input_pin_schema,
-            cv.Required(CONF_CLK_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_GAIN, default=128): cv.enum(GAINS, int=True),
+            cv.Optional(CONF_CONTINUOUS, default=False): cv.boolean,
+            cv.Optional(CONF_SAMPLES, default=1): cv.int_range(min=1, max=1024),
+            cv.Optional(CONF_ZERO_TRACKING): cv.positive_not_null_int,
         }
     )
     .extend(cv.polling_component_schema("60s"))
 )
 
+CONFIG_SCHEMA = CONFIG_SCHEMA_BASE.extend(
+    {
+        cv.Required(CONF_DOUT_PIN): pins.gpio_input_pin_schema,
+        cv.Required(CONF_CLK_PIN): pins.gpio_output_pin_schema,
+    }
+)
 
-async def to_code(config):
+
+async def to_code_base(config):
     var = await sensor.new_sensor(config)
     await cg.register_component(var, config)
 
+    cg.add(var.set_gain(config[CONF_GAIN]))
+    cg.add(var.set_continuous(config[CONF_CONTINUOUS]))
+    cg.add(var.set_samples(config[CONF_SAMPLES]))
+    if CONF_ZERO_TRACKING in config:
+        cg.add(var.set_zero_tracking(config[CONF_ZERO_TRACKING]))
+    return var
+
+
+async def to_code(config):
+    var = await to_code_base(config)
+
     dout_pin = await cg.gpio_pin_expression(config[CONF_DOUT_PIN])
     cg.add(var.set_dout_pin(dout_pin))
     sck_pin = await cg.gpio_pin_expression(config[CONF_CLK_PIN])
     cg.add(var.set_sck_pin(sck_pin))
-    cg.add(var.set_gain(config[CONF_GAIN]))
+
+
+@automation.register_action(
+    "hx711.tare",
+    TareAction,
+    maybe_simple_id(
+        {
+            cv.Required(CONF_ID): cv.use_id(HX711Sensor),
+        }
+    ),
+)
+async def tare_action_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
@@ -0,0 +1,50 @@
+#include "hx711_spi.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace hx711_spi {
+
+static const char *const TAG = "hx711_spi";
+
+/// 24 data pulses at four per byte, and the gain pulses.
+static const size_t READ_LENGTH = 7;
+/// Gain pulses in the last byte, by HX711Gain.
+static const uint8_t GAIN_PULSES[] = {0x00, 0x80, 0xA0, 0xA8};
+
+void HX711SPISensor::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up HX711 '%s'...", this->name_.c_str());
+  this->spi_setup();
+  this->setup_acquisition_();
+}
+
+void HX711SPISensor::dump_config() {
+  HX711Sensor::dump_config();
+  LOG_PIN("  CS Pin: ", this->cs_);
+}
+
+bool HX711SPISensor::is_ready_() {
+  // MOSI stays low, so this only samples DOUT without clocking the HX711
+  uint8_t level = 0x00;
+  this->enable();
+  this->transfer_array(&level, 1);
+  this->disable();
+  return level == 0x00;
+}
+
+uint32_t HX711SPISensor::read_bits_() {
+  uint8_t buffer[READ_LENGTH] = {0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, GAIN_PULSES[this->gain_]};
+  this->enable();
+  this->transfer_array(buffer, READ_LENGTH);
+  this->disable();
+
+  uint32_t data = 0;
+  for (uint8_t i = 0; i < 24; i++) {
+    // DOUT settles after the rising edge, so take the bit sampled with the clock low again
+    const uint8_t bit = (buffer[i / 4] >> (6 - 2 * (i % 4))) & 1;
+    data |= uint32_t(bit) << (23 - i);
+  }
+  return data;
+}
+
+}  // namespace hx711_spi
+}  // namespace esphome
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "esphome/components/hx711/hx711.h"
+#include "esphome/components/spi/spi.h"
+
+namespace esphome {
+namespace hx711_spi {
+
+/** HX711 clocked by the SPI peripheral, with PD_SCK on MOSI and DOUT on MISO.
+ *
+ * Every SPI bit is half a clock period, so a 0xAA byte sends four clock pulses and the data bits are read from MISO
+ * in the low halves. Nothing else may use the bus, as its traffic on MOSI would clock the HX711.
+ */
+class HX711SPISensor : public hx711::HX711Sensor,
+                       public spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW,
+                                             spi::CLOCK_PHASE_LEADING, spi::DATA_RATE_1MHZ> {
+ public:
+  void setup() override;
+  void dump_config() override;
+
+ protected:
+  bool is_ready_() override;
+  uint32_t read_bits_() override;
+  /// A single transfer without delays or interrupt lock, there is nothing to split.
+  bool read_step_(uint32_t *data) override {
+    *data = this->read_bits_();
+    return true;
+  }
+};
+
+}  // namespace hx711_spi
+}  // namespace esphome
@@ -0,0 +1,24 @@
+import esphome.codegen as cg
+from esphome.components import spi
+from esphome.components.hx711.sensor import (
+    CONFIG_SCHEMA_BASE,
+    HX711Sensor,
+    to_code_base,
+    cv,
+)
+
+DEPENDENCIES = ["spi"]
+AUTO_LOAD = ["hx711"]
+
+hx711_spi_ns = cg.esphome_ns.namespace("hx711_spi")
+HX711SPISensor = hx711_spi_ns.class_("HX711SPISensor", HX711Sensor, spi.SPIDevice)
+
+# PD_SCK goes to MOSI and DOUT to MISO, the bus clock pin stays unconnected
+CONFIG_SCHEMA = CONFIG_SCHEMA_BASE.extend(
+    spi.spi_device_schema(cs_pin_required=False)
+).extend({cv.GenerateID(): cv.declare_id(HX711SPISensor)})
+
+
+async def to_code(config):
+    var = await to_code_base(config)
+    await spi.register_spi_device(var, config)
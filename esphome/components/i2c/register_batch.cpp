@@ -0,0 +1,98 @@
+#include "register_batch.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace i2c {
+
+/// Bytes of a single transfer including the register address, within the smallest buffer of the I2C backends.
+static const size_t MAX_TRANSFER_SIZE = 32;
+/// Start, address, register and stop of another transfer cost about as much as this many data bytes.
+static const size_t TRANSFER_OVERHEAD = 3;
+static const uint32_t STATS_INTERVAL = 60000;
+
+RegisterBatch::RegisterBatch(uint8_t first_register, uint16_t count, uint8_t register_size)
+    : first_register_(first_register),
+      count_(count),
+      register_size_(register_size),
+      values_(count * register_size),
+      states_(count, REGISTER_UNKNOWN) {}
+
+void RegisterBatch::set(uint16_t index, const uint8_t *value) {
+  uint8_t *current = &this->values_[index * this->register_size_];
+  RegisterState &state = this->states_[index];
+  if (state != REGISTER_UNKNOWN && memcmp(current, value, this->register_size_) == 0)
+    return;
+  memcpy(current, value, this->register_size_);
+  if (state != REGISTER_DIRTY)
+    this->dirty_count_++;
+  state = REGISTER_DIRTY;
+}
+
+void RegisterBatch::mark_all_dirty() {
+  for (auto &state : this->states_) {
+    if (state == REGISTER_CLEAN) {
+      state = REGISTER_DIRTY;
+      this->dirty_count_++;
+    }
+  }
+}
+
+ErrorCode RegisterBatch::flush(I2CDevice *device) {
+  const size_t max_registers = std::max<size_t>((MAX_TRANSFER_SIZE - 1) / this->register_size_, 1);
+  uint16_t start = 0;
+  while (this->dirty_count_ != 0 && start < this->count_) {
+    if (this->states_[start] != REGISTER_DIRTY) {
+      start++;
+      continue;
+    }
+    // Extend the run over further dirty registers, bridging gaps of known ones that are cheaper to resend
+    uint16_t end = start + 1;
+    for (uint16_t next = end; next < this->count_ && size_t(next - start) < max_registers; next++) {
+      if (this->states_[next] == REGISTER_DIRTY) {
+        end = next + 1;
+      } else if (this->states_[next] == REGISTER_UNKNOWN ||
+                 size_t(next + 1 - end) * this->register_size_ > TRANSFER_OVERHEAD) {
+        break;
+      }
+    }
+
+    const size_t length = size_t(end - start) * this->register_size_;
+    const ErrorCode err = device->write_register(this->first_register_ + start * this->register_size_,
+                                                 &this->values_[start * this->register_size_], length);
+    if (err != ERROR_OK)
+      return err;
+    this->stats_bytes_ += length + 2;
+    this->stats_transfers_++;
+
+    for (uint16_t i = start; i < end; i++) {
+      if (this->states_[i] == REGISTER_DIRTY) {
+        this->states_[i] = REGISTER_CLEAN;
+        this->dirty_count_--;
+      }
+    }
+    start = end;
+  }
+  return ERROR_OK;
+}
+
+void RegisterBatch::log_stats(const char *tag) {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->stats_start_;
+  if (elapsed < STATS_INTERVAL)
+    return;
+  if (this->stats_transfers_ != 0) {
+    const float seconds = elapsed / 1000.0f;
+    ESP_LOGD(tag, "I2C writes: %.1f transfers/s, %.0f bytes/s", this->stats_transfers_ / seconds,
+             this->stats_bytes_ / seconds);
+  }
+  this->stats_bytes_ = 0;
+  this->stats_transfers_ = 0;
+  this->stats_start_ = now;
+}
+
+}  // namespace i2c
+}  // namespace esphome
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "i2c.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace i2c {
+
+/// @brief Shadow copy of a block of equally sized registers, written back in as few transfers as possible.
+/// @details Setting a register only marks it dirty when its value changed. flush() then writes each run of dirty
+/// registers with a single auto-increment transfer, and sends along short gaps of registers written before where
+/// that is cheaper than starting another transfer. Output drivers set all their channels while the lights compute a
+/// frame and flush once from their loop(), so the bus sees one burst per frame however many channels changed.
+class RegisterBatch {
+ public:
+  /// @param first_register address of the first register of the block
+  /// @param count number of registers
+  /// @param register_size bytes per register, the address of register n is first_register + n * register_size
+  RegisterBatch(uint8_t first_register, uint16_t count, uint8_t register_size = 1);
+
+  /// @brief Set the bytes of register index, only marked dirty if they changed
+  void set(uint16_t index, const uint8_t *value);
+  void set(uint16_t index, uint8_t value) { this->set(index, &value); }
+  /// @brief Write all registers set so far again, e.g. after a reset of the device
+  void mark_all_dirty();
+  bool is_dirty() const { return this->dirty_count_ != 0; }
+
+  /// @brief Write the dirty registers, registers that failed stay dirty for the next flush
+  ErrorCode flush(I2CDevice *device);
+
+  /// @brief Log the bus bytes and transfers per second of the flushes, at most every minute
+  void log_stats(const char *tag);
+
+ protected:
+  enum RegisterState : uint8_t {
+    REGISTER_UNKNOWN = 0,
+    REGISTER_CLEAN,
+    REGISTER_DIRTY,
+  };
+
+  uint8_t first_register_;
+  uint16_t count_;
+  uint8_t register_size_;
+  std::vector<uint8_t> values_;
+  std::vector<RegisterState> states_;
+  uint16_t dirty_count_{0};
+
+  uint32_t stats_bytes_{0};
+  uint32_t stats_transfers_{0};
+  uint32_t stats_start_{0};
+};
+
+}  // namespace i2c
+}  // namespace esphome
@@ -41,13 +41,29 @@ void ILI9XXXDisplay::setup() {
 
   if (this->buffer_color_mode_ == BITS_16) {
     this->init_internal_(this->get_buffer_length_() * 2);
-    if (this->buffer_ != nullptr) {
-      return;
+    if (this->buffer_ == nullptr) {
+      this->buffer_color_mode_ = BITS_8;
     }
-    this->buffer_color_mode_ = BITS_8;
   }
-  this->init_internal_(this->get_buffer_length_());
   if (this->buffer_ == nullptr) {
+    this->init_internal_(this->get_buffer_length_());
+    if (this->buffer_ == nullptr) {
+      this->mark_failed();
+      return;
+    }
+  }
+  if (!this->needs_conversion_()) {
+    return;
+  }
+
+  if (this->buffer_color_mode_ == BITS_8_INDEXED) {
+    this->converter_.set_palette888(this->palette_);
+  } else if (this->buffer_color_mode_ == BITS_8) {
+    this->converter_.set_rgb332();
+  }
+  this->transfer_buffer_ = display::allocate_transfer_buffer(ILI9XXX_TRANSFER_BUFFER_SIZE);
+  if (this->transfer_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate transfer buffer!");
     this->mark_failed();
   }
 }
@@ -184,16 +200,17 @@ void ILI9XXXDisplay::update() {
     return;
   }
   this->prossing_update_ = true;
+  bool rendered = false;
   do {
     this->need_update_ = false;
-    this->do_update_();
+    rendered |= this->do_update_();
   } while (this->need_update_);
   this->prossing_update_ = false;
-  this->display_();
+  if (rendered)
+    this->display_();
 }
 
 void ILI9XXXDisplay::display_() {
-  uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
   // check if something was displayed
   if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
     ESP_LOGV(TAG, "Nothing to display");
@@ -221,50 +238,40 @@ void ILI9XXXDisplay::display_() {
     ESP_LOGV(TAG, "Doing single write of %d bytes", this->width_ * h * 2);
     set_addr_window_(0, this->y_low_, this->width_ - 1, this->y_high_);
     this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
+  } else if (!this->needs_conversion_()) {
+    ESP_LOGV(TAG, "Doing multiple write");
+    set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
+    // the rows are already in display format, send them straight from the buffer
+    for (size_t y = this->y_low_; y <= this->y_high_; y++) {
+      this->write_array(this->buffer_ + (y * this->width_ + this->x_low_) * 2, w * 2);
+      App.feed_wdt();
+    }
   } else {
     ESP_LOGV(TAG, "Doing multiple write");
-    size_t rem = h * w;  // remaining number of pixels to write
     set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
-    size_t idx = 0;    // index into transfer_buffer
-    size_t pixel = 0;  // pixel number offset
-    size_t pos = this->y_low_ * this->width_ + this->x_low_;
-    while (rem-- != 0) {
-      uint16_t color_val;
-      switch (this->buffer_color_mode_) {
-        case BITS_8:
-          color_val = display::ColorUtil::color_to_565(display::ColorUtil::rgb332_to_color(this->buffer_[pos++]));
-          break;
-        case BITS_8_INDEXED:
-          color_val = display::ColorUtil::color_to_565(
-              display::ColorUtil::index8_to_color_palette888(this->buffer_[pos++], this->palette_));
-          break;
-        default:  // case BITS_16:
-          color_val = (buffer_[pos * 2] << 8) + buffer_[pos * 2 + 1];
-          pos++;
-          break;
-      }
-      if (this->is_18bitdisplay_) {
-        transfer_buffer[idx++] = (uint8_t) ((color_val & 0xF800) >> 8);  // Blue
-        transfer_buffer[idx++] = (uint8_t) ((color_val & 0x7E0) >> 3);   // Green
-        transfer_buffer[idx++] = (uint8_t) (color_val << 3);             // Red
-      } else {
-        put16_be(transfer_buffer + idx, color_val);
-        idx += 2;
-      }
-      if (idx == ILI9XXX_TRANSFER_BUFFER_SIZE) {
-        this->write_array(transfer_buffer, idx);
-        idx = 0;
-        App.feed_wdt();
-      }
-      // end of line? Skip to the next.
-      if (++pixel == w) {
-        pixel = 0;
-        pos += this->width_ - w;
+    size_t const src_bytes = this->buffer_color_mode_ == BITS_16 ? 2 : 1;
+    size_t const dst_bytes = this->is_18bitdisplay_ ? 3 : 2;
+    size_t idx = 0;  // bytes in transfer_buffer_
+    for (size_t y = this->y_low_; y <= this->y_high_; y++) {
+      const uint8_t *src = this->buffer_ + (y * this->width_ + this->x_low_) * src_bytes;
+      size_t rem = w;  // remaining number of pixels in this row
+      while (rem != 0) {
+        size_t count = std::min(rem, (ILI9XXX_TRANSFER_BUFFER_SIZE - idx) / dst_bytes);
+        if (count == 0) {
+          this->write_array(this->transfer_buffer_, idx);
+          idx = 0;
+          App.feed_wdt();
+          continue;
+        }
+        this->convert_pixels_(src, this->transfer_buffer_ + idx, count);
+        src += count * src_bytes;
+        idx += count * dst_bytes;
+        rem -= count;
       }
     }
     // flush any balance.
     if (idx != 0) {
-      this->write_array(transfer_buffer, idx);
+      this->write_array(this->transfer_buffer_, idx);
     }
   }
   this->disable();
@@ -276,6 +283,18 @@ void ILI9XXXDisplay::display_() {
   this->y_high_ = 0;
 }
 
+void HOT ILI9XXXDisplay::convert_pixels_(const uint8_t *src, uint8_t *dst, size_t count) {
+  if (this->buffer_color_mode_ != BITS_16) {
+    if (this->is_18bitdisplay_) {
+      this->converter_.convert_to_666(src, dst, count);
+    } else {
+      this->converter_.convert_to_565(src, dst, count);
+    }
+  } else {
+    display::PixelConverter::convert_565_to_666(src, dst, count);
+  }
+}
+
 // note that this bypasses the buffer and writes directly to the display.
 void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr,
                                     display::ColorOrder order, display::ColorBitness bitness, bool big_endian,
@@ -1,6 +1,7 @@
 #pragma once
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display/display_color_convert.h"
 #include "esphome/components/display/display_color_utils.h"
 #include "ili9xxx_defines.h"
 #include "ili9xxx_init.h"
@@ -8,7 +9,11 @@
 namespace esphome {
 namespace ili9xxx {
 
-const size_t ILI9XXX_TRANSFER_BUFFER_SIZE = 126;  // ensure this is divisible by 6
+#ifdef USE_ESP8266
+const size_t ILI9XXX_TRANSFER_BUFFER_SIZE = 1020;  // keep the heap use small, still divisible by 6
+#else
+const size_t ILI9XXX_TRANSFER_BUFFER_SIZE = 4092;  // same as the largest SPI transfer
+#endif
 
 enum ILI9XXXColorMode {
   BITS_8 = 0x08,
@@ -93,6 +98,10 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   void setup_pins_();
 
   void display_();
+  /// Whether the buffer differs from the format of the display, only then rows go through the transfer buffer.
+  bool needs_conversion_() const { return this->buffer_color_mode_ != BITS_16 || this->is_18bitdisplay_; }
+  /// Convert count pixels of the buffer to the format of the display.
+  void convert_pixels_(const uint8_t *src, uint8_t *dst, size_t count);
   void init_lcd_();
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t x2, uint16_t y2);
   void reset_();
@@ -107,6 +116,9 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   uint16_t x_high_{0};
   uint16_t y_high_{0};
   const uint8_t *palette_;
+  display::PixelConverter converter_;
+  /// Rows are converted into this buffer before they are sent.
+  uint8_t *transfer_buffer_{nullptr};
 
   ILI9XXXColorMode buffer_color_mode_{BITS_16};
 
@@ -140,7 +140,8 @@ size_t Inkplate6::get_buffer_length_() {
 }
 
 void Inkplate6::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
 
   if (this->full_update_every_ > 0 && this->partial_updates_ >= this->full_update_every_) {
     this->block_partial_ = true;
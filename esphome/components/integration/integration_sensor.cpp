@@ -3,6 +3,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace integration {
 
@@ -11,9 +13,10 @@ static const char *const TAG = "integration";
 void IntegrationSensor::setup() {
   if (this->restore_) {
     this->pref_ = global_preferences->make_preference<float>(this->get_object_id_hash());
+    // A warm start already restored the exact result
     float preference_value = 0;
-    this->pref_.load(&preference_value);
-    this->result_ = preference_value;
+    if (!this->is_warm_start() && this->pref_.load(&preference_value))
+      this->result_ = preference_value;
   }
 
   this->last_update_ = millis();
@@ -47,5 +50,19 @@ void IntegrationSensor::process_sensor_value_(float value) {
   this->publish_and_save_(this->result_ + area);
 }
 
+#ifdef USE_WARM_STATE
+void IntegrationSensor::save_warm_state(uint8_t *data) {
+  WarmState state{this->result_, this->last_value_};
+  memcpy(data, &state, sizeof(state));
+}
+bool IntegrationSensor::restore_warm_state(const uint8_t *data) {
+  WarmState state{};
+  memcpy(&state, data, sizeof(state));
+  this->result_ = state.result;
+  this->last_value_ = state.last_value;
+  return true;
+}
+#endif
+
 }  // namespace integration
 }  // namespace esphome
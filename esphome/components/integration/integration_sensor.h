@@ -34,7 +34,18 @@ class IntegrationSensor : public sensor::Sensor, public Component {
   void set_restore(bool restore) { restore_ = restore; }
   void reset() { this->publish_and_save_(0.0f); }
 
+#ifdef USE_WARM_STATE
+  size_t get_warm_state_size() const override { return sizeof(WarmState); }
+  void save_warm_state(uint8_t *data) override;
+  bool restore_warm_state(const uint8_t *data) override;
+#endif
+
  protected:
+  struct WarmState {
+    double result;
+    float last_value;
+  };
+
   void process_sensor_value_(float value);
   float get_time_factor_() {
     switch (this->time_) {
@@ -1,7 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
-from esphome.components import sensor
+from esphome.components import sensor, warm_state
 from esphome.const import (
     CONF_ICON,
     CONF_ID,
@@ -99,6 +99,7 @@ async def to_code(config):
     cg.add(var.set_time(config[CONF_TIME_UNIT]))
     cg.add(var.set_method(config[CONF_INTEGRATION_METHOD]))
     cg.add(var.set_restore(config[CONF_RESTORE]))
+    await warm_state.register_warm_state(var, config)
 
 
 @automation.register_action(
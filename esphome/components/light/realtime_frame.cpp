@@ -0,0 +1,37 @@
+#include "realtime_frame.h"
+#include "addressable_light.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace light {
+
+void RealtimeFrame::resize(size_t size) {
+  this->staging_.assign(size, Color::BLACK);
+  this->complete_.assign(size, Color::BLACK);
+  this->pending_ = false;
+}
+
+void RealtimeFrame::fill(const Color &color) { std::fill(this->staging_.begin(), this->staging_.end(), color); }
+
+void RealtimeFrame::complete() {
+  if (this->pending_)
+    this->dropped_++;
+  std::copy(this->staging_.begin(), this->staging_.end(), this->complete_.begin());
+  this->pending_ = true;
+}
+
+bool RealtimeFrame::apply(AddressableLight &it) {
+  if (!this->pending_)
+    return false;
+  this->pending_ = false;
+
+  const int32_t count = std::min<int32_t>(it.size(), this->complete_.size());
+  for (int32_t led = 0; led < count; led++)
+    it[led].set(this->complete_[led]);
+  it.schedule_show();
+  return true;
+}
+
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "esphome/core/color.h"
+
+namespace esphome {
+namespace light {
+
+class AddressableLight;
+
+/** Staging buffer for effects that stream pixels from another device, like WLED and Adalight.
+ *
+ * Incoming data is parsed straight into the staging pixels. Once a frame is complete it is handed over, and the
+ * latest complete frame is copied into the light by apply() right before the light writes its state. So a frame
+ * arriving in several parts is never shown half old and half new.
+ */
+class RealtimeFrame {
+ public:
+  /// Set the number of pixels, clearing the staged and the complete frame.
+  void resize(size_t size);
+  size_t size() const { return this->staging_.size(); }
+
+  /// Set a pixel of the staged frame, indices past the end of the light are ignored.
+  void set(size_t index, const Color &color) {
+    if (index < this->staging_.size())
+      this->staging_[index] = color;
+  }
+  /// Set all pixels of the staged frame.
+  void fill(const Color &color);
+
+  /** Hand the staged frame over to be shown.
+   *
+   * The staged pixels are kept, so protocols updating only some of them build on the previous frame. A complete
+   * frame that was not shown yet is replaced, which counts as dropped.
+   */
+  void complete();
+
+  /// Copy the latest complete frame into the light and schedule a show. Returns false if there was none.
+  bool apply(AddressableLight &it);
+
+  /// Count a frame that arrived too late, after the stream already timed out.
+  void count_late() { this->late_++; }
+
+  /// Number of complete frames replaced by a newer one before they were shown.
+  uint32_t get_dropped() const { return this->dropped_; }
+  /// Number of frames that arrived too late.
+  uint32_t get_late() const { return this->late_; }
+
+ protected:
+  std::vector<Color> staging_;
+  std::vector<Color> complete_;
+  bool pending_{false};
+  uint32_t dropped_{0};
+  uint32_t late_{0};
+};
+
+}  // namespace light
+}  // namespace esphome
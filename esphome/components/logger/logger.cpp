@@ -64,7 +64,16 @@ void Logger::write_header_(int level, const char *tag, int line) {
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+#ifdef USE_NETWORK_TASK
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  if (this->buffer_owner_ == task)
+    return;
+  LockGuard guard{this->buffer_lock_};
+  this->buffer_owner_ = task;
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
@@ -74,6 +83,9 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
   this->write_footer_();
   this->log_message_(level, tag);
   recursion_guard_ = false;
+#ifdef USE_NETWORK_TASK
+  this->buffer_owner_ = nullptr;
+#endif
 }
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
@@ -21,6 +21,11 @@
 #include <driver/uart.h>
 #endif  // USE_ESP_IDF
 
+#ifdef USE_NETWORK_TASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 
 namespace logger {
@@ -182,6 +187,12 @@ class Logger : public Component {
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
+#ifdef USE_NETWORK_TASK
+  /// The main loop and the network task both log, this is held while one of them uses tx_buffer_.
+  Mutex buffer_lock_;
+  /// Task holding buffer_lock_, a log call made from a log callback on that task returns instead of deadlocking.
+  TaskHandle_t buffer_owner_{nullptr};
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -75,6 +75,7 @@ void ModbusController::on_modbus_data(const std::vector<uint8_t> &data) {
     // Move the commandItem to the response queue
     current_command->payload = data;
     this->incoming_queue_.push(std::move(current_command));
+    this->enable_loop();
     ESP_LOGV(TAG, "Modbus response queued");
     command_queue_.pop_front();
   }
@@ -85,6 +86,7 @@ void ModbusController::process_modbus_data_(const ModbusCommandItem *response) {
   ESP_LOGV(TAG, "Process modbus response for address 0x%X size: %zu", response->register_address,
            response->payload.size());
   response->on_data_func(response->register_type, response->register_address, response->payload);
+  this->command_response_callback_.call(*response);
 }
 
 void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_code) {
@@ -98,6 +100,7 @@ void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_
              "payload size=%zu",
              function_code, current_command->register_address, current_command->register_count,
              current_command->payload.size());
+    this->command_error_callback_.call(*current_command, exception_code);
     command_queue_.pop_front();
   }
 }
@@ -141,6 +144,7 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
     }
   }
   command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  this->enable_loop();
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
@@ -320,9 +324,9 @@ void ModbusController::loop() {
       process_modbus_data_(message.get());
     incoming_queue_.pop();
 
-  } else {
-    // all messages processed send pending commands
-    send_next_command_();
+  } else if (!send_next_command_()) {
+    // all messages processed and no pending commands, wait for the next one to be queued
+    this->disable_loop();
   }
 }
 
@@ -4,6 +4,7 @@
 
 #include "esphome/components/modbus/modbus.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/helpers.h"
 
 #include <list>
 #include <queue>
@@ -436,6 +437,15 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   size_t get_command_queue_length() { return command_queue_.size(); }
   /// get if the module is offline, didn't respond the last command
   bool get_module_offline() { return module_offline_; }
+  /// called after the response to a command was dispatched to its handler
+  void add_on_command_response_callback(std::function<void(const ModbusCommandItem &command)> &&callback) {
+    this->command_response_callback_.add(std::move(callback));
+  }
+  /// called when the device answered a command with an exception, before the command is removed from the queue
+  void add_on_command_error_callback(
+      std::function<void(const ModbusCommandItem &command, uint8_t exception_code)> &&callback) {
+    this->command_error_callback_.add(std::move(callback));
+  }
 
  protected:
   /// parse sensormap_ and create range of sequential addresses
@@ -466,6 +476,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   bool module_offline_;
   /// how many updates to skip if module is offline
   uint16_t offline_skip_updates_;
+  CallbackManager<void(const ModbusCommandItem &)> command_response_callback_;
+  CallbackManager<void(const ModbusCommandItem &, uint8_t)> command_error_callback_;
 };
 
 /** Convert vector<uint8_t> response payload to float.
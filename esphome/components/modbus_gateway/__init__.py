@@ -0,0 +1,34 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components.modbus_controller import ModbusController
+from esphome.components.modbus_controller.const import CONF_MODBUS_CONTROLLER_ID
+from esphome.const import CONF_ID, CONF_PORT, CONF_TIMEOUT
+
+AUTO_LOAD = ["socket"]
+DEPENDENCIES = ["modbus_controller", "network"]
+MULTI_CONF = True
+
+CONF_MAX_AGE = "max_age"
+
+modbus_gateway_ns = cg.esphome_ns.namespace("modbus_gateway")
+ModbusGateway = modbus_gateway_ns.class_("ModbusGateway", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ModbusGateway),
+        cv.GenerateID(CONF_MODBUS_CONTROLLER_ID): cv.use_id(ModbusController),
+        cv.Optional(CONF_PORT, default=502): cv.port,
+        cv.Optional(CONF_MAX_AGE, default="5s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_TIMEOUT, default="3s"): cv.positive_time_period_milliseconds,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    controller = await cg.get_variable(config[CONF_MODBUS_CONTROLLER_ID])
+    cg.add(var.set_controller(controller))
+    cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_max_age(config[CONF_MAX_AGE]))
+    cg.add(var.set_timeout(config[CONF_TIMEOUT]))
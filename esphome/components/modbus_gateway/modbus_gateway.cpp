@@ -0,0 +1,471 @@
+#include "modbus_gateway.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+
+namespace esphome {
+namespace modbus_gateway {
+
+static const char *const TAG = "modbus_gateway";
+
+/// Transaction id, protocol id, length and unit id
+static const size_t MBAP_HEADER_SIZE = 7;
+/// Largest length field of a Modbus TCP frame, unit id and PDU
+static const uint16_t MAX_MBAP_LENGTH = 254;
+static const size_t MAX_CLIENTS = 4;
+static const uint32_t STATS_INTERVAL = 60000;
+
+static const uint8_t EXCEPTION_ILLEGAL_FUNCTION = 0x01;
+static const uint8_t EXCEPTION_ILLEGAL_DATA_ADDRESS = 0x02;
+static const uint8_t EXCEPTION_ILLEGAL_DATA_VALUE = 0x03;
+static const uint8_t EXCEPTION_GATEWAY_PATH_UNAVAILABLE = 0x0A;
+static const uint8_t EXCEPTION_GATEWAY_TARGET_FAILED = 0x0B;
+
+static uint16_t get_word(const uint8_t *data) { return (uint16_t(data[0]) << 8) | data[1]; }
+
+void RegisterCache::store(ModbusRegisterType register_type, uint16_t start_address, uint16_t count,
+                          const std::vector<uint8_t> &data, uint32_t now) {
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t value;
+    if (is_bit_type_(register_type)) {
+      if (i / 8u >= data.size())
+        break;
+      value = (data[i / 8u] >> (i % 8u)) & 1;
+    } else {
+      if (i * 2u + 1 >= data.size())
+        break;
+      value = get_word(&data[i * 2u]);
+    }
+    this->entries_[key_(register_type, start_address + i)] = Entry{value, now};
+  }
+}
+
+bool RegisterCache::lookup(ModbusRegisterType register_type, uint16_t start_address, uint16_t count, uint32_t now,
+                           uint32_t max_age, std::vector<uint8_t> &data) const {
+  const bool bits = is_bit_type_(register_type);
+  data.assign(bits ? (count + 7u) / 8u : count * 2u, 0);
+  for (uint16_t i = 0; i < count; i++) {
+    auto it = this->entries_.find(key_(register_type, start_address + i));
+    if (it == this->entries_.end() || now - it->second.updated > max_age)
+      return false;
+    if (bits) {
+      data[i / 8u] |= (it->second.value & 1) << (i % 8u);
+    } else {
+      data[i * 2u] = it->second.value >> 8;
+      data[i * 2u + 1] = it->second.value & 0xFF;
+    }
+  }
+  return true;
+}
+
+void RegisterCache::invalidate(ModbusRegisterType register_type, uint16_t start_address, uint16_t count) {
+  for (uint16_t i = 0; i < count; i++)
+    this->entries_.erase(key_(register_type, start_address + i));
+}
+
+void ModbusGateway::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up Modbus TCP gateway...");
+  this->socket_ = socket::socket_ip(SOCK_STREAM, 0);
+  if (this->socket_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket.");
+    this->mark_failed();
+    return;
+  }
+  int enable = 1;
+  int err = this->socket_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set reuseaddr: errno %d", err);
+    // we can still continue
+  }
+  err = this->socket_->setblocking(false);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
+    this->mark_failed();
+    return;
+  }
+
+  struct sockaddr_storage server;
+  socklen_t sl = socket::set_sockaddr_any((struct sockaddr *) &server, sizeof(server), this->port_);
+  if (sl == 0) {
+    ESP_LOGW(TAG, "Socket unable to set sockaddr: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+  err = this->socket_->bind((struct sockaddr *) &server, sl);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to bind: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+  err = this->socket_->listen(MAX_CLIENTS);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to listen: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+
+  this->controller_->add_on_command_response_callback(
+      [this](const ModbusCommandItem &command) { this->on_command_response_(command); });
+  this->controller_->add_on_command_error_callback(
+      [this](const ModbusCommandItem &command, uint8_t exception_code) {
+        this->on_command_error_(command, exception_code);
+      });
+  this->set_interval("stats", STATS_INTERVAL, [this]() { this->log_stats_(); });
+}
+
+void ModbusGateway::loop() {
+  while (true) {
+    struct sockaddr_storage source_addr;
+    socklen_t addr_len = sizeof(source_addr);
+    auto sock = this->socket_->accept((struct sockaddr *) &source_addr, &addr_len);
+    if (!sock)
+      break;
+    if (this->clients_.size() >= MAX_CLIENTS) {
+      ESP_LOGW(TAG, "Rejected %s, too many clients", sock->getpeername().c_str());
+      continue;
+    }
+    if (sock->setblocking(false) != 0) {
+      ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", errno);
+      continue;
+    }
+    auto client = make_unique<Client>();
+    client->peername = sock->getpeername();
+    client->socket = std::move(sock);
+    ESP_LOGD(TAG, "Accepted %s", client->peername.c_str());
+    this->clients_.push_back(std::move(client));
+  }
+
+  for (auto &client : this->clients_)
+    this->read_client_(client.get());
+
+  const uint32_t now = millis();
+  for (auto it = this->pending_.begin(); it != this->pending_.end();) {
+    if (now - it->received > this->timeout_) {
+      ESP_LOGW(TAG, "No response for function 0x%02X address 0x%X count %u", it->function_code, it->start_address,
+               it->count);
+      this->timeouts_++;
+      this->send_exception_(*it, EXCEPTION_GATEWAY_TARGET_FAILED);
+      it = this->pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  auto new_end = std::partition(this->clients_.begin(), this->clients_.end(),
+                                [](const std::unique_ptr<Client> &client) { return !client->remove; });
+  for (auto it = new_end; it != this->clients_.end(); ++it) {
+    ESP_LOGD(TAG, "Disconnected %s", (*it)->peername.c_str());
+    // Drop what the client is still waiting for
+    this->pending_.remove_if([client = it->get()](const PendingRequest &request) { return request.client == client; });
+  }
+  this->clients_.erase(new_end, this->clients_.end());
+}
+
+void ModbusGateway::read_client_(Client *client) {
+  uint8_t buf[MBAP_HEADER_SIZE + MAX_MBAP_LENGTH];
+  while (!client->remove) {
+    ssize_t received = client->socket->read(buf, sizeof(buf));
+    if (received == -1) {
+      if (errno != EWOULDBLOCK && errno != EAGAIN) {
+        ESP_LOGD(TAG, "Reading from %s failed: errno %d", client->peername.c_str(), errno);
+        client->remove = true;
+      }
+      break;
+    }
+    if (received == 0) {
+      client->remove = true;
+      break;
+    }
+    client->rx_buffer.insert(client->rx_buffer.end(), buf, buf + received);
+
+    size_t at = 0;
+    while (!client->remove && client->rx_buffer.size() - at >= MBAP_HEADER_SIZE) {
+      const uint8_t *adu = &client->rx_buffer[at];
+      const uint16_t protocol_id = get_word(adu + 2);
+      const uint16_t length = get_word(adu + 4);
+      if (protocol_id != 0 || length < 2 || length > MAX_MBAP_LENGTH) {
+        ESP_LOGW(TAG, "Invalid frame from %s, closing connection", client->peername.c_str());
+        client->remove = true;
+        break;
+      }
+      if (client->rx_buffer.size() - at < 6u + length)
+        break;
+      this->handle_request_(client, adu, 6u + length);
+      at += 6u + length;
+    }
+    client->rx_buffer.erase(client->rx_buffer.begin(), client->rx_buffer.begin() + at);
+  }
+}
+
+void ModbusGateway::handle_request_(Client *client, const uint8_t *adu, size_t adu_len) {
+  const uint8_t *pdu = adu + MBAP_HEADER_SIZE;
+  const size_t pdu_len = adu_len - MBAP_HEADER_SIZE;
+
+  PendingRequest request{};
+  request.client = client;
+  request.transaction_id = get_word(adu);
+  request.unit_id = adu[6];
+  request.function_code = pdu[0];
+  request.received = millis();
+
+  // 0xFF addresses the gateway itself, which forwards to its only device
+  if (request.unit_id != this->controller_->get_address() && request.unit_id != 0xFF) {
+    this->send_exception_(request, EXCEPTION_GATEWAY_PATH_UNAVAILABLE);
+    return;
+  }
+
+  uint16_t max_count;
+  switch (ModbusFunctionCode(request.function_code)) {
+    case ModbusFunctionCode::READ_COILS:
+      request.register_type = ModbusRegisterType::COIL;
+      max_count = 2000;
+      break;
+    case ModbusFunctionCode::READ_DISCRETE_INPUTS:
+      request.register_type = ModbusRegisterType::DISCRETE_INPUT;
+      max_count = 2000;
+      break;
+    case ModbusFunctionCode::READ_HOLDING_REGISTERS:
+      request.register_type = ModbusRegisterType::HOLDING;
+      max_count = 125;
+      break;
+    case ModbusFunctionCode::READ_INPUT_REGISTERS:
+      request.register_type = ModbusRegisterType::READ;
+      max_count = 125;
+      break;
+    case ModbusFunctionCode::WRITE_SINGLE_COIL:
+    case ModbusFunctionCode::WRITE_MULTIPLE_COILS:
+      request.register_type = ModbusRegisterType::COIL;
+      max_count = 1968;
+      break;
+    case ModbusFunctionCode::WRITE_SINGLE_REGISTER:
+    case ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS:
+      request.register_type = ModbusRegisterType::HOLDING;
+      max_count = 123;
+      break;
+    default:
+      this->send_exception_(request, EXCEPTION_ILLEGAL_FUNCTION);
+      return;
+  }
+  if (pdu_len < 5) {
+    this->send_exception_(request, EXCEPTION_ILLEGAL_DATA_VALUE);
+    return;
+  }
+  request.start_address = get_word(pdu + 1);
+  const bool single_write = request.function_code == uint8_t(ModbusFunctionCode::WRITE_SINGLE_COIL) ||
+                            request.function_code == uint8_t(ModbusFunctionCode::WRITE_SINGLE_REGISTER);
+  request.count = single_write ? 1 : get_word(pdu + 3);
+  if (request.count < 1 || request.count > max_count) {
+    this->send_exception_(request, EXCEPTION_ILLEGAL_DATA_VALUE);
+    return;
+  }
+  if (uint32_t(request.start_address) + request.count > 0x10000) {
+    this->send_exception_(request, EXCEPTION_ILLEGAL_DATA_ADDRESS);
+    return;
+  }
+
+  if (request.function_code <= uint8_t(ModbusFunctionCode::READ_INPUT_REGISTERS)) {
+    this->handle_read_(request);
+  } else {
+    this->handle_write_(request, pdu, pdu_len);
+  }
+}
+
+void ModbusGateway::handle_read_(const PendingRequest &request) {
+  std::vector<uint8_t> data;
+  if (this->cache_.lookup(request.register_type, request.start_address, request.count, request.received,
+                          this->max_age_, data)) {
+    this->hits_++;
+    this->pdu_.clear();
+    this->pdu_.push_back(request.function_code);
+    this->pdu_.push_back(data.size());
+    this->pdu_.insert(this->pdu_.end(), data.begin(), data.end());
+    this->send_response_(request.client, request.transaction_id, request.unit_id, this->pdu_);
+    return;
+  }
+  this->misses_++;
+
+  // Every waiting read has a command for its registers in the queue, so one covering these is enough
+  bool coalesced = false;
+  for (auto &other : this->pending_) {
+    if (other.function_code == request.function_code && other.start_address <= request.start_address &&
+        uint32_t(other.start_address) + other.count >= uint32_t(request.start_address) + request.count) {
+      coalesced = true;
+      break;
+    }
+  }
+  if (coalesced) {
+    this->coalesced_++;
+  } else {
+    // The response fills the cache through the response callback, which answers the waiting reads
+    this->controller_->queue_command(ModbusCommandItem::create_read_command(
+        this->controller_, request.register_type, request.start_address, request.count,
+        [](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {}));
+  }
+  this->pending_.push_back(request);
+}
+
+void ModbusGateway::handle_write_(const PendingRequest &request, const uint8_t *pdu, size_t pdu_len) {
+  ModbusCommandItem command;
+  switch (ModbusFunctionCode(request.function_code)) {
+    case ModbusFunctionCode::WRITE_SINGLE_COIL: {
+      const uint16_t value = get_word(pdu + 3);
+      if (value != 0xFF00 && value != 0x0000) {
+        this->send_exception_(request, EXCEPTION_ILLEGAL_DATA_VALUE);
+        return;
+      }
+      command = ModbusCommandItem::create_write_single_coil(this->controller_, request.start_address, value != 0);
+      break;
+    }
+    case ModbusFunctionCode::WRITE_SINGLE_REGISTER:
+      command =
+          ModbusCommandItem::create_write_single_command(this->controller_, request.start_address, get_word(pdu + 3));
+      break;
+    case ModbusFunctionCode::WRITE_MULTIPLE_COILS: {
+      const size_t byte_count = (request.count + 7u) / 8u;
+      if (pdu_len < 6 || pdu[5] != byte_count || pdu_len != 6 + byte_count) {
+        this->send_exception_(request, EXCEPTION_ILLEGAL_DATA_VALUE);
+        return;
+      }
+      std::vector<bool> values(request.count);
+      for (uint16_t i = 0; i < request.count; i++)
+        values[i] = (pdu[6 + i / 8u] >> (i % 8u)) & 1;
+      command = ModbusCommandItem::create_write_multiple_coils(this->controller_, request.start_address, values);
+      break;
+    }
+    case ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS: {
+      const size_t byte_count = request.count * 2u;
+      if (pdu_len < 6 || pdu[5] != byte_count || pdu_len != 6 + byte_count) {
+        this->send_exception_(request, EXCEPTION_ILLEGAL_DATA_VALUE);
+        return;
+      }
+      std::vector<uint16_t> values(request.count);
+      for (uint16_t i = 0; i < request.count; i++)
+        values[i] = get_word(pdu + 6 + i * 2u);
+      command = ModbusCommandItem::create_write_multiple_command(this->controller_, request.start_address,
+                                                                 request.count, values);
+      break;
+    }
+    default:
+      return;
+  }
+  // Reads after this one must see the written value, the command queue keeps them in order
+  this->cache_.invalidate(request.register_type, request.start_address, request.count);
+  this->controller_->queue_command(command);
+  this->pending_.push_back(request);
+}
+
+void ModbusGateway::on_command_response_(const ModbusCommandItem &command) {
+  const uint8_t function_code = uint8_t(command.function_code);
+  if (function_code >= uint8_t(ModbusFunctionCode::READ_COILS) &&
+      function_code <= uint8_t(ModbusFunctionCode::READ_INPUT_REGISTERS)) {
+    this->cache_.store(command.register_type, command.register_address, command.register_count, command.payload,
+                       millis());
+    this->answer_pending_reads_();
+    return;
+  }
+  if (function_code != uint8_t(ModbusFunctionCode::WRITE_SINGLE_COIL) &&
+      function_code != uint8_t(ModbusFunctionCode::WRITE_SINGLE_REGISTER) &&
+      function_code != uint8_t(ModbusFunctionCode::WRITE_MULTIPLE_COILS) &&
+      function_code != uint8_t(ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS))
+    return;
+
+  // A read queued before the write may have stored the old value in the meantime
+  this->cache_.invalidate(command.register_type, command.register_address, command.register_count);
+  // The device echoes the address and the value or count, just like the response to the client
+  this->pdu_.clear();
+  this->pdu_.push_back(function_code);
+  this->pdu_.insert(this->pdu_.end(), command.payload.begin(), command.payload.end());
+  for (auto it = this->pending_.begin(); it != this->pending_.end();) {
+    // Writes of the same registers are merged in the command queue, so all of them got this response
+    if (it->function_code == function_code && it->start_address == command.register_address &&
+        it->count == command.register_count) {
+      this->send_response_(it->client, it->transaction_id, it->unit_id, this->pdu_);
+      it = this->pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ModbusGateway::on_command_error_(const ModbusCommandItem &command, uint8_t exception_code) {
+  for (auto it = this->pending_.begin(); it != this->pending_.end();) {
+    if (it->function_code == uint8_t(command.function_code) && it->start_address == command.register_address &&
+        it->count == command.register_count) {
+      this->send_exception_(*it, exception_code);
+      it = this->pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ModbusGateway::answer_pending_reads_() {
+  const uint32_t now = millis();
+  std::vector<uint8_t> data;
+  for (auto it = this->pending_.begin(); it != this->pending_.end();) {
+    // Only values read after the request came in are good enough now
+    if (it->function_code > uint8_t(ModbusFunctionCode::READ_INPUT_REGISTERS) ||
+        !this->cache_.lookup(it->register_type, it->start_address, it->count, now, now - it->received, data)) {
+      ++it;
+      continue;
+    }
+    this->pdu_.clear();
+    this->pdu_.push_back(it->function_code);
+    this->pdu_.push_back(data.size());
+    this->pdu_.insert(this->pdu_.end(), data.begin(), data.end());
+    this->send_response_(it->client, it->transaction_id, it->unit_id, this->pdu_);
+    it = this->pending_.erase(it);
+  }
+}
+
+void ModbusGateway::send_response_(Client *client, uint16_t transaction_id, uint8_t unit_id,
+                                   const std::vector<uint8_t> &pdu) {
+  if (client->remove)
+    return;
+  uint8_t adu[MBAP_HEADER_SIZE + MAX_MBAP_LENGTH];
+  const uint16_t length = pdu.size() + 1;
+  adu[0] = transaction_id >> 8;
+  adu[1] = transaction_id & 0xFF;
+  adu[2] = 0;
+  adu[3] = 0;
+  adu[4] = length >> 8;
+  adu[5] = length & 0xFF;
+  adu[6] = unit_id;
+  std::copy(pdu.begin(), pdu.end(), adu + MBAP_HEADER_SIZE);
+  const size_t size = MBAP_HEADER_SIZE + pdu.size();
+  // Responses are far smaller than the socket buffer, a client that does not read them is dropped
+  if (client->socket->write(adu, size) != ssize_t(size)) {
+    ESP_LOGW(TAG, "Writing to %s failed: errno %d", client->peername.c_str(), errno);
+    client->remove = true;
+  }
+}
+
+void ModbusGateway::send_exception_(const PendingRequest &request, uint8_t exception_code) {
+  this->pdu_.clear();
+  this->pdu_.push_back(request.function_code | 0x80);
+  this->pdu_.push_back(exception_code);
+  this->send_response_(request.client, request.transaction_id, request.unit_id, this->pdu_);
+}
+
+void ModbusGateway::log_stats_() {
+  const uint32_t requests = this->hits_ + this->misses_;
+  if (requests == this->logged_requests_)
+    return;
+  this->logged_requests_ = requests;
+  ESP_LOGD(TAG, "Reads: %" PRIu32 " hits, %" PRIu32 " misses (%" PRIu32 " coalesced), %" PRIu32 " timeouts, %zu cached",
+           this->hits_, this->misses_, this->coalesced_, this->timeouts_, this->cache_.size());
+}
+
+void ModbusGateway::dump_config() {
+  ESP_LOGCONFIG(TAG, "Modbus TCP Gateway:");
+  ESP_LOGCONFIG(TAG, "  Port: %u", this->port_);
+  ESP_LOGCONFIG(TAG, "  Device Address: 0x%02X", this->controller_->get_address());
+  ESP_LOGCONFIG(TAG, "  Max Age: %" PRIu32 " ms", this->max_age_);
+  ESP_LOGCONFIG(TAG, "  Timeout: %" PRIu32 " ms", this->timeout_);
+}
+
+}  // namespace modbus_gateway
+}  // namespace esphome
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "esphome/components/modbus_controller/modbus_controller.h"
+#include "esphome/components/socket/socket.h"
+#include "esphome/core/component.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace modbus_gateway {
+
+using modbus_controller::ModbusCommandItem;
+using modbus_controller::ModbusController;
+using modbus_controller::ModbusFunctionCode;
+using modbus_controller::ModbusRegisterType;
+
+/** Last known value of the registers and coils read from a device, with the time they were read.
+ *
+ * Registers hold a 16 bit value, coils and discrete inputs hold 0 or 1.
+ */
+class RegisterCache {
+ public:
+  /// Store the data of a read response, in the format of the response for the register type.
+  void store(ModbusRegisterType register_type, uint16_t start_address, uint16_t count,
+             const std::vector<uint8_t> &data, uint32_t now);
+  /** Build the data of a read response from the cache.
+   *
+   * @return false if one of the entities was never read or is older than max_age ms, data is then incomplete
+   */
+  bool lookup(ModbusRegisterType register_type, uint16_t start_address, uint16_t count, uint32_t now,
+              uint32_t max_age, std::vector<uint8_t> &data) const;
+  /// Forget the entities, so the next read goes to the device.
+  void invalidate(ModbusRegisterType register_type, uint16_t start_address, uint16_t count);
+  size_t size() const { return this->entries_.size(); }
+
+ protected:
+  struct Entry {
+    uint16_t value;
+    uint32_t updated;
+  };
+  static uint32_t key_(ModbusRegisterType register_type, uint16_t address) {
+    return (uint32_t(register_type) << 16) | address;
+  }
+  static bool is_bit_type_(ModbusRegisterType register_type) {
+    return register_type == ModbusRegisterType::COIL || register_type == ModbusRegisterType::DISCRETE_INPUT;
+  }
+
+  std::map<uint32_t, Entry> entries_;
+};
+
+/** Modbus TCP server in front of a modbus controller.
+ *
+ * Reads are answered from the registers the controller polls as long as they are not older than max_age. On a miss
+ * a read is queued with the controller, and all requests waiting for the same registers are answered by its
+ * response. Writes are queued with the controller too, so they go out on the bus between its own commands.
+ */
+class ModbusGateway : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  void set_controller(ModbusController *controller) { this->controller_ = controller; }
+  void set_port(uint16_t port) { this->port_ = port; }
+  void set_max_age(uint32_t max_age) { this->max_age_ = max_age; }
+  void set_timeout(uint32_t timeout) { this->timeout_ = timeout; }
+
+  /// Reads answered from the cache.
+  uint32_t get_hits() const { return this->hits_; }
+  /// Reads that had to wait for the device.
+  uint32_t get_misses() const { return this->misses_; }
+  /// Misses that joined a read already on its way to the device instead of queueing another one.
+  uint32_t get_coalesced() const { return this->coalesced_; }
+  /// Requests the device did not answer in time.
+  uint32_t get_timeouts() const { return this->timeouts_; }
+
+ protected:
+  struct Client {
+    std::unique_ptr<socket::Socket> socket;
+    std::string peername;
+    std::vector<uint8_t> rx_buffer;
+    bool remove{false};
+  };
+  struct PendingRequest {
+    Client *client;
+    uint16_t transaction_id;
+    uint8_t unit_id;
+    uint8_t function_code;
+    ModbusRegisterType register_type;
+    uint16_t start_address;
+    uint16_t count;
+    uint32_t received;
+  };
+
+  void read_client_(Client *client);
+  void handle_request_(Client *client, const uint8_t *adu, size_t adu_len);
+  void handle_read_(const PendingRequest &request);
+  void handle_write_(const PendingRequest &request, const uint8_t *pdu, size_t pdu_len);
+  void on_command_response_(const ModbusCommandItem &command);
+  void on_command_error_(const ModbusCommandItem &command, uint8_t exception_code);
+  /// Answer the waiting reads which are complete now.
+  void answer_pending_reads_();
+  void send_response_(Client *client, uint16_t transaction_id, uint8_t unit_id, const std::vector<uint8_t> &pdu);
+  void send_exception_(const PendingRequest &request, uint8_t exception_code);
+  void log_stats_();
+
+  ModbusController *controller_{nullptr};
+  uint16_t port_{502};
+  uint32_t max_age_{5000};
+  uint32_t timeout_{3000};
+  std::unique_ptr<socket::Socket> socket_;
+  std::vector<std::unique_ptr<Client>> clients_;
+  std::list<PendingRequest> pending_;
+  RegisterCache cache_;
+  /// Reused for building responses
+  std::vector<uint8_t> pdu_;
+
+  uint32_t hits_{0};
+  uint32_t misses_{0};
+  uint32_t coalesced_{0};
+  uint32_t timeouts_{0};
+  uint32_t logged_requests_{0};
+};
+
+}  // namespace modbus_gateway
+}  // namespace esphome
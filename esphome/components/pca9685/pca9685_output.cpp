@@ -97,43 +97,48 @@ void PCA9685Output::dump_config() {
 }
 
 void PCA9685Output::loop() {
-  if (this->min_channel_ == 0xFF || !this->update_)
+  if (this->min_channel_ == 0xFF)
     return;
 
-  const uint16_t num_channels = this->max_channel_ - this->min_channel_ + 1;
-  for (uint8_t channel = this->min_channel_; channel <= this->max_channel_; channel++) {
-    uint16_t phase_begin = uint16_t(channel - this->min_channel_) / num_channels * 4096;
-    uint16_t phase_end;
-    uint16_t amount = this->pwm_amounts_[channel];
-    if (amount == 0) {
-      phase_end = 4096;
-    } else if (amount >= 4096) {
-      phase_begin = 4096;
-      phase_end = 0;
-    } else {
-      phase_end = phase_begin + amount;
-      if (phase_end >= 4096)
-        phase_end -= 4096;
+  if (this->update_) {
+    const uint16_t num_channels = this->max_channel_ - this->min_channel_ + 1;
+    for (uint8_t channel = this->min_channel_; channel <= this->max_channel_; channel++) {
+      uint16_t phase_begin = uint16_t(channel - this->min_channel_) / num_channels * 4096;
+      uint16_t phase_end;
+      uint16_t amount = this->pwm_amounts_[channel];
+      if (amount == 0) {
+        phase_end = 4096;
+      } else if (amount >= 4096) {
+        phase_begin = 4096;
+        phase_end = 0;
+      } else {
+        phase_end = phase_begin + amount;
+        if (phase_end >= 4096)
+          phase_end -= 4096;
+      }
+
+      ESP_LOGVV(TAG, "Channel %02u: amount=%04u phase_begin=%04u phase_end=%04u", channel, amount, phase_begin,
+                phase_end);
+
+      uint8_t data[4];
+      data[0] = phase_begin & 0xFF;
+      data[1] = (phase_begin >> 8) & 0xFF;
+      data[2] = phase_end & 0xFF;
+      data[3] = (phase_end >> 8) & 0xFF;
+      // Only channels whose registers changed are written
+      this->led_registers_.set(channel, data);
     }
+    this->update_ = false;
+  }
 
-    ESP_LOGVV(TAG, "Channel %02u: amount=%04u phase_begin=%04u phase_end=%04u", channel, amount, phase_begin,
-              phase_end);
-
-    uint8_t data[4];
-    data[0] = phase_begin & 0xFF;
-    data[1] = (phase_begin >> 8) & 0xFF;
-    data[2] = phase_end & 0xFF;
-    data[3] = (phase_end >> 8) & 0xFF;
-
-    uint8_t reg = PCA9685_REGISTER_LED0 + 4 * channel;
-    if (!this->write_bytes(reg, data, 4)) {
+  if (this->led_registers_.is_dirty()) {
+    if (this->led_registers_.flush(this) != i2c::ERROR_OK) {
       this->status_set_warning();
       return;
     }
+    this->status_clear_warning();
   }
-
-  this->status_clear_warning();
-  this->update_ = false;
+  this->led_registers_.log_stats(TAG);
 }
 
 void PCA9685Output::register_channel(PCA9685Channel *channel) {
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/output/float_output.h"
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/components/i2c/register_batch.h"
 
 namespace esphome {
 namespace pca9685 {
@@ -67,6 +68,8 @@ class PCA9685Output : public Component, public i2c::I2CDevice {
       0,
   };
   bool update_{true};
+  /// LEDn_ON_L to LEDn_OFF_H of all channels.
+  i2c::RegisterBatch led_registers_{0x06, 16, 4};
 };
 
 }  // namespace pca9685
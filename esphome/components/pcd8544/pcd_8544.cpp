@@ -112,7 +112,8 @@ void PCD8544::command(uint8_t value) {
 }
 
 void PCD8544::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 
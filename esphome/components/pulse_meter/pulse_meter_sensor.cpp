@@ -1,4 +1,5 @@
 #include "pulse_meter_sensor.h"
+#include <cstring>
 #include <utility>
 #include "esphome/core/log.h"
 
@@ -21,6 +22,10 @@ void PulseMeterSensor::setup() {
   // Set the last processed edge to now for the first timeout
   this->last_processed_edge_us_ = micros();
 
+  // Continue counting from the total before the deep sleep or reboot
+  if (this->is_warm_start() && this->total_sensor_ != nullptr)
+    this->total_sensor_->publish_state(this->total_pulses_);
+
   if (this->filter_mode_ == FILTER_EDGE) {
     this->pin_->attach_interrupt(PulseMeterSensor::edge_intr, this, gpio::INTERRUPT_RISING_EDGE);
   } else if (this->filter_mode_ == FILTER_PULSE) {
@@ -144,5 +149,15 @@ void IRAM_ATTR PulseMeterSensor::pulse_intr(PulseMeterSensor *sensor) {
   }
 }
 
+#ifdef USE_WARM_STATE
+void PulseMeterSensor::save_warm_state(uint8_t *data) {
+  memcpy(data, &this->total_pulses_, sizeof(this->total_pulses_));
+}
+bool PulseMeterSensor::restore_warm_state(const uint8_t *data) {
+  memcpy(&this->total_pulses_, data, sizeof(this->total_pulses_));
+  return true;
+}
+#endif
+
 }  // namespace pulse_meter
 }  // namespace esphome
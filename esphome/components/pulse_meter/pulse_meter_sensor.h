@@ -30,6 +30,12 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
   float get_setup_priority() const override;
   void dump_config() override;
 
+#ifdef USE_WARM_STATE
+  size_t get_warm_state_size() const override { return sizeof(this->total_pulses_); }
+  void save_warm_state(uint8_t *data) override;
+  bool restore_warm_state(const uint8_t *data) override;
+#endif
+
  protected:
   static void edge_intr(PulseMeterSensor *sensor);
   static void pulse_intr(PulseMeterSensor *sensor);
@@ -1,7 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation, pins
-from esphome.components import sensor
+from esphome.components import sensor, warm_state
 from esphome.const import (
     CONF_ID,
     CONF_INTERNAL_FILTER,
@@ -94,6 +94,7 @@ async def to_code(config):
     if CONF_TOTAL in config:
         sens = await sensor.new_sensor(config[CONF_TOTAL])
         cg.add(var.set_total_sensor(sens))
+        await warm_state.register_warm_state(var, config)
 
 
 @automation.register_action(
@@ -1,4 +1,5 @@
 #include "ruuvi_ble.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 #ifdef USE_ESP32
@@ -94,6 +95,19 @@ optional<RuuviParseResult> parse_ruuvi(const esp32_ble_tracker::ESPBTDevice &dev
   return result;
 }
 
+optional<uint16_t> parse_ruuvi_sequence_number(const esp32_ble_tracker::ESPBTDevice &device) {
+  for (auto &it : device.get_manufacturer_datas()) {
+    if (!it.uuid.contains(0x99, 0x04) || it.data.size() != 24 || it.data[0] != 0x05)
+      continue;
+    const uint16_t sequence_number = encode_uint16(it.data[16], it.data[17]);
+    // Not available
+    if (sequence_number == 0xFFFF)
+      return {};
+    return sequence_number;
+  }
+  return {};
+}
+
 bool RuuviListener::parse_device(const esp32_ble_tracker::ESPBTDevice &device) {
   auto res = parse_ruuvi(device);
   if (!res.has_value())
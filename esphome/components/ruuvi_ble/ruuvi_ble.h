@@ -25,6 +25,8 @@ struct RuuviParseResult {
 bool parse_ruuvi_data_byte(uint8_t data_type, const uint8_t *data, uint8_t data_length, RuuviParseResult &result);
 
 optional<RuuviParseResult> parse_ruuvi(const esp32_ble_tracker::ESPBTDevice &device);
+/// Measurement sequence number of a RAWv2 advertisement, to skip the repeated ones before parsing them.
+optional<uint16_t> parse_ruuvi_sequence_number(const esp32_ble_tracker::ESPBTDevice &device);
 
 class RuuviListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
@@ -18,6 +18,14 @@ class RuuviTag : public Component, public esp32_ble_tracker::ESPBTDeviceListener
     if (device.address_uint64() != this->address_)
       return false;
 
+    // A tag repeats the advertisement of a measurement until the next one
+    auto sequence_number = ruuvi_ble::parse_ruuvi_sequence_number(device);
+    if (sequence_number.has_value()) {
+      if (this->last_sequence_number_.has_value() && *this->last_sequence_number_ == *sequence_number)
+        return true;
+      this->last_sequence_number_ = sequence_number;
+    }
+
     auto res = ruuvi_ble::parse_ruuvi(device);
     if (!res.has_value())
       return false;
@@ -76,6 +84,7 @@ class RuuviTag : public Component, public esp32_ble_tracker::ESPBTDeviceListener
   sensor::Sensor *tx_power_{nullptr};
   sensor::Sensor *movement_counter_{nullptr};
   sensor::Sensor *measurement_sequence_number_{nullptr};
+  optional<uint16_t> last_sequence_number_;
 };
 
 }  // namespace ruuvitag
@@ -28,6 +28,7 @@ from esphome.const import (
     CONF_TO,
     CONF_TRIGGER_ID,
     CONF_TYPE,
+    CONF_TYPE_ID,
     CONF_UNIT_OF_MEASUREMENT,
     CONF_WINDOW_SIZE,
     CONF_MQTT_ID,
@@ -244,6 +245,12 @@ CalibratePolynomialFilter = sensor_ns.class_("CalibratePolynomialFilter", Filter
 SensorInRangeCondition = sensor_ns.class_("SensorInRangeCondition", Filter)
 ClampFilter = sensor_ns.class_("ClampFilter", Filter)
 RoundFilter = sensor_ns.class_("RoundFilter", Filter)
+FusedFilter = sensor_ns.class_("FusedFilter", Filter)
+OffsetStage = sensor_ns.struct("OffsetStage")
+MultiplyStage = sensor_ns.struct("MultiplyStage")
+AffineStage = sensor_ns.struct("AffineStage")
+ClampStage = sensor_ns.struct("ClampStage")
+RoundStage = sensor_ns.struct("RoundStage")
 
 validate_unit_of_measurement = cv.string_strict
 validate_accuracy_decimals = cv.int_
@@ -624,6 +631,10 @@ def validate_calibrate_linear(config):
     ),
 )
 async def calibrate_linear_filter_to_code(config, filter_id):
+    return cg.new_Pvariable(filter_id, calibrate_linear_functions(config))
+
+
+def calibrate_linear_functions(config):
     x = [conf[CONF_FROM] for conf in config[CONF_DATAPOINTS]]
     y = [conf[CONF_TO] for conf in config[CONF_DATAPOINTS]]
 
@@ -633,7 +644,7 @@ async def calibrate_linear_filter_to_code(config, filter_id):
         linear_functions = [[k, b, float("NaN")]]
     elif config[CONF_METHOD] == "exact":
         linear_functions = map_linear(x, y)
-    return cg.new_Pvariable(filter_id, linear_functions)
+    return linear_functions
 
 
 CONF_DEGREE = "degree"
@@ -723,8 +734,66 @@ async def round_filter_to_code(config, filter_id):
     )
 
 
+def fused_filter_stage(config):
+    """Return the type and arguments of the FusedFilter stage replacing a filter.
+
+    Returns None for filters keeping state, reading the sensor or running a lambda.
+    """
+    key, value = next((k, v) for k, v in config.items() if k in FILTER_REGISTRY)
+    if key == "offset":
+        return OffsetStage, [value]
+    if key == "multiply":
+        return MultiplyStage, [value]
+    if key == "calibrate_linear":
+        linear_functions = calibrate_linear_functions(value)
+        if len(linear_functions) != 1:
+            return None
+        k, b, _ = linear_functions[0]
+        return AffineStage, [k, b]
+    if key == "clamp":
+        return ClampStage, [
+            value[CONF_MIN_VALUE],
+            value[CONF_MAX_VALUE],
+            value[CONF_IGNORE_OUT_OF_RANGE],
+        ]
+    if key == "round":
+        return RoundStage, [10.0 ** value[CONF_ACCURACY_DECIMALS]]
+    return None
+
+
+def build_fused_filter(configs):
+    # The stages do the same float operations in the same order as the filters
+    # they replace, so the results are identical
+    stages = [fused_filter_stage(conf) for conf in configs]
+    stage_types = [stage_type for stage_type, _ in stages]
+    stage_args = [stage_type(*args) for stage_type, args in stages]
+    # The ID of the first filter names the variable, its type is the fused filter
+    filter_id = configs[0][CONF_TYPE_ID].copy()
+    filter_id.type = FusedFilter
+    return cg.new_Pvariable(
+        filter_id,
+        cg.TemplateArguments(*stage_types),
+        *stage_args,
+    )
+
+
 async def build_filters(config):
-    return await cg.build_registry_list(FILTER_REGISTRY, config)
+    # Runs of two or more filters without state become a single FusedFilter
+    filters = []
+    run = []
+    for conf in config + [None]:
+        if conf is not None and fused_filter_stage(conf) is not None:
+            run.append(conf)
+            continue
+        if len(run) > 1:
+            filters.append(build_fused_filter(run))
+        else:
+            for run_conf in run:
+                filters.append(await cg.build_registry_entry(FILTER_REGISTRY, run_conf))
+        run = []
+        if conf is not None:
+            filters.append(await cg.build_registry_entry(FILTER_REGISTRY, conf))
+    return filters
 
 
 async def setup_sensor_core_(var, config):
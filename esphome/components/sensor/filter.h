@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cmath>
+#include <initializer_list>
 #include <queue>
+#include <tuple>
 #include <utility>
 #include <vector>
+#include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 
@@ -429,5 +433,96 @@ class RoundFilter : public Filter {
   uint8_t precision_;
 };
 
+/// Stage of a FusedFilter doing the same as OffsetFilter.
+struct OffsetStage {
+  constexpr explicit OffsetStage(float offset) : offset(offset) {}
+  bool apply(float &value) const {
+    value = value + this->offset;
+    return true;
+  }
+  float offset;
+};
+
+/// Stage of a FusedFilter doing the same as MultiplyFilter.
+struct MultiplyStage {
+  constexpr explicit MultiplyStage(float multiplier) : multiplier(multiplier) {}
+  bool apply(float &value) const {
+    value = value * this->multiplier;
+    return true;
+  }
+  float multiplier;
+};
+
+/// Stage of a FusedFilter doing the same as a CalibrateLinearFilter with a single function.
+struct AffineStage {
+  constexpr AffineStage(float multiplier, float offset) : multiplier(multiplier), offset(offset) {}
+  bool apply(float &value) const {
+    value = value * this->multiplier + this->offset;
+    return true;
+  }
+  float multiplier;
+  float offset;
+};
+
+/// Stage of a FusedFilter doing the same as ClampFilter.
+struct ClampStage {
+  constexpr ClampStage(float min, float max, bool ignore_out_of_range)
+      : min(min), max(max), ignore_out_of_range(ignore_out_of_range) {}
+  bool apply(float &value) const {
+    if (!std::isfinite(value))
+      return true;
+    if (std::isfinite(this->min) && value < this->min) {
+      value = this->min;
+      return !this->ignore_out_of_range;
+    }
+    if (std::isfinite(this->max) && value > this->max) {
+      value = this->max;
+      return !this->ignore_out_of_range;
+    }
+    return true;
+  }
+  float min;
+  float max;
+  bool ignore_out_of_range;
+};
+
+/// Stage of a FusedFilter doing the same as RoundFilter, with 10^accuracy_decimals worked out up front.
+struct RoundStage {
+  constexpr explicit RoundStage(float accuracy_mult) : accuracy_mult(accuracy_mult) {}
+  bool apply(float &value) const {
+    if (std::isfinite(value))
+      value = roundf(this->accuracy_mult * value) / this->accuracy_mult;
+    return true;
+  }
+  float accuracy_mult;
+};
+
+/** A run of stateless filters applied in a single filter.
+ *
+ * The code generator replaces consecutive filters without state by one of these. Each stage is a plain struct with
+ * an apply() method that returns false to stop the chain, so the whole run is inlined into one call of new_value()
+ * instead of passing the value through a virtual call and an optional per filter.
+ */
+template<typename... Stages> class FusedFilter : public Filter {
+ public:
+  explicit FusedFilter(Stages... stages) : stages_(stages...) {}
+
+  optional<float> new_value(float value) override {
+    if (!this->apply_(value, typename gens<sizeof...(Stages)>::type()))
+      return {};
+    return value;
+  }
+
+ protected:
+  template<int... S> bool apply_(float &value, seq<S...>) const {
+    bool keep = true;
+    // Runs the stages in order, the ones after a stage dropping the value are skipped
+    (void) std::initializer_list<bool>{(keep = keep && std::get<S>(this->stages_).apply(value))...};
+    return keep;
+  }
+
+  std::tuple<Stages...> stages_;
+};
+
 }  // namespace sensor
 }  // namespace esphome
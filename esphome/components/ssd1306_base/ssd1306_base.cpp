@@ -227,7 +227,8 @@ bool SSD1306::is_ssd1305_() const {
   return this->model_ == SSD1305_MODEL_128_64 || this->model_ == SSD1305_MODEL_128_64;
 }
 void SSD1306::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 
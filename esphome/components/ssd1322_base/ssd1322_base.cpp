@@ -122,7 +122,8 @@ void SSD1322::display() {
   this->write_display_data();
 }
 void SSD1322::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 void SSD1322::set_brightness(float brightness) {
@@ -134,7 +134,8 @@ void SSD1325::display() {
   this->write_display_data();
 }
 void SSD1325::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 void SSD1325::set_brightness(float brightness) {
@@ -95,8 +95,7 @@ void SSD1327::display() {
   this->write_display_data();
 }
 void SSD1327::update() {
-  if (!this->is_failed()) {
-    this->do_update_();
+  if (!this->is_failed() && this->do_update_()) {
     this->display();
   }
 }
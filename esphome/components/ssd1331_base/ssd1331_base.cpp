@@ -90,7 +90,8 @@ void SSD1331::display() {
   this->write_display_data();
 }
 void SSD1331::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 void SSD1331::set_brightness(float brightness) {
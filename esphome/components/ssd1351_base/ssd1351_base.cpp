@@ -100,7 +100,8 @@ void SSD1351::display() {
   this->write_display_data();
 }
 void SSD1351::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 void SSD1351::set_brightness(float brightness) {
@@ -53,12 +53,15 @@ void ST7567::request_refresh() {
 }
 
 void ST7567::update() {
-  this->do_update_();
+  bool rendered = this->do_update_();
   if (this->refresh_requested_) {
     this->refresh_requested_ = false;
     this->display_sw_refresh_();
+    // the refresh sequence re-initializes the controller, send the frame again
+    rendered = true;
   }
-  this->write_display_data();
+  if (rendered)
+    this->write_display_data();
 }
 
 void ST7567::set_all_pixels_on(bool enable) {
@@ -292,7 +292,8 @@ void ST7735::setup() {
 }
 
 void ST7735::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->write_display_data_();
 }
 
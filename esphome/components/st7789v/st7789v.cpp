@@ -5,7 +5,7 @@ namespace esphome {
 namespace st7789v {
 
 static const char *const TAG = "st7789v";
-static const size_t TEMP_BUFFER_SIZE = 128;
+static const size_t TEMP_BUFFER_SIZE = 4092;
 
 void ST7789V::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SPI ST7789V...");
@@ -118,6 +118,15 @@ void ST7789V::setup() {
 
   this->init_internal_(this->get_buffer_length_());
   memset(this->buffer_, 0x00, this->get_buffer_length_());
+
+  if (this->eightbitcolor_) {
+    this->converter_.set_rgb332();
+    this->transfer_buffer_ = display::allocate_transfer_buffer(TEMP_BUFFER_SIZE);
+    if (this->transfer_buffer_ == nullptr) {
+      ESP_LOGE(TAG, "Could not allocate transfer buffer!");
+      this->mark_failed();
+    }
+  }
 }
 
 void ST7789V::dump_config() {
@@ -142,7 +151,8 @@ void ST7789V::dump_config() {
 float ST7789V::get_setup_priority() const { return setup_priority::PROCESSOR; }
 
 void ST7789V::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->write_display_data();
 }
 
@@ -172,23 +182,15 @@ void ST7789V::write_display_data() {
   this->dc_pin_->digital_write(true);
 
   if (this->eightbitcolor_) {
-    uint8_t temp_buffer[TEMP_BUFFER_SIZE];
-    size_t temp_index = 0;
-    for (int line = 0; line < this->get_buffer_length_(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
-        auto color = display::ColorUtil::color_to_565(
-            display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
-                                         display::ColorBitness::COLOR_BITNESS_332, true));
-        temp_buffer[temp_index++] = (uint8_t) (color >> 8);
-        temp_buffer[temp_index++] = (uint8_t) color;
-        if (temp_index == TEMP_BUFFER_SIZE) {
-          this->write_array(temp_buffer, TEMP_BUFFER_SIZE);
-          temp_index = 0;
-        }
-      }
+    const uint8_t *src = this->buffer_;
+    size_t rem = this->get_buffer_length_();  // remaining number of pixels
+    while (rem != 0) {
+      size_t count = std::min(rem, TEMP_BUFFER_SIZE / 2);
+      this->converter_.convert_to_565(src, this->transfer_buffer_, count);
+      this->write_array(this->transfer_buffer_, count * 2);
+      src += count;
+      rem -= count;
     }
-    if (temp_index != 0)
-      this->write_array(temp_buffer, temp_index);
   } else {
     this->write_array(this->buffer_, this->get_buffer_length_());
   }
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display/display_color_convert.h"
 #ifdef USE_POWER_SUPPLY
 #include "esphome/components/power_supply/power_supply.h"
 #endif
@@ -145,6 +146,9 @@ class ST7789V : public display::DisplayBuffer,
 #endif
 
   bool eightbitcolor_{false};
+  display::PixelConverter converter_;
+  /// 8 bit color buffers are converted into this buffer before they are sent.
+  uint8_t *transfer_buffer_{nullptr};
   uint16_t height_{0};
   uint16_t width_{0};
   uint16_t offset_height_{0};
@@ -14,10 +14,14 @@ from esphome.core import CORE, coroutine_with_priority
 
 IS_PLATFORM_COMPONENT = True
 
+CONF_STEPPERS = "steppers"
+
 stepper_ns = cg.esphome_ns.namespace("stepper")
 Stepper = stepper_ns.class_("Stepper")
 
 SetTargetAction = stepper_ns.class_("SetTargetAction", automation.Action)
+QueueTargetAction = stepper_ns.class_("QueueTargetAction", automation.Action)
+MoveTogetherAction = stepper_ns.class_("MoveTogetherAction", automation.Action)
 ReportPositionAction = stepper_ns.class_("ReportPositionAction", automation.Action)
 SetSpeedAction = stepper_ns.class_("SetSpeedAction", automation.Action)
 SetAccelerationAction = stepper_ns.class_("SetAccelerationAction", automation.Action)
@@ -108,6 +112,52 @@ async def stepper_set_target_to_code(config, action_id, template_arg, args):
     return var
 
 
+@automation.register_action(
+    "stepper.queue_target",
+    QueueTargetAction,
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.use_id(Stepper),
+            cv.Required(CONF_TARGET): cv.templatable(cv.int_),
+        }
+    ),
+)
+async def stepper_queue_target_to_code(config, action_id, template_arg, args):
+    paren = await cg.get_variable(config[CONF_ID])
+    var = cg.new_Pvariable(action_id, template_arg, paren)
+    template_ = await cg.templatable(config[CONF_TARGET], args, cg.int32)
+    cg.add(var.set_target(template_))
+    return var
+
+
+@automation.register_action(
+    "stepper.move_together",
+    MoveTogetherAction,
+    cv.Schema(
+        {
+            cv.Required(CONF_STEPPERS): cv.All(
+                cv.ensure_list(
+                    cv.Schema(
+                        {
+                            cv.Required(CONF_ID): cv.use_id(Stepper),
+                            cv.Required(CONF_TARGET): cv.templatable(cv.int_),
+                        }
+                    )
+                ),
+                cv.Length(min=1),
+            ),
+        }
+    ),
+)
+async def stepper_move_together_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    for conf in config[CONF_STEPPERS]:
+        stepper_ = await cg.get_variable(conf[CONF_ID])
+        template_ = await cg.templatable(conf[CONF_TARGET], args, cg.int32)
+        cg.add(var.add_stepper(stepper_, template_))
+    return var
+
+
 @automation.register_action(
     "stepper.report_position",
     ReportPositionAction,
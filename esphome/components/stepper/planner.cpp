@@ -0,0 +1,170 @@
+#include "planner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace esphome {
+namespace stepper {
+
+void StepProfile::plan(uint32_t steps, float entry_speed, float exit_speed, float max_speed, float acceleration,
+                       float deceleration) {
+  this->steps_ = steps;
+  this->max_speed_ = max_speed;
+  this->acceleration_ = acceleration;
+  this->deceleration_ = deceleration;
+  // Only what can actually be reached within the move
+  exit_speed = std::min({exit_speed, max_speed, std::sqrt(entry_speed * entry_speed + 2 * acceleration * steps)});
+  this->entry_speed_squared_ = entry_speed * entry_speed;
+  this->exit_speed_squared_ = exit_speed * exit_speed;
+}
+
+float StepProfile::speed_(float done, float remaining) const {
+  const float accelerate = std::sqrt(this->entry_speed_squared_ + 2 * this->acceleration_ * done);
+  const float decelerate = std::sqrt(this->exit_speed_squared_ + 2 * this->deceleration_ * remaining);
+  return std::min({accelerate, this->max_speed_, decelerate});
+}
+
+uint32_t StepProfile::interval_us(uint32_t index) const {
+  const uint32_t remaining = this->steps_ - index;
+  float speed = (this->speed_(index, remaining) + this->speed_(index + 1, remaining - 1)) / 2;
+  if (speed <= 0.0f) {
+    // Single step from and to standstill, the speed only builds up in between
+    speed = this->speed_(index + 0.5f, remaining - 0.5f) / 2;
+  }
+  if (speed <= 0.0f)
+    return std::numeric_limits<uint32_t>::max();
+  return std::min(1e6f / speed, 4e9f);
+}
+
+uint32_t StepProfile::get_accelerate_steps() const {
+  if (this->steps_ == 0)
+    return 0;
+  // Where the deceleration curve crosses the lower of the acceleration curve and the cruise speed
+  const float peak_squared = std::min(
+      this->max_speed_ * this->max_speed_,
+      (this->entry_speed_squared_ * this->deceleration_ + this->exit_speed_squared_ * this->acceleration_ +
+       2 * this->acceleration_ * this->deceleration_ * this->steps_) /
+          (this->acceleration_ + this->deceleration_));
+  const float decelerate = (peak_squared - this->exit_speed_squared_) / (2 * this->deceleration_);
+  return this->steps_ - std::min<uint32_t>(std::max(decelerate, 0.0f), this->steps_);
+}
+
+uint32_t StepProfile::get_decelerate_steps() const { return this->steps_ - this->get_accelerate_steps(); }
+
+void plan_moves(std::vector<PlannedMove> &moves, float entry_speed) {
+  if (moves.empty())
+    return;
+
+  // Highest possible speed at every junction, the last move stops
+  for (size_t i = 0; i < moves.size(); i++) {
+    auto &move = moves[i];
+    move.exit_speed = 0.0f;
+    if (i + 1 < moves.size()) {
+      const auto &next = moves[i + 1];
+      if ((move.steps > 0) == (next.steps > 0) && move.steps != 0 && next.steps != 0)
+        move.exit_speed = std::min(move.max_speed, next.max_speed);
+    }
+  }
+
+  // Backward pass: every move has to be able to slow down to its exit speed
+  for (size_t i = moves.size() - 1; i > 0; i--) {
+    const auto &move = moves[i];
+    const float steps = std::abs(move.steps);
+    const float reachable = std::sqrt(move.exit_speed * move.exit_speed + 2 * move.deceleration * steps);
+    moves[i - 1].exit_speed = std::min(moves[i - 1].exit_speed, reachable);
+  }
+
+  // Forward pass: and to speed up to it
+  float speed = entry_speed;
+  for (auto &move : moves) {
+    move.entry_speed = speed;
+    const float steps = std::abs(move.steps);
+    const float reachable = std::sqrt(speed * speed + 2 * move.acceleration * steps);
+    move.exit_speed = std::min(move.exit_speed, reachable);
+    speed = move.exit_speed;
+  }
+}
+
+void plan_segments(const std::deque<Waypoint> &waypoints, size_t first, const PlanStart &start, SegmentPlan &plan) {
+  std::vector<PlannedMove> moves;
+  std::vector<uint8_t> ends;
+  moves.reserve(SegmentPlan::MAX_SEGMENTS);
+  ends.reserve(SegmentPlan::MAX_SEGMENTS);
+  int32_t position = start.position;
+  plan.skipped = 0;
+  plan.planned = 0;
+
+  if (start.speed > 0.0f) {
+    // Stop first when the next target is behind or too close to slow down for, and come back from there
+    const StepProfile &profile = start.running->profile;
+    const int32_t direction = start.running->forward ? 1 : -1;
+    const bool any = first < waypoints.size();
+    const float deceleration = any ? waypoints[first].deceleration : profile.get_deceleration();
+    const auto stopping = static_cast<int32_t>(std::ceil(start.speed * start.speed / (2 * deceleration)));
+    const int64_t ahead = any ? int64_t(waypoints[first].target - position) * direction : 0;
+    if (ahead < stopping) {
+      moves.push_back(
+          PlannedMove{direction * stopping, profile.get_max_speed(), profile.get_acceleration(), deceleration});
+      ends.push_back(0);
+      position += direction * stopping;
+    }
+  }
+
+  for (size_t i = first; i < waypoints.size(); i++) {
+    const Waypoint &waypoint = waypoints[i];
+    const int32_t steps = waypoint.target - position;
+    if (steps == 0) {
+      // Reached along with the move before, or right away
+      if (moves.empty()) {
+        plan.skipped++;
+      } else {
+        ends.back()++;
+        plan.planned++;
+      }
+      continue;
+    }
+    if (moves.size() == SegmentPlan::MAX_SEGMENTS)
+      break;
+    moves.push_back(PlannedMove{steps, waypoint.max_speed, waypoint.acceleration, waypoint.deceleration});
+    ends.push_back(1);
+    position = waypoint.target;
+    plan.planned++;
+  }
+  plan_moves(moves, start.speed);
+
+  for (size_t i = 0; i < moves.size(); i++) {
+    const PlannedMove &move = moves[i];
+    StepSegment &segment = plan.segments[i];
+    segment.profile.plan(std::abs(move.steps), move.entry_speed, move.exit_speed, move.max_speed, move.acceleration,
+                         move.deceleration);
+    segment.forward = move.steps > 0;
+    segment.waypoints = ends[i];
+  }
+  plan.count = moves.size();
+}
+
+void coordinate_axes(std::vector<AxisMove> &axes) {
+  // In a move normalised to a length of 1 an axis covers its steps, so its speed is its steps times the common one
+  float speed = std::numeric_limits<float>::max();
+  float acceleration = std::numeric_limits<float>::max();
+  float deceleration = std::numeric_limits<float>::max();
+  for (const auto &axis : axes) {
+    if (axis.steps == 0)
+      continue;
+    speed = std::min(speed, axis.max_speed / axis.steps);
+    acceleration = std::min(acceleration, axis.acceleration / axis.steps);
+    deceleration = std::min(deceleration, axis.deceleration / axis.steps);
+  }
+  for (auto &axis : axes) {
+    if (axis.steps == 0)
+      continue;
+    axis.max_speed = speed * axis.steps;
+    axis.acceleration = acceleration * axis.steps;
+    axis.deceleration = deceleration * axis.steps;
+  }
+}
+
+}  // namespace stepper
+}  // namespace esphome
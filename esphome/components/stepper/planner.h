@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace esphome {
+namespace stepper {
+
+/** Trapezoidal speed profile of a single move in one direction.
+ *
+ * The speed at each position is the lowest of accelerating from the entry speed, the cruise speed and decelerating
+ * towards the exit speed, so a move too short to reach the cruise speed becomes a triangle by itself. Speeds are in
+ * steps/s, accelerations in steps/s^2.
+ */
+class StepProfile {
+ public:
+  void plan(uint32_t steps, float entry_speed, float exit_speed, float max_speed, float acceleration,
+            float deceleration);
+
+  uint32_t get_steps() const { return this->steps_; }
+  float get_max_speed() const { return this->max_speed_; }
+  float get_acceleration() const { return this->acceleration_; }
+  float get_deceleration() const { return this->deceleration_; }
+  /// Speed after the given number of steps.
+  float speed_at(uint32_t step) const { return this->speed_(step, this->steps_ - step); }
+  /** Time from step index to the next one in µs, index 0 being the start of the move.
+   *
+   * Under constant acceleration the time for a step is its length over the mean of the speeds at both ends, which
+   * unlike a difference of absolute times stays exact in float far into long moves.
+   */
+  uint32_t interval_us(uint32_t index) const;
+  /// Number of steps spent accelerating and cruising, the rest of the move decelerates.
+  uint32_t get_accelerate_steps() const;
+  uint32_t get_decelerate_steps() const;
+
+ protected:
+  /// Speed with done steps behind and remaining steps ahead, both kept apart for float precision in long moves.
+  float speed_(float done, float remaining) const;
+
+  uint32_t steps_{0};
+  float entry_speed_squared_{0.0f};
+  float exit_speed_squared_{0.0f};
+  float max_speed_{0.0f};
+  float acceleration_{0.0f};
+  float deceleration_{0.0f};
+};
+
+/// A move in a queue of moves.
+struct PlannedMove {
+  /// Signed by direction.
+  int32_t steps;
+  float max_speed;
+  float acceleration;
+  float deceleration;
+  /// Filled in by plan_moves().
+  float entry_speed{0.0f};
+  float exit_speed{0.0f};
+};
+
+/** Choose the entry and exit speeds of consecutive moves.
+ *
+ * Moves in the same direction are joined at the lower of both maximum speeds as far as acceleration and deceleration
+ * allow, a change of direction and the end of the queue stop. The first move is entered at entry_speed.
+ */
+void plan_moves(std::vector<PlannedMove> &moves, float entry_speed);
+
+/// Target of a queued move with the limits it is planned with.
+struct Waypoint {
+  int32_t target;
+  float max_speed;
+  float acceleration;
+  float deceleration;
+};
+
+/// A move in one direction as the step timer runs it.
+struct StepSegment {
+  StepProfile profile;
+  bool forward;
+  /// Waypoints reached at the end of the segment.
+  uint8_t waypoints;
+};
+
+/// Motion a plan continues from.
+struct PlanStart {
+  int32_t position;
+  float speed;
+  /// Segment moving at that speed, only used when the speed is above 0.
+  const StepSegment *running;
+};
+
+/// Segments planned by plan_segments().
+struct SegmentPlan {
+  static const uint8_t MAX_SEGMENTS = 4;
+
+  StepSegment segments[MAX_SEGMENTS];
+  uint8_t count{0};
+  /// Waypoints at the front of the queue that are reached without moving.
+  uint8_t skipped{0};
+  /// Waypoints reached by the end of the segments.
+  uint8_t planned{0};
+};
+
+/** Plan the queued waypoints from first on into segments, continuing the given motion.
+ *
+ * A move that can not slow down in time for the next waypoint, or is heading away from it, stops first and comes back
+ * from there. Waypoints that do not fit into the segments are left for a later plan.
+ */
+void plan_segments(const std::deque<Waypoint> &waypoints, size_t first, const PlanStart &start, SegmentPlan &plan);
+
+/// Limits of one axis of a coordinated move, scaled in place by coordinate_axes().
+struct AxisMove {
+  uint32_t steps;
+  float max_speed;
+  float acceleration;
+  float deceleration;
+};
+
+/** Scale the limits of axes moving together so that they start and finish at the same time.
+ *
+ * All axes follow one profile scaled by their number of steps, the slowest axis sets the pace.
+ */
+void coordinate_axes(std::vector<AxisMove> &axes);
+
+}  // namespace stepper
+}  // namespace esphome
@@ -0,0 +1,224 @@
+#include "step_timer.h"
+
+#ifdef USE_STEP_TIMER
+
+#include <algorithm>
+
+namespace esphome {
+namespace stepper {
+
+/// Step pulse width, well above the 1-2 µs the usual drivers need.
+static const uint32_t STEP_PULSE_US = 3;
+
+TimedStepGenerator::TimedStepGenerator(InternalGPIOPin *step_pin, InternalGPIOPin *dir_pin)
+    : step_pin_(step_pin->to_isr()), dir_pin_(dir_pin->to_isr()) {}
+
+void TimedStepGenerator::set_target(const Waypoint &waypoint) {
+  this->waypoints_.clear();
+  // Waypoints the timer still reaches belong to the old plan
+  this->planned_waypoints_ = 0;
+  this->waypoints_.push_back(waypoint);
+  this->replan_();
+}
+
+void TimedStepGenerator::queue_target(const Waypoint &waypoint) {
+  this->waypoints_.push_back(waypoint);
+  if (this->segment_count_ < MAX_SEGMENTS)
+    this->replan_();
+}
+
+void TimedStepGenerator::set_limits(float max_speed, float acceleration, float deceleration) {
+  for (auto &waypoint : this->waypoints_) {
+    waypoint.max_speed = max_speed;
+    waypoint.acceleration = acceleration;
+    waypoint.deceleration = deceleration;
+  }
+  this->replan_();
+}
+
+void TimedStepGenerator::set_position(int32_t position) {
+  StepTimer *timer = StepTimer::get();
+  timer->lock();
+  this->position_ = position;
+  timer->unlock();
+  this->replan_();
+}
+
+void TimedStepGenerator::loop() {
+  this->drop_reached_();
+  if (this->waypoints_.size() > this->planned_waypoints_ && this->segment_count_ < MAX_SEGMENTS)
+    this->replan_();
+}
+
+void TimedStepGenerator::drop_reached_() {
+  StepTimer *timer = StepTimer::get();
+  timer->lock();
+  const uint8_t reached = std::min(this->reached_, this->planned_waypoints_);
+  this->reached_ = 0;
+  timer->unlock();
+
+  this->planned_waypoints_ -= reached;
+  this->waypoints_.erase(this->waypoints_.begin(), this->waypoints_.begin() + reached);
+}
+
+void TimedStepGenerator::replan_() {
+  StepTimer *timer = StepTimer::get();
+  SegmentPlan plan;
+  uint8_t reached;
+  bool running;
+  while (true) {
+    // Where the timer is now, the plan continues from there
+    timer->lock();
+    reached = std::min(this->reached_, this->planned_waypoints_);
+    const uint8_t head = this->segment_head_;
+    const uint8_t count = this->segment_count_;
+    const uint32_t step_index = this->step_index_;
+    const StepSegment current = this->segments_[head];
+    const int32_t position = this->position_;
+    timer->unlock();
+
+    // The float work runs with interrupts on, the timer keeps stepping the old plan meanwhile
+    running = count != 0;
+    const float speed = running ? current.profile.speed_at(step_index) : 0.0f;
+    plan_segments(this->waypoints_, reached, PlanStart{position, speed, &current}, plan);
+
+    timer->lock();
+    // Steps taken since then count into the new first segment, which starts in the same direction at the same speed
+    const bool same_segment = this->segment_head_ == head && this->segment_count_ == count;
+    const uint32_t taken = same_segment ? this->step_index_ - step_index : 0;
+    if (!same_segment ||
+        (taken != 0 && (plan.count == 0 || plan.segments[0].forward != current.forward ||
+                        taken >= plan.segments[0].profile.get_steps()))) {
+      // The timer finished a segment meanwhile, start over from there
+      timer->unlock();
+      continue;
+    }
+    std::copy(plan.segments, plan.segments + plan.count, this->segments_);
+    this->segment_head_ = 0;
+    this->segment_count_ = plan.count;
+    this->step_index_ = taken;
+    this->reached_ = 0;
+    if (plan.count != 0) {
+      // A running move has its next step scheduled already, it becomes the next step of the new plan
+      this->dir_pin_.digital_write(this->segments_[0].forward);
+      if (!running)
+        this->next_step_at_ = timer->get_start_time() + this->segments_[0].profile.interval_us(0);
+    }
+    timer->unlock();
+    break;
+  }
+
+  this->planned_waypoints_ = plan.planned;
+  this->waypoints_.erase(this->waypoints_.begin(), this->waypoints_.begin() + reached + plan.skipped);
+  timer->schedule();
+}
+
+void TimedStepGenerator::finish_step_() {
+  this->step_pin_.digital_write(false);
+  this->stepping_ = false;
+  const Segment *segment = &this->segments_[this->segment_head_];
+  this->position_ += segment->forward ? 1 : -1;
+  if (++this->step_index_ >= segment->profile.get_steps()) {
+    this->reached_ += segment->waypoints;
+    this->segment_head_ = (this->segment_head_ + 1) % MAX_SEGMENTS;
+    this->step_index_ = 0;
+    if (--this->segment_count_ == 0)
+      return;
+    segment = &this->segments_[this->segment_head_];
+    this->dir_pin_.digital_write(segment->forward);
+  }
+  // From the time the step was due rather than when it happened, so a late timer does not slow down the move
+  this->next_step_at_ += segment->profile.interval_us(this->step_index_);
+}
+
+StepTimer *StepTimer::get() {
+  static StepTimer *const INSTANCE = new StepTimer();  // NOLINT(cppcoreguidelines-owning-memory)
+  return INSTANCE;
+}
+
+bool StepTimer::add(TimedStepGenerator *generator) {
+  if (this->timer_ == nullptr) {
+    esp_timer_create_args_t args{};
+    args.callback = &StepTimer::timer_callback_;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "stepper";
+    if (esp_timer_create(&args, &this->timer_) != ESP_OK) {
+      this->timer_ = nullptr;
+      return false;
+    }
+  }
+  this->lock();
+  this->generators_.push_back(generator);
+  this->unlock();
+  return true;
+}
+
+void StepTimer::begin_batch() {
+  this->batch_start_ = esp_timer_get_time();
+  this->batch_ = true;
+}
+
+void StepTimer::end_batch() {
+  this->batch_ = false;
+  this->schedule();
+}
+
+int64_t StepTimer::get_start_time() const { return this->batch_ ? this->batch_start_ : esp_timer_get_time(); }
+
+void StepTimer::schedule() {
+  if (this->batch_)
+    return;
+  this->lock();
+  const int64_t next = this->next_step_at_();
+  this->unlock();
+  this->arm_(next);
+}
+
+void StepTimer::timer_callback_(void *arg) { static_cast<StepTimer *>(arg)->run_(); }
+
+void StepTimer::run_() {
+  this->lock();
+  const int64_t now = esp_timer_get_time();
+  // Everything due shares one pulse
+  bool stepping = false;
+  for (auto *generator : this->generators_) {
+    if (generator->step_due_(now)) {
+      generator->step_pin_.digital_write(true);
+      generator->stepping_ = true;
+      stepping = true;
+    }
+  }
+  if (stepping) {
+    delayMicroseconds(STEP_PULSE_US);
+    for (auto *generator : this->generators_) {
+      if (generator->stepping_)
+        generator->finish_step_();
+    }
+  }
+  const int64_t next = this->next_step_at_();
+  this->unlock();
+  this->arm_(next);
+}
+
+int64_t StepTimer::next_step_at_() const {
+  int64_t next = 0;
+  for (auto *generator : this->generators_) {
+    if (generator->segment_count_ != 0 && (next == 0 || generator->next_step_at_ < next))
+      next = generator->next_step_at_;
+  }
+  return next;
+}
+
+void StepTimer::arm_(int64_t at) {
+  if (this->timer_ == nullptr || at == 0)
+    return;
+  // Either side may have armed it meanwhile, firing early only finds nothing due and re-arms
+  esp_timer_stop(this->timer_);
+  esp_timer_start_once(this->timer_, std::max<int64_t>(at - esp_timer_get_time(), 0));
+}
+
+}  // namespace stepper
+}  // namespace esphome
+
+#endif  // USE_STEP_TIMER
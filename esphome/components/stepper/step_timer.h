@@ -0,0 +1,111 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_STEP_TIMER
+
+#include <deque>
+#include <vector>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include "esphome/core/hal.h"
+#include "planner.h"
+
+namespace esphome {
+namespace stepper {
+
+/** Step and direction pulses of one driver, generated by the StepTimer instead of the main loop.
+ *
+ * The main loop plans the moves to the queued waypoints into a few segments ahead, the timer only evaluates the step
+ * interval of the running segment and toggles the pins, so steps keep their timing however long other components
+ * block the loop.
+ */
+class TimedStepGenerator {
+ public:
+  TimedStepGenerator(InternalGPIOPin *step_pin, InternalGPIOPin *dir_pin);
+
+  /// Drop all queued moves and move to the waypoint, slowing down first where needed.
+  void set_target(const Waypoint &waypoint);
+  /// Move to the waypoint after the queued ones, without stopping in between where the direction stays the same.
+  void queue_target(const Waypoint &waypoint);
+  /// Apply new limits to all queued waypoints.
+  void set_limits(float max_speed, float acceleration, float deceleration);
+  void set_position(int32_t position);
+  int32_t get_position() const { return this->position_; }
+  bool is_moving() const { return this->segment_count_ != 0; }
+
+  /// Called from the main loop, plans the waypoints that did not fit into the segment queue yet.
+  void loop();
+
+ protected:
+  friend class StepTimer;
+
+  static const uint8_t MAX_SEGMENTS = SegmentPlan::MAX_SEGMENTS;
+
+  /// Rebuild the segment queue from the current speed and position, planned with the timer running.
+  void replan_();
+  /// Drop the waypoints the timer reached.
+  void drop_reached_();
+
+  bool step_due_(int64_t now) const { return this->segment_count_ != 0 && now >= this->next_step_at_; }
+  /// Lower the step pin after the pulse, account for the step and schedule the next one.
+  void finish_step_();
+
+  ISRInternalGPIOPin step_pin_;
+  ISRInternalGPIOPin dir_pin_;
+  /// Main loop only, the timer counts the waypoints it reached in reached_.
+  std::deque<Waypoint> waypoints_;
+  uint8_t planned_waypoints_{0};
+
+  // Shared with the timer, under the lock.
+  StepSegment segments_[MAX_SEGMENTS];
+  uint8_t segment_head_{0};
+  uint8_t segment_count_{0};
+  uint32_t step_index_{0};
+  int64_t next_step_at_{0};
+  uint8_t reached_{0};
+  volatile int32_t position_{0};
+  bool stepping_{false};
+};
+
+/** One esp_timer shared by all timed steppers, armed for the earliest step that is due.
+ *
+ * Steps of several drivers due at the same time share a single pulse, and moves started within a batch share their
+ * start time, which keeps coordinated axes in step.
+ */
+class StepTimer {
+ public:
+  static StepTimer *get();
+
+  bool add(TimedStepGenerator *generator);
+
+  /// Plan several moves to start at the same time, the timer is only armed by end_batch().
+  void begin_batch();
+  void end_batch();
+
+  /// Taken by the timer while stepping, interrupts are off so anything under it must not allocate or block.
+  void lock() { portENTER_CRITICAL(&this->lock_); }
+  void unlock() { portEXIT_CRITICAL(&this->lock_); }
+  /// Start time of a move planned now.
+  int64_t get_start_time() const;
+  /// Re-arm the timer after a plan changed.
+  void schedule();
+
+ protected:
+  static void timer_callback_(void *arg);
+  void run_();
+  /// Earliest step due, 0 when all steppers are idle, with the lock held.
+  int64_t next_step_at_() const;
+  void arm_(int64_t at);
+
+  std::vector<TimedStepGenerator *> generators_;
+  esp_timer_handle_t timer_{nullptr};
+  portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+  bool batch_{false};
+  int64_t batch_start_{0};
+};
+
+}  // namespace stepper
+}  // namespace esphome
+
+#endif  // USE_STEP_TIMER
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <cstdlib>
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/defines.h"
 #include "esphome/components/stepper/stepper.h"
+#include "planner.h"
+
+#ifdef USE_STEP_TIMER
+#include "step_timer.h"
+#endif
 
 namespace esphome {
 namespace stepper {
@@ -20,7 +27,16 @@ class Stepper {
   void set_deceleration(float deceleration) { this->deceleration_ = deceleration; }
   void set_max_speed(float max_speed) { this->max_speed_ = max_speed; }
   virtual void on_update_speed() {}
+  /// Move to steps once the current target is reached, steppers that can't queue moves just change the target.
+  virtual void queue_target(int32_t steps) { this->set_target(steps); }
+  /// Move to steps with other limits than the configured ones, used to move several steppers together.
+  virtual void set_target_with_limits(int32_t steps, float max_speed, float acceleration, float deceleration) {
+    this->set_target(steps);
+  }
   bool has_reached_target() { return this->current_position == this->target_position; }
+  float get_acceleration() const { return this->acceleration_; }
+  float get_deceleration() const { return this->deceleration_; }
+  float get_max_speed() const { return this->max_speed_; }
 
   int32_t current_position{0};
   int32_t target_position{0};
@@ -49,6 +65,56 @@ template<typename... Ts> class SetTargetAction : public Action<Ts...> {
   Stepper *parent_;
 };
 
+template<typename... Ts> class QueueTargetAction : public Action<Ts...> {
+ public:
+  explicit QueueTargetAction(Stepper *parent) : parent_(parent) {}
+
+  TEMPLATABLE_VALUE(int32_t, target)
+
+  void play(Ts... x) override { this->parent_->queue_target(this->target_.value(x...)); }
+
+ protected:
+  Stepper *parent_;
+};
+
+/// Move several steppers at once so that they start and arrive at the same time.
+template<typename... Ts> class MoveTogetherAction : public Action<Ts...> {
+ public:
+  void add_stepper(Stepper *stepper, TemplatableValue<int32_t, Ts...> target) {
+    this->moves_.push_back(Move{stepper, target});
+  }
+
+  void play(Ts... x) override {
+    std::vector<int32_t> targets;
+    std::vector<AxisMove> axes;
+    for (auto &move : this->moves_) {
+      const int32_t target = move.target.value(x...);
+      targets.push_back(target);
+      axes.push_back(AxisMove{static_cast<uint32_t>(std::abs(target - move.stepper->current_position)),
+                              move.stepper->get_max_speed(), move.stepper->get_acceleration(),
+                              move.stepper->get_deceleration()});
+    }
+    coordinate_axes(axes);
+#ifdef USE_STEP_TIMER
+    StepTimer::get()->begin_batch();
+#endif
+    for (size_t i = 0; i < this->moves_.size(); i++) {
+      this->moves_[i].stepper->set_target_with_limits(targets[i], axes[i].max_speed, axes[i].acceleration,
+                                                      axes[i].deceleration);
+    }
+#ifdef USE_STEP_TIMER
+    StepTimer::get()->end_batch();
+#endif
+  }
+
+ protected:
+  struct Move {
+    Stepper *stepper;
+    TemplatableValue<int32_t, Ts...> target;
+  };
+  std::vector<Move> moves_;
+};
+
 template<typename... Ts> class ReportPositionAction : public Action<Ts...> {
  public:
   explicit ReportPositionAction(Stepper *parent) : parent_(parent) {}
@@ -41,6 +41,15 @@ void SX1509Component::dump_config() {
 }
 
 void SX1509Component::loop() {
+  if (this->i_on_registers_.is_dirty()) {
+    if (this->i_on_registers_.flush(this) != i2c::ERROR_OK) {
+      this->status_set_warning();
+    } else {
+      this->status_clear_warning();
+    }
+  }
+  this->i_on_registers_.log_stats(TAG);
+
   if (this->has_keypad_) {
     if (millis() - this->last_loop_timestamp_ < min_loop_period_)
       return;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/components/i2c/register_batch.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
 #include "sx1509_gpio_pin.h"
@@ -38,7 +39,8 @@ class SX1509Component : public Component, public i2c::I2CDevice {
 
   bool digital_read(uint8_t pin);
   uint16_t read_key_data();
-  void set_pin_value(uint8_t pin, uint8_t i_on) { this->write_byte(REG_I_ON[pin], i_on); };
+  /// Written by the next loop(), together with the other pins changed meanwhile.
+  void set_pin_value(uint8_t pin, uint8_t i_on) { this->i_on_registers_.set(REG_I_ON[pin] - REG_I_ON_0, i_on); };
   void pin_mode(uint8_t pin, gpio::Flags flags);
   void digital_write(uint8_t pin, bool bit_value);
   uint32_t get_clock() { return this->clk_x_; };
@@ -69,6 +71,8 @@ class SX1509Component : public Component, public i2c::I2CDevice {
   uint8_t scan_time_ = 1;
   uint8_t debounce_time_ = 1;
   std::vector<SX1509Processor *> keypad_binary_sensors_;
+  /// RegIOn0 to RegIOn15, with the other LED driver registers in between.
+  i2c::RegisterBatch i_on_registers_{REG_I_ON_0, REG_I_ON_15 - REG_I_ON_0 + 1};
 
   uint32_t last_loop_timestamp_ = 0;
   const uint32_t min_loop_period_ = 15;  // ms
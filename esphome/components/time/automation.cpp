@@ -10,6 +10,8 @@ namespace time {
 static const char *const TAG = "automation";
 static const int MAX_TIMESTAMP_DRIFT = 900;  // how far can the clock drift before we consider
                                              // there has been a drastic time synchronization
+// The loop sleeps after a new second was seen and resumes this many milliseconds before the next one is expected
+static const uint32_t CRON_WAKE_EARLY = 50;
 
 void CronTrigger::add_second(uint8_t second) { this->seconds_[second] = true; }
 void CronTrigger::add_minute(uint8_t minute) { this->minutes_[minute] = true; }
@@ -60,6 +62,10 @@ void CronTrigger::loop() {
 
   if (this->matches(time))
     this->trigger();
+
+  // Nothing to do until the next second, poll again shortly before it starts
+  this->disable_loop();
+  this->set_timeout("next_second", 1000 - CRON_WAKE_EARLY, [this]() { this->enable_loop(); });
 }
 CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) {}
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
@@ -120,22 +120,26 @@ void TLC59208FOutput::dump_config() {
 }
 
 void TLC59208FOutput::loop() {
-  if (this->min_channel_ == 0xFF || !this->update_)
+  if (this->min_channel_ == 0xFF)
     return;
 
-  for (uint8_t channel = this->min_channel_; channel <= this->max_channel_; channel++) {
-    uint8_t pwm = this->pwm_amounts_[channel];
-    ESP_LOGVV(TAG, "Channel %02u: pwm=%04u ", channel, pwm);
+  if (this->update_) {
+    for (uint8_t channel = this->min_channel_; channel <= this->max_channel_; channel++) {
+      uint8_t pwm = this->pwm_amounts_[channel];
+      ESP_LOGVV(TAG, "Channel %02u: pwm=%04u ", channel, pwm);
+      this->pwm_registers_.set(channel, pwm);
+    }
+    this->update_ = false;
+  }
 
-    uint8_t reg = TLC59208F_REG_PWM0 + channel;
-    if (!this->write_byte(reg, pwm)) {
+  if (this->pwm_registers_.is_dirty()) {
+    if (this->pwm_registers_.flush(this) != i2c::ERROR_OK) {
       this->status_set_warning();
       return;
     }
+    this->status_clear_warning();
   }
-
-  this->status_clear_warning();
-  this->update_ = false;
+  this->pwm_registers_.log_stats(TAG);
 }
 
 void TLC59208FOutput::register_channel(TLC59208FChannel *channel) {
@@ -4,6 +4,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/components/output/float_output.h"
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/components/i2c/register_batch.h"
 
 namespace esphome {
 namespace tlc59208f {
@@ -63,6 +64,9 @@ class TLC59208FOutput : public Component, public i2c::I2CDevice {
       0,
   };
   bool update_{true};
+  /// PWM0 to PWM7. The auto-increment mode is chosen by bits 7:5 of the register address rather than MODE1, 101 rolls
+  /// over the individual brightness registers.
+  i2c::RegisterBatch pwm_registers_{0xA2, 8};
 };
 
 }  // namespace tlc59208f
@@ -0,0 +1,81 @@
+import hashlib
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import (
+    CONF_ID,
+    CONF_SIZE,
+    PLATFORM_ESP32,
+    PLATFORM_ESP8266,
+    PLATFORM_HOST,
+)
+from esphome.core import CORE, HexInt, coroutine_with_priority
+
+CODEOWNERS = ["@esphome/core"]
+
+CONF_WARM_STATE = "warm_state"
+KEY_WARM_STATE = "warm_state"
+
+warm_state_ns = cg.esphome_ns.namespace("warm_state")
+WarmStateComponent = warm_state_ns.class_("WarmStateComponent", cg.Component)
+
+
+def validate_size(value):
+    value = cv.int_range(min=16, max=4096)(value)
+    # RTC user memory on the ESP8266 is only 512 bytes and shared with other preferences
+    if CORE.is_esp8266 and value > 256:
+        raise cv.Invalid("The ESP8266 can keep at most 256 bytes of warm state")
+    return value
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(WarmStateComponent),
+            cv.SplitDefault(CONF_SIZE, esp8266=96, esp32=256, host=256): validate_size,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_HOST]),
+)
+
+
+def rtc_words(size):
+    """Words of RTC user memory the region takes as an ESP8266 preference."""
+    # Version, length and CRC of the region, plus the CRC word of the preference
+    return (8 + size + 3) // 4 + 1
+
+
+async def register_warm_state(var, config):
+    """Keep the state of the component var across deep sleep and safe reboots.
+
+    Does nothing unless the warm_state component is configured. The component
+    has to implement the warm state hooks of Component.
+    """
+    if CONF_WARM_STATE not in CORE.config:
+        return
+    parent = await cg.get_variable(CORE.config[CONF_WARM_STATE][CONF_ID])
+    CORE.data.setdefault(KEY_WARM_STATE, []).append(
+        f"{config[CONF_ID].type}:{config[CONF_ID].id}"
+    )
+    cg.add(parent.register_component(var))
+
+
+@coroutine_with_priority(-999.0)
+async def _finalize_layout(var, config):
+    # Every registered component (in order) and the region size define the layout,
+    # any change to them has to invalidate warm state saved by another firmware
+    layout = "\n".join(
+        [str(config[CONF_SIZE])] + CORE.data.setdefault(KEY_WARM_STATE, [])
+    )
+    version = int.from_bytes(hashlib.sha256(layout.encode()).digest()[:4], "little")
+    cg.add(var.set_layout_version(HexInt(version or 1)))
+    cg.add(var.restore())
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add_define("USE_WARM_STATE")
+    cg.add_define("WARM_STATE_SIZE", config[CONF_SIZE])
+    CORE.add_job(_finalize_layout, var, config)
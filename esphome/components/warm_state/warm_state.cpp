@@ -0,0 +1,122 @@
+#include "warm_state.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+
+#ifdef USE_ESP32
+#include <esp_attr.h>
+#endif
+
+namespace esphome {
+namespace warm_state {
+
+static const char *const TAG = "warm_state";
+
+#if defined(USE_ESP32)
+// Not initialized on any reset, survives deep sleep and software resets
+static RTC_NOINIT_ATTR WarmStateRegion rtc_region;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#elif defined(USE_HOST)
+// Simulated RTC region, survives as long as the process does
+static WarmStateRegion rtc_region;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
+void WarmStateComponent::restore() {
+  // Runs before the logger is set up, results are reported in dump_config()
+  const WarmStateRegion &region = this->region_;
+  if (!this->load_region_() || region.version != this->layout_version_ || region.length > WARM_STATE_SIZE ||
+      crc16(region.data, region.length) != region.crc)
+    return;
+
+  size_t offset = 0;
+  for (auto *component : this->components_) {
+    if (offset + 2 > region.length)
+      break;
+    const uint16_t size = encode_uint16(region.data[offset + 1], region.data[offset]);
+    offset += 2;
+    if (offset + size > region.length)
+      break;
+    if (size != 0 && size == component->get_warm_state_size() && component->restore_warm_state(&region.data[offset])) {
+      component->set_warm_start(true);
+      this->restored_++;
+    }
+    offset += size;
+  }
+
+  // The state is only valid for the boot right after a safe shutdown, never restore it twice
+  this->invalidate();
+}
+
+void WarmStateComponent::save() {
+  WarmStateRegion &region = this->region_;
+  size_t offset = 0;
+  for (auto *component : this->components_) {
+    if (offset + 2 > WARM_STATE_SIZE) {
+      ESP_LOGW(TAG, "Region full, %s and following components will start cold", component->get_component_source());
+      break;
+    }
+    uint16_t size = component->get_warm_state_size();
+    if (offset + 2 + size > WARM_STATE_SIZE) {
+      ESP_LOGW(TAG, "Warm state of %s does not fit (%u bytes)", component->get_component_source(), size);
+      size = 0;
+    }
+    region.data[offset++] = size & 0xFF;
+    region.data[offset++] = size >> 8;
+    if (size != 0)
+      component->save_warm_state(&region.data[offset]);
+    offset += size;
+  }
+  region.version = this->layout_version_;
+  region.length = offset;
+  region.crc = crc16(region.data, offset);
+  if (!this->save_region_()) {
+    ESP_LOGW(TAG, "Could not save warm state");
+    return;
+  }
+  ESP_LOGD(TAG, "Saved warm state of %zu components (%zu bytes)", this->components_.size(), offset);
+}
+
+void WarmStateComponent::invalidate() {
+  this->region_.version = 0;
+  this->region_.length = 0;
+  this->save_region_();
+}
+
+void WarmStateComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Warm State:");
+  ESP_LOGCONFIG(TAG, "  Size: %u bytes", WARM_STATE_SIZE);
+  ESP_LOGCONFIG(TAG, "  Layout Version: 0x%08" PRIX32, this->layout_version_);
+  ESP_LOGCONFIG(TAG, "  Restored: %u of %zu components", this->restored_, this->components_.size());
+}
+
+void WarmStateComponent::on_safe_shutdown() { this->save(); }
+
+bool WarmStateComponent::load_region_() {
+#if defined(USE_ESP32) || defined(USE_HOST)
+  this->region_ = rtc_region;
+  return true;
+#elif defined(USE_ESP8266)
+  this->rtc_ = global_preferences->make_preference<WarmStateRegion>(fnv1_hash(TAG), false);
+  if (!this->rtc_.is_valid()) {
+    ESP_LOGE(TAG, "RTC memory is full, the warm state of %u bytes does not fit", WARM_STATE_SIZE);
+    return false;
+  }
+  return this->rtc_.load(&this->region_);
+#else
+  return false;
+#endif
+}
+
+bool WarmStateComponent::save_region_() {
+#if defined(USE_ESP32) || defined(USE_HOST)
+  rtc_region = this->region_;
+  return true;
+#elif defined(USE_ESP8266)
+  return this->rtc_.save(&this->region_);
+#else
+  return false;
+#endif
+}
+
+}  // namespace warm_state
+}  // namespace esphome
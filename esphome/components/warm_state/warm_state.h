@@ -0,0 +1,63 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/preferences.h"
+
+#include <vector>
+
+namespace esphome {
+namespace warm_state {
+
+/** The region of RTC memory holding the warm state of all registered components.
+ *
+ * The data is a sequence of entries, one per registered component in registration order: a uint16_t with the
+ * size of the state, followed by the state itself.
+ */
+struct WarmStateRegion {
+  uint32_t version;  ///< Layout version generated by codegen, a mismatch invalidates the whole region.
+  uint16_t length;   ///< Number of bytes used in data.
+  uint16_t crc;      ///< crc16 over the used data.
+  uint8_t data[WARM_STATE_SIZE];
+};
+
+/** Keeps the state of registered components across deep sleep and safe reboots.
+ *
+ * The region lives in RTC slow memory on the ESP32, in RTC user memory on the ESP8266 and in a simulated region in
+ * RAM on the host platform. It survives deep sleep and software resets but not a power loss.
+ */
+class WarmStateComponent : public Component {
+ public:
+  void set_layout_version(uint32_t layout_version) { this->layout_version_ = layout_version; }
+  void register_component(Component *component) { this->components_.push_back(component); }
+
+  /** Restore all registered components from the region.
+   *
+   * Called from the generated main before App.setup(), so that components know whether they start warm in setup().
+   */
+  void restore();
+  /// Serialize all registered components into the region.
+  void save();
+  /// Invalidate the region, the next boot starts cold.
+  void invalidate();
+
+  void dump_config() override;
+  void on_safe_shutdown() override;
+  /// Highest priority, so the safe shutdown hook runs after all other components have stopped.
+  float get_setup_priority() const override { return setup_priority::BUS + 100.0f; }
+
+ protected:
+  bool load_region_();
+  bool save_region_();
+
+  uint32_t layout_version_{0};
+  std::vector<Component *> components_;
+  WarmStateRegion region_{};
+  uint8_t restored_{0};
+#ifdef USE_ESP8266
+  ESPPreferenceObject rtc_;
+#endif
+};
+
+}  // namespace warm_state
+}  // namespace esphome
@@ -125,7 +125,8 @@ bool WaveshareEPaper::wait_until_idle_() {
   return true;
 }
 void WaveshareEPaper::update() {
-  this->do_update_();
+  if (!this->do_update_())
+    return;
   this->display();
 }
 void WaveshareEPaper::fill(Color color) {
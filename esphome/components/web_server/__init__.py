@@ -1,4 +1,8 @@
 import gzip
+import hashlib
+import importlib.util
+from pathlib import Path
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import web_server_base
@@ -31,6 +35,8 @@ AUTO_LOAD = ["json", "web_server_base"]
 web_server_ns = cg.esphome_ns.namespace("web_server")
 WebServer = web_server_ns.class_("WebServer", cg.Component, cg.Controller)
 
+CONF_BROTLI = "brotli"
+
 
 def default_url(config):
     config = config.copy()
@@ -53,6 +59,12 @@ def validate_local(config):
     return config
 
 
+def validate_brotli(config):
+    if config[CONF_BROTLI] and importlib.util.find_spec("brotli") is None:
+        raise cv.Invalid("'brotli' needs the brotli Python package")
+    return config
+
+
 def validate_ota(config):
     if CORE.using_esp_idf and config[CONF_OTA]:
         raise cv.Invalid("Enabling 'ota' is not supported for IDF framework yet")
@@ -94,12 +106,14 @@ CONFIG_SCHEMA = cv.All(
             ): cv.boolean,
             cv.Optional(CONF_LOG, default=True): cv.boolean,
             cv.Optional(CONF_LOCAL): cv.boolean,
+            cv.Optional(CONF_BROTLI, default=False): cv.boolean,
         }
     ).extend(cv.COMPONENT_SCHEMA),
     cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_BK72XX, PLATFORM_RTL87XX]),
     default_url,
     validate_local,
     validate_ota,
+    validate_brotli,
 )
 
 
@@ -122,22 +136,44 @@ def build_index_html(config) -> str:
 
 
 def add_resource_as_progmem(
-    resource_name: str, content: str, compress: bool = True
+    resource_name: str, content: str, compress: bool = True, brotli: bool = False
 ) -> None:
-    """Add a resource to progmem."""
+    """Add a resource to progmem, with an ETag of its content.
+
+    Compressed resources are stored gzipped, and additionally with brotli if asked for.
+    """
     content_encoded = content.encode("utf-8")
+    add_etag(resource_name, content_encoded)
+    if brotli:
+        import brotli as brotli_module  # pylint: disable=import-outside-toplevel
+
+        add_progmem_array(
+            f"{resource_name}_BR", brotli_module.compress(content_encoded, quality=11)
+        )
     if compress:
-        content_encoded = gzip.compress(content_encoded)
-    content_encoded_size = len(content_encoded)
-    bytes_as_int = ", ".join(str(x) for x in content_encoded)
-    uint8_t = f"const uint8_t ESPHOME_WEBSERVER_{resource_name}[{content_encoded_size}] PROGMEM = {{{bytes_as_int}}}"
-    size_t = (
-        f"const size_t ESPHOME_WEBSERVER_{resource_name}_SIZE = {content_encoded_size}"
-    )
+        # No timestamp, so that the same content always compresses to the same bytes
+        content_encoded = gzip.compress(content_encoded, compresslevel=9, mtime=0)
+    add_progmem_array(resource_name, content_encoded)
+
+
+def add_progmem_array(name: str, data: bytes) -> None:
+    bytes_as_int = ", ".join(str(x) for x in data)
+    uint8_t = f"const uint8_t ESPHOME_WEBSERVER_{name}[{len(data)}] PROGMEM = {{{bytes_as_int}}}"
+    size_t = f"const size_t ESPHOME_WEBSERVER_{name}_SIZE = {len(data)}"
     cg.add_global(cg.RawExpression(uint8_t))
     cg.add_global(cg.RawExpression(size_t))
 
 
+def add_etag(resource_name: str, content: bytes) -> None:
+    # Browsers revalidate with it, and get a 304 as long as the content is unchanged
+    etag = hashlib.sha256(content).hexdigest()[:16]
+    cg.add_global(
+        cg.RawExpression(
+            f'const char ESPHOME_WEBSERVER_{resource_name}_ETAG[] = "\\"{etag}\\""'
+        )
+    )
+
+
 @coroutine_with_priority(40.0)
 async def to_code(config):
     paren = await cg.get_variable(config[CONF_WEB_SERVER_BASE_ID])
@@ -165,16 +201,23 @@ async def to_code(config):
     if CONF_AUTH in config:
         cg.add(paren.set_auth_username(config[CONF_AUTH][CONF_USERNAME]))
         cg.add(paren.set_auth_password(config[CONF_AUTH][CONF_PASSWORD]))
+    if config[CONF_BROTLI]:
+        cg.add_define("USE_WEBSERVER_BROTLI")
     if CONF_CSS_INCLUDE in config:
         cg.add_define("USE_WEBSERVER_CSS_INCLUDE")
         path = CORE.relative_config_path(config[CONF_CSS_INCLUDE])
         with open(file=path, encoding="utf-8") as css_file:
-            add_resource_as_progmem("CSS_INCLUDE", css_file.read())
+            add_resource_as_progmem(
+                "CSS_INCLUDE", css_file.read(), brotli=config[CONF_BROTLI]
+            )
     if CONF_JS_INCLUDE in config:
         cg.add_define("USE_WEBSERVER_JS_INCLUDE")
         path = CORE.relative_config_path(config[CONF_JS_INCLUDE])
         with open(file=path, encoding="utf-8") as js_file:
-            add_resource_as_progmem("JS_INCLUDE", js_file.read())
+            add_resource_as_progmem(
+                "JS_INCLUDE", js_file.read(), brotli=config[CONF_BROTLI]
+            )
     cg.add(var.set_include_internal(config[CONF_INCLUDE_INTERNAL]))
     if CONF_LOCAL in config and config[CONF_LOCAL]:
         cg.add_define("USE_WEBSERVER_LOCAL")
+        add_etag("INDEX_GZ", (Path(__file__).parent / "server_index.h").read_bytes())
@@ -106,5 +106,89 @@ bool ListEntitiesIterator::on_alarm_control_panel(alarm_control_panel::AlarmCont
 }
 #endif
 
+StateEventsIterator::StateEventsIterator(WebServer *web_server) : web_server_(web_server) {}
+
+#ifdef USE_BINARY_SENSOR
+bool StateEventsIterator::on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
+  this->web_server_->on_binary_sensor_update(binary_sensor, binary_sensor->state);
+  return true;
+}
+#endif
+#ifdef USE_COVER
+bool StateEventsIterator::on_cover(cover::Cover *cover) {
+  this->web_server_->on_cover_update(cover);
+  return true;
+}
+#endif
+#ifdef USE_FAN
+bool StateEventsIterator::on_fan(fan::Fan *fan) {
+  this->web_server_->on_fan_update(fan);
+  return true;
+}
+#endif
+#ifdef USE_LIGHT
+bool StateEventsIterator::on_light(light::LightState *light) {
+  this->web_server_->on_light_update(light);
+  return true;
+}
+#endif
+#ifdef USE_SENSOR
+bool StateEventsIterator::on_sensor(sensor::Sensor *sensor) {
+  this->web_server_->on_sensor_update(sensor, sensor->state);
+  return true;
+}
+#endif
+#ifdef USE_SWITCH
+bool StateEventsIterator::on_switch(switch_::Switch *a_switch) {
+  this->web_server_->on_switch_update(a_switch, a_switch->state);
+  return true;
+}
+#endif
+#ifdef USE_BUTTON
+bool StateEventsIterator::on_button(button::Button * /*button*/) { return true; }
+#endif
+#ifdef USE_TEXT_SENSOR
+bool StateEventsIterator::on_text_sensor(text_sensor::TextSensor *text_sensor) {
+  this->web_server_->on_text_sensor_update(text_sensor, text_sensor->state);
+  return true;
+}
+#endif
+#ifdef USE_LOCK
+bool StateEventsIterator::on_lock(lock::Lock *a_lock) {
+  this->web_server_->on_lock_update(a_lock);
+  return true;
+}
+#endif
+#ifdef USE_CLIMATE
+bool StateEventsIterator::on_climate(climate::Climate *climate) {
+  this->web_server_->on_climate_update(climate);
+  return true;
+}
+#endif
+#ifdef USE_NUMBER
+bool StateEventsIterator::on_number(number::Number *number) {
+  this->web_server_->on_number_update(number, number->state);
+  return true;
+}
+#endif
+#ifdef USE_TEXT
+bool StateEventsIterator::on_text(text::Text *text) {
+  this->web_server_->on_text_update(text, text->state);
+  return true;
+}
+#endif
+#ifdef USE_SELECT
+bool StateEventsIterator::on_select(select::Select *select) {
+  this->web_server_->on_select_update(select, select->state, select->active_index().value_or(0));
+  return true;
+}
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+bool StateEventsIterator::on_alarm_control_panel(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
+  this->web_server_->on_alarm_control_panel_update(a_alarm_control_panel);
+  return true;
+}
+#endif
+
 }  // namespace web_server
 }  // namespace esphome
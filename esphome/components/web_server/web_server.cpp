@@ -91,7 +91,7 @@ UrlMatch match_url(const std::string &url, bool only_domain = false) {
 }
 
 WebServer::WebServer(web_server_base::WebServerBase *base)
-    : base_(base), entities_iterator_(ListEntitiesIterator(this)) {
+    : base_(base), entities_iterator_(ListEntitiesIterator(this)), state_iterator_(StateEventsIterator(this)) {
 #ifdef USE_ESP32
   to_schedule_lock_ = xSemaphoreCreateMutex();
 #endif
@@ -121,7 +121,9 @@ std::string WebServer::get_config_json() {
 
 void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up web server...");
-  this->setup_controller(this->include_internal_);
+  App.state_table.init();
+  // Clients get every state when they connect, events are only needed for the changes after that
+  this->state_cursor_.since = App.state_table.get_version();
   this->base_->init();
 
   this->events_.onConnect([this](AsyncEventSourceClient *client) {
@@ -163,6 +165,8 @@ void WebServer::loop() {
   }
 #endif
   this->entities_iterator_.advance();
+  // Sends the latest state of everything that changed since the previous pass
+  App.state_table.send_changed(this->state_cursor_, &this->state_iterator_, this->include_internal_);
 }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
@@ -170,11 +174,42 @@ void WebServer::dump_config() {
 }
 float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
+/// Does the request header contain the token, e.g. an encoding of Accept-Encoding or the ETag of If-None-Match
+static bool header_contains(AsyncWebServerRequest *request, const char *name, const char *token) {
+#ifdef USE_ESP_IDF
+  auto value = request->get_header(name);
+  return value.has_value() && value->find(token) != std::string::npos;
+#else
+  AsyncWebHeader *header = request->getHeader(name);
+  return header != nullptr && strstr(header->value().c_str(), token) != nullptr;
+#endif
+}
+
+void WebServer::send_static_(AsyncWebServerRequest *request, const char *content_type, const char *etag,
+                             const uint8_t *data, size_t size, bool gzipped, const uint8_t *br_data, size_t br_size) {
+  AsyncWebServerResponse *response;
+  if (header_contains(request, "If-None-Match", etag)) {
+    response = request->beginResponse(304, "");
+  } else if (br_data != nullptr && header_contains(request, "Accept-Encoding", "br")) {
+    response = request->beginResponse_P(200, content_type, br_data, br_size);
+    response->addHeader("Content-Encoding", "br");
+  } else {
+    // Sent straight from flash
+    response = request->beginResponse_P(200, content_type, data, size);
+    if (gzipped)
+      response->addHeader("Content-Encoding", "gzip");
+  }
+  if (br_data != nullptr)
+    response->addHeader("Vary", "Accept-Encoding");
+  response->addHeader("ETag", etag);
+  // Cached, but revalidated on every load so a new build shows up right away
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
 #ifdef USE_WEBSERVER_LOCAL
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
-  AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", INDEX_GZ, sizeof(INDEX_GZ));
-  response->addHeader("Content-Encoding", "gzip");
-  request->send(response);
+  this->send_static_(request, "text/html", ESPHOME_WEBSERVER_INDEX_GZ_ETAG, INDEX_GZ, sizeof(INDEX_GZ), true);
 }
 #elif USE_WEBSERVER_VERSION == 1
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
@@ -359,10 +394,9 @@ void WebServer::handle_index_request(AsyncWebServerRequest *request) {
 }
 #elif USE_WEBSERVER_VERSION == 2
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
-  AsyncWebServerResponse *response =
-      request->beginResponse_P(200, "text/html", ESPHOME_WEBSERVER_INDEX_HTML, ESPHOME_WEBSERVER_INDEX_HTML_SIZE);
-  // No gzip header here because the HTML file is so small
-  request->send(response);
+  // Not gzipped because the HTML file is so small
+  this->send_static_(request, "text/html", ESPHOME_WEBSERVER_INDEX_HTML_ETAG, ESPHOME_WEBSERVER_INDEX_HTML,
+                     ESPHOME_WEBSERVER_INDEX_HTML_SIZE, false);
 }
 #endif
 
@@ -379,19 +413,27 @@ void WebServer::handle_pna_cors_request(AsyncWebServerRequest *request) {
 
 #ifdef USE_WEBSERVER_CSS_INCLUDE
 void WebServer::handle_css_request(AsyncWebServerRequest *request) {
-  AsyncWebServerResponse *response =
-      request->beginResponse_P(200, "text/css", ESPHOME_WEBSERVER_CSS_INCLUDE, ESPHOME_WEBSERVER_CSS_INCLUDE_SIZE);
-  response->addHeader("Content-Encoding", "gzip");
-  request->send(response);
+#ifdef USE_WEBSERVER_BROTLI
+  this->send_static_(request, "text/css", ESPHOME_WEBSERVER_CSS_INCLUDE_ETAG, ESPHOME_WEBSERVER_CSS_INCLUDE,
+                     ESPHOME_WEBSERVER_CSS_INCLUDE_SIZE, true, ESPHOME_WEBSERVER_CSS_INCLUDE_BR,
+                     ESPHOME_WEBSERVER_CSS_INCLUDE_BR_SIZE);
+#else
+  this->send_static_(request, "text/css", ESPHOME_WEBSERVER_CSS_INCLUDE_ETAG, ESPHOME_WEBSERVER_CSS_INCLUDE,
+                     ESPHOME_WEBSERVER_CSS_INCLUDE_SIZE, true);
+#endif
 }
 #endif
 
 #ifdef USE_WEBSERVER_JS_INCLUDE
 void WebServer::handle_js_request(AsyncWebServerRequest *request) {
-  AsyncWebServerResponse *response =
-      request->beginResponse_P(200, "text/javascript", ESPHOME_WEBSERVER_JS_INCLUDE, ESPHOME_WEBSERVER_JS_INCLUDE_SIZE);
-  response->addHeader("Content-Encoding", "gzip");
-  request->send(response);
+#ifdef USE_WEBSERVER_BROTLI
+  this->send_static_(request, "text/javascript", ESPHOME_WEBSERVER_JS_INCLUDE_ETAG, ESPHOME_WEBSERVER_JS_INCLUDE,
+                     ESPHOME_WEBSERVER_JS_INCLUDE_SIZE, true, ESPHOME_WEBSERVER_JS_INCLUDE_BR,
+                     ESPHOME_WEBSERVER_JS_INCLUDE_BR_SIZE);
+#else
+  this->send_static_(request, "text/javascript", ESPHOME_WEBSERVER_JS_INCLUDE_ETAG, ESPHOME_WEBSERVER_JS_INCLUDE,
+                     ESPHOME_WEBSERVER_JS_INCLUDE_SIZE, true);
+#endif
 }
 #endif
 
@@ -4,6 +4,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <cinttypes>
+
 #ifdef USE_ESP32
 #include <WiFi.h>
 #endif
@@ -30,6 +32,10 @@ void WLEDLightEffect::start() {
   AddressableLightEffect::start();
 
   blank_at_ = 0;
+  streaming_ = false;
+  timed_out_ = false;
+  this->dnrgb_partial_ = false;
+  this->frame_.resize(this->get_addressable_()->size());
 }
 
 void WLEDLightEffect::stop() {
@@ -39,13 +45,13 @@ void WLEDLightEffect::stop() {
     udp_->stop();
     udp_.reset();
   }
+  ESP_LOGD(TAG, "Frames dropped: %" PRIu32 ", late: %" PRIu32, this->frame_.get_dropped(), this->frame_.get_late());
 }
 
-void WLEDLightEffect::blank_all_leds_(light::AddressableLight &it) {
-  for (int led = it.size(); led-- > 0;) {
-    it[led].set(Color::BLACK);
-  }
-  it.schedule_show();
+void WLEDLightEffect::blank_all_leds_() {
+  this->frame_.fill(Color::BLACK);
+  this->frame_.complete();
+  this->dnrgb_partial_ = false;
 }
 
 void WLEDLightEffect::apply(light::AddressableLight &it, const Color &current_color) {
@@ -59,28 +65,36 @@ void WLEDLightEffect::apply(light::AddressableLight &it, const Color &current_co
     }
   }
 
-  std::vector<uint8_t> payload;
+  if (this->frame_.size() != static_cast<size_t>(it.size()))
+    this->frame_.resize(it.size());
+
+  // Drain all pending packets, only the latest complete frame is shown
   while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    if (this->payload_.size() < packet_size)
+      this->payload_.resize(packet_size);
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (!udp_->read(this->payload_.data(), packet_size)) {
       continue;
     }
 
-    if (!this->parse_frame_(it, &payload[0], payload.size())) {
-      ESP_LOGD(TAG, "Frame: Invalid (size=%zu, first=0x%02X).", payload.size(), payload[0]);
+    if (!this->parse_frame_(this->payload_.data(), packet_size)) {
+      ESP_LOGD(TAG, "Frame: Invalid (size=%u, first=0x%02X).", packet_size, this->payload_[0]);
       continue;
     }
   }
 
   // FIXME: Use roll-over safe arithmetic
   if (blank_at_ < millis()) {
-    blank_all_leds_(it);
+    blank_all_leds_();
+    timed_out_ = streaming_;
+    streaming_ = false;
     blank_at_ = millis() + DEFAULT_BLANK_TIME;
   }
+
+  this->frame_.apply(it);
 }
 
-bool WLEDLightEffect::parse_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size) {
+bool WLEDLightEffect::parse_frame_(const uint8_t *payload, uint16_t size) {
   // At minimum frame needs to have:
   // 1b - protocol
   // 1b - timeout
@@ -98,31 +112,31 @@ bool WLEDLightEffect::parse_frame_(light::AddressableLight &it, const uint8_t *p
     case WLED_NOTIFIER:
       // Hyperion Port
       if (port_ == 19446) {
-        if (!parse_drgb_frame_(it, payload, size))
+        if (!parse_drgb_frame_(payload, size))
           return false;
       } else {
-        if (!parse_notifier_frame_(it, payload, size))
+        if (!parse_notifier_frame_(payload, size))
           return false;
       }
       break;
 
     case WARLS:
-      if (!parse_warls_frame_(it, payload, size))
+      if (!parse_warls_frame_(payload, size))
         return false;
       break;
 
     case DRGB:
-      if (!parse_drgb_frame_(it, payload, size))
+      if (!parse_drgb_frame_(payload, size))
         return false;
       break;
 
     case DRGBW:
-      if (!parse_drgbw_frame_(it, payload, size))
+      if (!parse_drgbw_frame_(payload, size))
         return false;
       break;
 
     case DNRGB:
-      if (!parse_dnrgb_frame_(it, payload, size))
+      if (!parse_dnrgb_frame_(payload, size))
         return false;
       break;
 
@@ -138,23 +152,32 @@ bool WLEDLightEffect::parse_frame_(light::AddressableLight &it, const uint8_t *p
     blank_at_ = millis() + DEFAULT_BLANK_TIME;
   }
 
-  it.schedule_show();
+  // The timeout of the previous frame ran out before this one arrived
+  if (timed_out_) {
+    this->frame_.count_late();
+    timed_out_ = false;
+  }
+  streaming_ = true;
+
+  // DNRGB completes its frames itself, once the last chunk is in
+  if (protocol != DNRGB)
+    this->frame_.complete();
   return true;
 }
 
-bool WLEDLightEffect::parse_notifier_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size) {
+bool WLEDLightEffect::parse_notifier_frame_(const uint8_t *payload, uint16_t size) {
   // Packet needs to be empty
   return size == 0;
 }
 
-bool WLEDLightEffect::parse_warls_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size) {
+bool WLEDLightEffect::parse_warls_frame_(const uint8_t *payload, uint16_t size) {
   // packet: index, r, g, b
   if ((size % 4) != 0) {
     return false;
   }
 
   auto count = size / 4;
-  auto max_leds = it.size();
+  auto max_leds = this->frame_.size();
 
   for (; count > 0; count--, payload += 4) {
     uint8_t led = payload[0];
@@ -163,21 +186,21 @@ bool WLEDLightEffect::parse_warls_frame_(light::AddressableLight &it, const uint
     uint8_t b = payload[3];
 
     if (led < max_leds) {
-      it[led].set(Color(r, g, b));
+      this->frame_.set(led, Color(r, g, b));
     }
   }
 
   return true;
 }
 
-bool WLEDLightEffect::parse_drgb_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size) {
+bool WLEDLightEffect::parse_drgb_frame_(const uint8_t *payload, uint16_t size) {
   // packet: r, g, b
   if ((size % 3) != 0) {
     return false;
   }
 
   auto count = size / 3;
-  auto max_leds = it.size();
+  auto max_leds = this->frame_.size();
 
   for (uint16_t led = 0; led < count; ++led, payload += 3) {
     uint8_t r = payload[0];
@@ -185,21 +208,21 @@ bool WLEDLightEffect::parse_drgb_frame_(light::AddressableLight &it, const uint8
     uint8_t b = payload[2];
 
     if (led < max_leds) {
-      it[led].set(Color(r, g, b));
+      this->frame_.set(led, Color(r, g, b));
     }
   }
 
   return true;
 }
 
-bool WLEDLightEffect::parse_drgbw_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size) {
+bool WLEDLightEffect::parse_drgbw_frame_(const uint8_t *payload, uint16_t size) {
   // packet: r, g, b, w
   if ((size % 4) != 0) {
     return false;
   }
 
   auto count = size / 4;
-  auto max_leds = it.size();
+  auto max_leds = this->frame_.size();
 
   for (uint16_t led = 0; led < count; ++led, payload += 4) {
     uint8_t r = payload[0];
@@ -208,14 +231,14 @@ bool WLEDLightEffect::parse_drgbw_frame_(light::AddressableLight &it, const uint
     uint8_t w = payload[3];
 
     if (led < max_leds) {
-      it[led].set(Color(r, g, b, w));
+      this->frame_.set(led, Color(r, g, b, w));
     }
   }
 
   return true;
 }
 
-bool WLEDLightEffect::parse_dnrgb_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size) {
+bool WLEDLightEffect::parse_dnrgb_frame_(const uint8_t *payload, uint16_t size) {
   // offset: high, low
   if (size < 2) {
     return false;
@@ -231,7 +254,12 @@ bool WLEDLightEffect::parse_dnrgb_frame_(light::AddressableLight &it, const uint
   }
 
   auto count = size / 3;
-  auto max_leds = it.size();
+  auto max_leds = this->frame_.size();
+
+  // A chunk going back to an earlier LED starts the next frame, which also shows the frames of senders that do not
+  // cover all LEDs and so never send a chunk reaching the end
+  if (this->dnrgb_partial_ && led < this->dnrgb_next_)
+    this->frame_.complete();
 
   for (; count > 0; count--, payload += 3, led++) {
     uint8_t r = payload[0];
@@ -239,10 +267,14 @@ bool WLEDLightEffect::parse_dnrgb_frame_(light::AddressableLight &it, const uint
     uint8_t b = payload[2];
 
     if (led < max_leds) {
-      it[led].set(Color(r, g, b));
+      this->frame_.set(led, Color(r, g, b));
     }
   }
 
+  this->dnrgb_next_ = led;
+  this->dnrgb_partial_ = led < max_leds;
+  if (!this->dnrgb_partial_)
+    this->frame_.complete();
   return true;
 }
 
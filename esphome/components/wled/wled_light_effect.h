@@ -4,6 +4,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/light/addressable_light_effect.h"
+#include "esphome/components/light/realtime_frame.h"
 
 #include <vector>
 #include <memory>
@@ -23,18 +24,25 @@ class WLEDLightEffect : public light::AddressableLightEffect {
   void set_port(uint16_t port) { this->port_ = port; }
 
  protected:
-  void blank_all_leds_(light::AddressableLight &it);
-  bool parse_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
-  bool parse_notifier_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
-  bool parse_warls_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
-  bool parse_drgb_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
-  bool parse_drgbw_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
-  bool parse_dnrgb_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
+  void blank_all_leds_();
+  bool parse_frame_(const uint8_t *payload, uint16_t size);
+  bool parse_notifier_frame_(const uint8_t *payload, uint16_t size);
+  bool parse_warls_frame_(const uint8_t *payload, uint16_t size);
+  bool parse_drgb_frame_(const uint8_t *payload, uint16_t size);
+  bool parse_drgbw_frame_(const uint8_t *payload, uint16_t size);
+  bool parse_dnrgb_frame_(const uint8_t *payload, uint16_t size);
 
   uint16_t port_{0};
   std::unique_ptr<UDP> udp_;
   uint32_t blank_at_{0};
-  uint32_t dropped_{0};
+  bool streaming_{false};
+  bool timed_out_{false};
+  /// Receive buffer, grows to the largest packet seen
+  std::vector<uint8_t> payload_;
+  light::RealtimeFrame frame_;
+  /// DNRGB splits a frame over several packets: the LED after the last chunk, and whether chunks are staged.
+  uint16_t dnrgb_next_{0};
+  bool dnrgb_partial_{false};
 };
 
 }  // namespace wled
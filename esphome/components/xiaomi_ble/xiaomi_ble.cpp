@@ -4,6 +4,8 @@
 
 #ifdef USE_ESP32
 
+#include <cinttypes>
+#include <memory>
 #include <vector>
 #include "mbedtls/ccm.h"
 
@@ -142,7 +144,7 @@ optional<XiaomiParseResult> parse_xiaomi_header(const esp32_ble_tracker::Service
     return {};
   }
 
-  auto raw = service_data.data;
+  const auto &raw = service_data.data;
   result.has_data = raw[0] & 0x40;
   result.has_capability = raw[0] & 0x20;
   result.has_encryption = raw[0] & 0x08;
@@ -231,6 +233,52 @@ optional<XiaomiParseResult> parse_xiaomi_header(const esp32_ble_tracker::Service
   return result;
 }
 
+/// AES-CCM context keyed with a bindkey. Keying expands the AES key schedule, so it is done once per bindkey.
+struct XiaomiCCMContext {
+  uint8_t bindkey[16];
+  mbedtls_ccm_context ctx;
+};
+
+/// Packet counter of the last authenticated packet of an encrypted device.
+struct XiaomiPacketCounter {
+  uint64_t address;
+  uint32_t counter;
+  bool valid;
+};
+
+/// Packets up to this many counts behind the last one are duplicates or replays. Authenticated packets further
+/// behind are taken as a restart of the device.
+static const uint32_t REPLAY_WINDOW = 256;
+
+static mbedtls_ccm_context *get_ccm_context(const uint8_t *bindkey) {
+  // Bindkeys come from the configuration, so this holds one entry per configured device at most
+  static std::vector<std::unique_ptr<XiaomiCCMContext>> contexts;  // NOLINT
+  for (auto &context : contexts) {
+    if (memcmp(context->bindkey, bindkey, sizeof(context->bindkey)) == 0)
+      return &context->ctx;
+  }
+  auto context = make_unique<XiaomiCCMContext>();
+  memcpy(context->bindkey, bindkey, sizeof(context->bindkey));
+  mbedtls_ccm_init(&context->ctx);
+  if (mbedtls_ccm_setkey(&context->ctx, MBEDTLS_CIPHER_ID_AES, bindkey, 128) != 0) {
+    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): mbedtls_ccm_setkey() failed.");
+    mbedtls_ccm_free(&context->ctx);
+    return nullptr;
+  }
+  contexts.push_back(std::move(context));
+  return &contexts.back()->ctx;
+}
+
+static XiaomiPacketCounter &get_packet_counter(uint64_t address) {
+  static std::vector<XiaomiPacketCounter> counters;  // NOLINT
+  for (auto &counter : counters) {
+    if (counter.address == address)
+      return counter;
+  }
+  counters.push_back(XiaomiPacketCounter{address, 0, false});
+  return counters.back();
+}
+
 bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, const uint64_t &address) {
   if (!((raw.size() == 19) || ((raw.size() >= 22) && (raw.size() <= 24)))) {
     ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): data packet has wrong size (%d)!", raw.size());
@@ -238,84 +286,59 @@ bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, c
     return false;
   }
 
-  uint8_t mac_reverse[6] = {0};
-  mac_reverse[5] = (uint8_t) (address >> 40);
-  mac_reverse[4] = (uint8_t) (address >> 32);
-  mac_reverse[3] = (uint8_t) (address >> 24);
-  mac_reverse[2] = (uint8_t) (address >> 16);
-  mac_reverse[1] = (uint8_t) (address >> 8);
-  mac_reverse[0] = (uint8_t) (address >> 0);
-
-  XiaomiAESVector vector{.key = {0},
-                         .plaintext = {0},
-                         .ciphertext = {0},
-                         .authdata = {0x11},
-                         .iv = {0},
-                         .tag = {0},
-                         .keysize = 16,
-                         .authsize = 1,
-                         .datasize = 0,
-                         .tagsize = 4,
-                         .ivsize = 12};
-
-  vector.datasize = (raw.size() == 19) ? raw.size() - 12 : raw.size() - 18;
-  int cipher_pos = (raw.size() == 19) ? 5 : 11;
-
-  const uint8_t *v = raw.data();
-
-  memcpy(vector.key, bindkey, vector.keysize);
-  memcpy(vector.ciphertext, v + cipher_pos, vector.datasize);
-  memcpy(vector.tag, v + raw.size() - vector.tagsize, vector.tagsize);
-  memcpy(vector.iv, mac_reverse, 6);             // MAC address reverse
-  memcpy(vector.iv + 6, v + 2, 3);               // sensor type (2) + packet id (1)
-  memcpy(vector.iv + 9, v + raw.size() - 7, 3);  // payload counter
+  const size_t datasize = (raw.size() == 19) ? raw.size() - 12 : raw.size() - 18;
+  const size_t cipher_pos = (raw.size() == 19) ? 5 : 11;
+  const size_t tagsize = 4;
+  uint8_t *v = raw.data();
 
-  mbedtls_ccm_context ctx;
-  mbedtls_ccm_init(&ctx);
-
-  int ret = mbedtls_ccm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, vector.key, vector.keysize * 8);
-  if (ret) {
-    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): mbedtls_ccm_setkey() failed.");
-    mbedtls_ccm_free(&ctx);
+  // Frame counter (1) and payload counter (3) form the packet counter, which the sensor never repeats
+  const uint32_t packet_counter = encode_uint32(v[raw.size() - 5], v[raw.size() - 6], v[raw.size() - 7], v[4]);
+  XiaomiPacketCounter &last = get_packet_counter(address);
+  if (last.valid && last.counter - packet_counter < REPLAY_WINDOW) {
+    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): duplicate or replayed packet %" PRIu32 " (last %" PRIu32 ").",
+              packet_counter, last.counter);
     return false;
   }
 
-  ret = mbedtls_ccm_auth_decrypt(&ctx, vector.datasize, vector.iv, vector.ivsize, vector.authdata, vector.authsize,
-                                 vector.ciphertext, vector.plaintext, vector.tag, vector.tagsize);
+  mbedtls_ccm_context *ctx = get_ccm_context(bindkey);
+  if (ctx == nullptr)
+    return false;
+
+  uint8_t iv[12];
+  iv[0] = (uint8_t) (address >> 0);  // MAC address reverse
+  iv[1] = (uint8_t) (address >> 8);
+  iv[2] = (uint8_t) (address >> 16);
+  iv[3] = (uint8_t) (address >> 24);
+  iv[4] = (uint8_t) (address >> 32);
+  iv[5] = (uint8_t) (address >> 40);
+  memcpy(iv + 6, v + 2, 3);               // sensor type (2) + packet id (1)
+  memcpy(iv + 9, v + raw.size() - 7, 3);  // payload counter
+  static const uint8_t AUTHDATA[1] = {0x11};
+
+  // Decrypt straight into the packet. mbedtls wipes the output when the tag does not match, the ciphertext is
+  // put back then.
+  uint8_t ciphertext[16];
+  memcpy(ciphertext, v + cipher_pos, datasize);
+  int ret = mbedtls_ccm_auth_decrypt(ctx, datasize, iv, sizeof(iv), AUTHDATA, sizeof(AUTHDATA), ciphertext,
+                                     v + cipher_pos, v + raw.size() - tagsize, tagsize);
   if (ret) {
-    uint8_t mac_address[6] = {0};
-    memcpy(mac_address, mac_reverse + 5, 1);
-    memcpy(mac_address + 1, mac_reverse + 4, 1);
-    memcpy(mac_address + 2, mac_reverse + 3, 1);
-    memcpy(mac_address + 3, mac_reverse + 2, 1);
-    memcpy(mac_address + 4, mac_reverse + 1, 1);
-    memcpy(mac_address + 5, mac_reverse, 1);
+    memcpy(v + cipher_pos, ciphertext, datasize);
     ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): authenticated decryption failed.");
-    ESP_LOGVV(TAG, "  MAC address : %s", format_hex_pretty(mac_address, 6).c_str());
+    ESP_LOGVV(TAG, "  MAC address : %012llX", address);
     ESP_LOGVV(TAG, "       Packet : %s", format_hex_pretty(raw.data(), raw.size()).c_str());
-    ESP_LOGVV(TAG, "          Key : %s", format_hex_pretty(vector.key, vector.keysize).c_str());
-    ESP_LOGVV(TAG, "           Iv : %s", format_hex_pretty(vector.iv, vector.ivsize).c_str());
-    ESP_LOGVV(TAG, "       Cipher : %s", format_hex_pretty(vector.ciphertext, vector.datasize).c_str());
-    ESP_LOGVV(TAG, "          Tag : %s", format_hex_pretty(vector.tag, vector.tagsize).c_str());
-    mbedtls_ccm_free(&ctx);
+    ESP_LOGVV(TAG, "          Key : %s", format_hex_pretty(bindkey, 16).c_str());
+    ESP_LOGVV(TAG, "           Iv : %s", format_hex_pretty(iv, sizeof(iv)).c_str());
     return false;
   }
-
-  // replace encrypted payload with plaintext
-  uint8_t *p = vector.plaintext;
-  for (std::vector<uint8_t>::iterator it = raw.begin() + cipher_pos; it != raw.begin() + cipher_pos + vector.datasize;
-       ++it) {
-    *it = *(p++);
-  }
+  last.counter = packet_counter;
+  last.valid = true;
 
   // clear encrypted flag
   raw[0] &= ~0x08;
 
   ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): authenticated decryption passed.");
-  ESP_LOGVV(TAG, "  Plaintext : %s, Packet : %d", format_hex_pretty(raw.data() + cipher_pos, vector.datasize).c_str(),
+  ESP_LOGVV(TAG, "  Plaintext : %s, Packet : %d", format_hex_pretty(raw.data() + cipher_pos, datasize).c_str(),
             static_cast<int>(raw[4]));
-
-  mbedtls_ccm_free(&ctx);
   return true;
 }
 
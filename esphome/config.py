@@ -26,7 +26,7 @@ from esphome.core import CORE, EsphomeError
 from esphome.helpers import indent
 from esphome.util import safe_print, OrderedDict
 
-from esphome.config_helpers import Extend, Remove
+from esphome.config_helpers import Extend, Remove, config_fingerprint, copy_config
 from esphome.loader import get_component, get_platform, ComponentManifest
 from esphome.yaml_util import is_secret, ESPHomeDataBase, ESPForceValue
 from esphome.voluptuous_schema import ExtraKeysInvalid
@@ -506,15 +506,52 @@ class MetadataValidationStep(ConfigValidationStep):
         )
 
 
+# Validated component blocks, see SchemaValidationStep
+_SCHEMA_CACHE: OrderedDict = OrderedDict()
+_SCHEMA_CACHE_SIZE = 4096
+
+
+def clear_schema_cache() -> None:
+    _SCHEMA_CACHE.clear()
+
+
+def _core_state_fingerprint() -> str:
+    """Digest of the state validators read and write besides their own block."""
+    return config_fingerprint(
+        [
+            CORE.data,
+            CORE.name,
+            CORE.friendly_name,
+            CORE.area,
+            CORE.config_path,
+            CORE.loaded_integrations,
+        ]
+    )
+
+
+class _SchemaCacheEntry:
+    def __init__(self, validated, pins_used):
+        self.validated = validated
+        # (pin key, client id, pin config) of the pins registered while validating
+        self.pins_used = pins_used
+
+
 class SchemaValidationStep(ConfigValidationStep):
     """Schema validation step.
 
     During this step all CONFIG_SCHEMAs are checked against the configs.
+
+    The result of a block is cached by its content, which already has the
+    substitutions resolved, and its document ranges, so long running processes like
+    the dashboard editor validation only validate the blocks that changed. Blocks whose
+    validation fails or modifies the shared state (CORE.data, the name, ...) are not
+    cached.
     """
 
     def __init__(
         self, domain: str, path: ConfigPath, conf: ConfigType, comp: ComponentManifest
     ):
+        self.domain = domain
         self.path = path
         self.conf = conf
         self.comp = comp
@@ -522,6 +559,23 @@ class SchemaValidationStep(ConfigValidationStep):
     def run(self, result: Config) -> None:
         if self.comp.config_schema is None:
             return
+        state = _core_state_fingerprint()
+        key = (self.domain, self.comp.module, config_fingerprint(self.conf), state)
+        entry = _SCHEMA_CACHE.get(key)
+        if entry is not None:
+            _SCHEMA_CACHE.move_to_end(key)
+            for pin_key, client_id, pin_config in entry.pins_used:
+                pins.PIN_SCHEMA_REGISTRY.pins_used.setdefault(pin_key, []).append(
+                    (self.path, client_id, copy_config(pin_config))
+                )
+            result.set_by_path(self.path, copy_config(entry.validated))
+            result.add_validation_step(
+                FinalValidateValidationStep(self.path, self.comp)
+            )
+            return
+
+        errors = len(result.errors)
+        pins_used = {k: len(v) for k, v in pins.PIN_SCHEMA_REGISTRY.pins_used.items()}
         token = path_context.set(self.path)
         with result.catch_error(self.path):
             if self.comp.is_platform:
@@ -544,6 +598,17 @@ class SchemaValidationStep(ConfigValidationStep):
         path_context.reset(token)
         result.add_validation_step(FinalValidateValidationStep(self.path, self.comp))
 
+        if len(result.errors) != errors or _core_state_fingerprint() != state:
+            return
+        new_pins = [
+            (pin_key, client_id, copy_config(pin_config))
+            for pin_key, uses in pins.PIN_SCHEMA_REGISTRY.pins_used.items()
+            for _, client_id, pin_config in uses[pins_used.get(pin_key, 0) :]
+        ]
+        _SCHEMA_CACHE[key] = _SchemaCacheEntry(copy_config(validated), new_pins)
+        if len(_SCHEMA_CACHE) > _SCHEMA_CACHE_SIZE:
+            _SCHEMA_CACHE.popitem(last=False)
+
 
 class IDPassValidationStep(ConfigValidationStep):
     """ID Pass step.
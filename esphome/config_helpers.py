@@ -1,8 +1,10 @@
+import copy
+import hashlib
 import json
 import os
 
 from esphome.const import CONF_ID
-from esphome.core import CORE
+from esphome.core import CORE, ID, Lambda
 from esphome.helpers import read_file
 
 
@@ -104,3 +106,62 @@ def merge_config(full_old, full_new):
         return new
 
     return merge(full_old, full_new)
+
+
+def copy_config(config):
+    """Copy the containers of a config, to modify it without changing the original.
+
+    Scalars are shared, they are never modified in place. IDs and lambdas are copied
+    too, as the ID pass and substitutions update them in place.
+    """
+    if type(config) is dict:  # pylint: disable=unidiomatic-typecheck
+        return {k: copy_config(v) for k, v in config.items()}
+    if type(config) is list:  # pylint: disable=unidiomatic-typecheck
+        return [copy_config(v) for v in config]
+    if isinstance(config, dict):
+        # Keeps the type and document range of the OrderedDicts from the YAML loader
+        res = copy.copy(config)
+        for k, v in res.items():
+            res[k] = copy_config(v)
+        return res
+    if isinstance(config, list):
+        res = copy.copy(config)
+        res[:] = [copy_config(v) for v in config]
+        return res
+    if isinstance(config, (ID, Lambda)):
+        return copy.copy(config)
+    return config
+
+
+def config_fingerprint(value):
+    """Digest of a configuration fragment, including the document range of its values.
+
+    Values without a meaningful str() (their default repr contains the address) simply
+    never produce the same digest twice.
+    """
+    digest = hashlib.sha256()
+    _update_fingerprint(digest, value)
+    return digest.hexdigest()
+
+
+def _update_fingerprint(digest, value):
+    # pylint: disable=import-outside-toplevel
+    from esphome.yaml_util import ESPHomeDataBase
+
+    if isinstance(value, ESPHomeDataBase) and value.esp_range is not None:
+        digest.update(f"@{value.esp_range}".encode())
+    if isinstance(value, dict):
+        digest.update(b"{")
+        for k, v in value.items():
+            _update_fingerprint(digest, k)
+            _update_fingerprint(digest, v)
+        digest.update(b"}")
+    elif isinstance(value, (list, tuple)):
+        digest.update(b"[")
+        for v in value:
+            _update_fingerprint(digest, v)
+        digest.update(b"]")
+    elif isinstance(value, (set, frozenset)):
+        digest.update(f"<{sorted(str(v) for v in value)}>".encode())
+    else:
+        digest.update(f"{type(value).__name__}:{value}\0".encode())
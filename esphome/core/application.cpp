@@ -3,6 +3,8 @@
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
 
+#include <algorithm>
+
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
@@ -11,6 +13,11 @@ namespace esphome {
 
 static const char *const TAG = "app";
 
+#ifdef USE_NETWORK_TASK
+static const uint32_t NETWORK_TASK_STACK_SIZE = 8192;
+static const UBaseType_t NETWORK_TASK_QUEUE_SIZE = 64;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,6 +34,13 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+#ifdef USE_NETWORK_TASK
+  // Until the network task is started, its components run on the main loop task
+  this->task_handles_[size_t(TaskAffinity::CONTROL)] = xTaskGetCurrentTaskHandle();
+  this->task_handles_[size_t(TaskAffinity::NETWORK)] = xTaskGetCurrentTaskHandle();
+  this->task_queues_[size_t(TaskAffinity::CONTROL)] = xQueueCreate(NETWORK_TASK_QUEUE_SIZE, sizeof(void *));
+  this->task_queues_[size_t(TaskAffinity::NETWORK)] = xQueueCreate(NETWORK_TASK_QUEUE_SIZE, sizeof(void *));
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -46,6 +60,10 @@ void Application::setup() {
 
     do {
       uint32_t new_app_state = STATUS_LED_WARNING;
+#ifdef USE_NETWORK_TASK
+      this->process_task_queue_(TaskAffinity::CONTROL);
+      this->process_task_queue_(TaskAffinity::NETWORK);
+#endif
       this->scheduler.call();
       this->feed_wdt();
       for (uint32_t j = 0; j <= i; j++) {
@@ -62,14 +80,40 @@ void Application::setup() {
   ESP_LOGI(TAG, "setup() finished successfully!");
   this->schedule_dump_config();
   this->calculate_looping_components_();
+
+#ifdef USE_NETWORK_TASK
+  if (!this->network_components_.empty()) {
+    // Run next to the WiFi and lwIP tasks, on the core the main loop does not use
+    const BaseType_t core = xPortGetCoreID() == 0 ? 1 : 0;
+    xTaskCreatePinnedToCore(Application::network_task_, "network", NETWORK_TASK_STACK_SIZE, this, 1,
+                            &this->task_handles_[size_t(TaskAffinity::NETWORK)], core);
+    ESP_LOGI(TAG, "Started network task on core %d with %zu components", core, this->network_components_.size());
+  }
+#endif
 }
 void Application::loop() {
   uint32_t new_app_state = 0;
 
+#ifdef USE_NETWORK_TASK
+  // The state table lock is released between components, so the network task waits for one component at most
+  this->state_table.lock();
+  this->process_task_queue_(TaskAffinity::CONTROL);
+  if (this->network_components_.empty())
+    this->process_task_queue_(TaskAffinity::NETWORK);
+  new_app_state |= this->network_app_state_;
+#endif
   this->scheduler.call();
+#ifdef USE_NETWORK_TASK
+  this->state_table.unlock();
+#endif
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+  // Components may disable or enable loops while iterating, which moves entries around, so go by index
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;) {
+    Component *component = this->looping_components_[this->current_loop_index_++];
     {
+#ifdef USE_NETWORK_TASK
+      StateTable::Guard state_guard{this->state_table};
+#endif
       WarnIfComponentBlockingGuard guard{component};
       component->call();
     }
@@ -77,6 +121,10 @@ void Application::loop() {
     this->app_state_ |= new_app_state;
     this->feed_wdt();
   }
+  this->current_loop_index_ = 0;
+  // Components with their loop disabled can still raise a warning or error, e.g. from a callback
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++)
+    new_app_state |= this->looping_components_[i]->get_component_state();
   this->app_state_ = new_app_state;
 
   const uint32_t now = millis();
@@ -111,6 +159,11 @@ void Application::loop() {
 }
 
 void IRAM_ATTR HOT Application::feed_wdt() {
+#ifdef USE_NETWORK_TASK
+  // Only the main loop task is watched
+  if (!this->in_task(TaskAffinity::CONTROL))
+    return;
+#endif
   static uint32_t last_feed = 0;
   uint32_t now = micros();
   if (now - last_feed > 3000) {
@@ -147,11 +200,129 @@ void Application::run_safe_shutdown_hooks() {
 
 void Application::calculate_looping_components_() {
   for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
-      this->looping_components_.push_back(obj);
+    if (!obj->has_overridden_loop())
+      continue;
+#ifdef USE_NETWORK_TASK
+    if (obj->get_task_affinity() == TaskAffinity::NETWORK) {
+      this->network_components_.push_back(obj);
+      continue;
+    }
+#endif
+    this->looping_components_.push_back(obj);
+  }
+  // Components that disabled their loop during setup() start out inactive
+  auto inactive = std::stable_partition(this->looping_components_.begin(), this->looping_components_.end(),
+                                        [](Component *obj) { return obj->is_loop_enabled() || obj->is_failed(); });
+  this->looping_components_active_end_ = inactive - this->looping_components_.begin();
+}
+
+void Application::disable_component_loop_(Component *component) {
+#ifdef USE_NETWORK_TASK
+  // Network task components only skip their loop, the lists belong to the main loop task
+  if (component->get_task_affinity() == TaskAffinity::NETWORK)
+    return;
+  if (!this->in_task(TaskAffinity::CONTROL)) {
+    this->run_in_task(TaskAffinity::CONTROL, [this, component]() { this->disable_component_loop_(component); });
+    return;
+  }
+#endif
+  for (size_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Keep the order of the others, the component becomes the first inactive one
+    std::rotate(this->looping_components_.begin() + i, this->looping_components_.begin() + i + 1,
+                this->looping_components_.begin() + this->looping_components_active_end_);
+    this->looping_components_active_end_--;
+    // Everything after it moved one slot down, including the component to loop next
+    if (i < this->current_loop_index_)
+      this->current_loop_index_--;
+    return;
+  }
+}
+
+void Application::enable_component_loop_(Component *component) {
+#ifdef USE_NETWORK_TASK
+  if (component->get_task_affinity() == TaskAffinity::NETWORK)
+    return;
+  if (!this->in_task(TaskAffinity::CONTROL)) {
+    this->run_in_task(TaskAffinity::CONTROL, [this, component]() { this->enable_component_loop_(component); });
+    return;
+  }
+#endif
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Becomes the last active one, so it is still called in the current iteration of the main loop
+    std::swap(this->looping_components_[i], this->looping_components_[this->looping_components_active_end_]);
+    this->looping_components_active_end_++;
+    return;
+  }
+}
+
+#ifdef USE_NETWORK_TASK
+void Application::run_in_task(TaskAffinity task, std::function<void()> &&fn) {
+  if (this->in_task(task)) {
+    fn();
+    return;
+  }
+  QueueHandle_t queue = this->task_queues_[size_t(task)];
+  if (queue == nullptr)
+    return;
+  auto *call = new std::function<void()>(std::move(fn));  // NOLINT(cppcoreguidelines-owning-memory)
+  // The network task may wait for the main loop, but never the other way around
+  const TickType_t wait = task == TaskAffinity::CONTROL ? pdMS_TO_TICKS(this->loop_interval_ * 4) : 0;
+  if (xQueueSend(queue, &call, wait) != pdTRUE) {
+    delete call;  // NOLINT(cppcoreguidelines-owning-memory)
+    if (task == TaskAffinity::NETWORK)
+      this->network_dropped_calls_++;
+    return;
+  }
+  if (task == TaskAffinity::NETWORK && !this->network_components_.empty())
+    xTaskNotifyGive(this->task_handles_[size_t(TaskAffinity::NETWORK)]);
+}
+
+void Application::process_task_queue_(TaskAffinity task) {
+  QueueHandle_t queue = this->task_queues_[size_t(task)];
+  std::function<void()> *call;
+  while (queue != nullptr && xQueueReceive(queue, &call, 0) == pdTRUE) {
+    (*call)();
+    delete call;  // NOLINT(cppcoreguidelines-owning-memory)
   }
 }
 
+void Application::network_task_(void *params) {
+  auto *app = reinterpret_cast<Application *>(params);
+  app->network_last_loop_ = millis();
+  while (true) {
+    app->network_loop_();
+  }
+}
+
+void Application::network_loop_() {
+  const uint32_t start = millis();
+  const uint32_t loop_time = start - this->network_last_loop_;
+  this->network_last_loop_ = start;
+  if (loop_time > this->network_max_loop_time_)
+    this->network_max_loop_time_ = loop_time;
+
+  this->process_task_queue_(TaskAffinity::NETWORK);
+  uint32_t new_app_state = 0;
+  for (Component *component : this->network_components_) {
+    {
+      WarnIfComponentBlockingGuard guard{component};
+      component->call();
+    }
+    new_app_state |= component->get_component_state();
+  }
+  this->network_app_state_ = new_app_state;
+
+  // Sleep until the next iteration, or until the main loop hands over a state change
+  const uint32_t elapsed = millis() - start;
+  if (elapsed < this->loop_interval_)
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(this->loop_interval_ - elapsed));
+}
+#endif
+
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 }  // namespace esphome
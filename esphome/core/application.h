@@ -8,6 +8,14 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
+#include "esphome/core/state_table.h"
+
+#ifdef USE_NETWORK_TASK
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif
 
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
@@ -199,6 +207,29 @@ class Application {
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  /// Number of components with a loop() on the main loop task.
+  size_t get_looping_component_count() const { return this->looping_components_.size(); }
+  /// Number of those that currently have their loop enabled, see Component::disable_loop().
+  size_t get_active_looping_component_count() const { return this->looping_components_active_end_; }
+
+#ifdef USE_NETWORK_TASK
+  /// Whether the caller runs on the given task. Until the network task is started, both are the main loop task.
+  bool in_task(TaskAffinity task) const { return xTaskGetCurrentTaskHandle() == this->task_handles_[size_t(task)]; }
+
+  /** Call fn on the given task.
+   *
+   * fn is called right away when already on that task, otherwise it is queued for the next iteration of the loop of
+   * that task. This is the only way components on different tasks interact: fn gets copies of states and commands.
+   * Calls queued for the network task are dropped when its queue is full, so the main loop never waits on it.
+   */
+  void run_in_task(TaskAffinity task, std::function<void()> &&fn);
+
+  /// Longest time between two iterations of the network task loop since the last call, in milliseconds.
+  uint32_t take_network_max_loop_time() { return this->network_max_loop_time_.exchange(0); }
+  /// Number of calls dropped because the queue of the network task was full.
+  uint32_t get_network_dropped_calls() const { return this->network_dropped_calls_; }
+#endif
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
@@ -339,6 +370,7 @@ class Application {
 #endif
 
   Scheduler scheduler;
+  StateTable state_table;
 
  protected:
   friend Component;
@@ -346,11 +378,32 @@ class Application {
   void register_component_(Component *comp);
 
   void calculate_looping_components_();
+  void disable_component_loop_(Component *component);
+  void enable_component_loop_(Component *component);
 
   void feed_wdt_arch_();
 
+#ifdef USE_NETWORK_TASK
+  static void network_task_(void *params);
+  void network_loop_();
+  void process_task_queue_(TaskAffinity task);
+#endif
+
   std::vector<Component *> components_{};
+  /// Components with an enabled loop come first, up to looping_components_active_end_, the disabled ones after that.
   std::vector<Component *> looping_components_{};
+  size_t looping_components_active_end_{0};
+  /// Index of the next component loop() is called for, while the main loop iterates the components.
+  size_t current_loop_index_{0};
+#ifdef USE_NETWORK_TASK
+  std::vector<Component *> network_components_{};
+  TaskHandle_t task_handles_[2]{};
+  QueueHandle_t task_queues_[2]{};
+  std::atomic<uint32_t> network_app_state_{0};
+  std::atomic<uint32_t> network_max_loop_time_{0};
+  uint32_t network_last_loop_{0};
+  uint32_t network_dropped_calls_{0};
+#endif
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
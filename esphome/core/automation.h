@@ -29,14 +29,51 @@ template<typename T, typename... X> class TemplatableValue {
   template<typename F, enable_if_t<!is_invocable<F, X...>::value, int> = 0>
   TemplatableValue(F value) : type_(VALUE), value_(value) {}
 
-  template<typename F, enable_if_t<is_invocable<F, X...>::value, int> = 0>
-  TemplatableValue(F f) : type_(LAMBDA), f_(f) {}
+  /// Functions and lambdas without captures, like the shared lambdas of the code generator, need no std::function
+  template<typename F, enable_if_t<is_invocable<F, X...>::value && std::is_convertible<F, T (*)(X...)>::value, int> = 0>
+  TemplatableValue(F f) : type_(STATELESS_LAMBDA) {
+    this->callable_.stateless_f = f;
+  }
+
+  template<typename F,
+           enable_if_t<is_invocable<F, X...>::value && !std::is_convertible<F, T (*)(X...)>::value, int> = 0>
+  TemplatableValue(F f) : type_(LAMBDA) {
+    this->callable_.f = new std::function<T(X...)>(f);
+  }
+
+  TemplatableValue(const TemplatableValue &other) : type_(other.type_), value_(other.value_) {
+    if (this->type_ == LAMBDA) {
+      this->callable_.f = new std::function<T(X...)>(*other.callable_.f);
+    } else {
+      this->callable_ = other.callable_;
+    }
+  }
+
+  TemplatableValue(TemplatableValue &&other) noexcept
+      : type_(other.type_), value_(std::move(other.value_)), callable_(other.callable_) {
+    other.type_ = EMPTY;
+  }
+
+  TemplatableValue &operator=(TemplatableValue other) {
+    std::swap(this->type_, other.type_);
+    std::swap(this->value_, other.value_);
+    std::swap(this->callable_, other.callable_);
+    return *this;
+  }
+
+  ~TemplatableValue() {
+    if (this->type_ == LAMBDA)
+      delete this->callable_.f;
+  }
 
   bool has_value() { return this->type_ != EMPTY; }
 
   T value(X... x) {
+    if (this->type_ == STATELESS_LAMBDA) {
+      return this->callable_.stateless_f(x...);
+    }
     if (this->type_ == LAMBDA) {
-      return this->f_(x...);
+      return (*this->callable_.f)(x...);
     }
     // return value also when empty
     return this->value_;
@@ -57,14 +94,19 @@ template<typename T, typename... X> class TemplatableValue {
   }
 
  protected:
-  enum {
+  enum : uint8_t {
     EMPTY,
     VALUE,
     LAMBDA,
+    STATELESS_LAMBDA,
   } type_;
 
   T value_{};
-  std::function<T(X...)> f_{};
+  /// Only lambdas with captures pay for a std::function, which is allocated
+  union Callable {
+    std::function<T(X...)> *f;
+    T (*stateless_f)(X...);
+  } callable_{};
 };
 
 /** Base class for all automation conditions.
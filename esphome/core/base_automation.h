@@ -79,6 +79,11 @@ template<typename... Ts> class ForCondition : public Condition<Ts...>, public Co
 
   TEMPLATABLE_VALUE(uint32_t, time);
 
+  void setup() override {
+    // Nothing to track until the condition is used for the first time
+    if (!this->tracking_)
+      this->disable_loop();
+  }
   void loop() override { this->check_internal(); }
   float get_setup_priority() const override { return setup_priority::DATA; }
   bool check_internal() {
@@ -89,6 +94,12 @@ template<typename... Ts> class ForCondition : public Condition<Ts...>, public Co
   }
 
   bool check(Ts... x) override {
+    if (!this->tracking_) {
+      // Unknown how long the condition held before, so the time starts now
+      this->tracking_ = true;
+      this->last_inactive_ = millis();
+      this->enable_loop();
+    }
     if (!this->check_internal())
       return false;
     return millis() - this->last_inactive_ >= this->time_.value(x...);
@@ -97,6 +108,7 @@ template<typename... Ts> class ForCondition : public Condition<Ts...>, public Co
  protected:
   Condition<> *condition_;
   uint32_t last_inactive_{0};
+  bool tracking_{false};
 };
 
 class StartupTrigger : public Trigger<>, public Component {
@@ -304,12 +316,15 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
       this->set_timeout("timeout", this->timeout_value_.value(x...), f);
     }
 
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      this->disable_loop();
       return;
+    }
 
     if (!this->condition_->check_tuple(this->var_)) {
       return;
@@ -3,7 +3,10 @@
 #include <string>
 #include <functional>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -57,6 +60,7 @@ extern const uint32_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint32_t COMPONENT_STATE_SETUP;
 extern const uint32_t COMPONENT_STATE_LOOP;
 extern const uint32_t COMPONENT_STATE_FAILED;
+extern const uint32_t COMPONENT_STATE_LOOP_DONE;
 extern const uint32_t STATUS_LED_MASK;
 extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
@@ -64,6 +68,14 @@ extern const uint32_t STATUS_LED_ERROR;
 
 enum class RetryResult { DONE, RETRY };
 
+/// The task the loop() of a component runs on.
+enum class TaskAffinity : uint8_t {
+  /// The main loop task, which also runs setup() of all components and the scheduler.
+  CONTROL = 0,
+  /// The network task on the other core of dual-core ESP32s, only used if it is enabled.
+  NETWORK,
+};
+
 class Component {
  public:
   /** Where the component's initialization should happen.
@@ -102,6 +114,13 @@ class Component {
    */
   virtual float get_loop_priority() const;
 
+  /** The task loop() is called from, see Application::run_in_task().
+   *
+   * Network frontends return TaskAffinity::NETWORK so socket I/O does not delay control loops. Everything else they do
+   * with other components then has to go through Application::run_in_task(). Defaults to TaskAffinity::CONTROL.
+   */
+  virtual TaskAffinity get_task_affinity() const { return TaskAffinity::CONTROL; }
+
   void call();
 
   virtual void on_shutdown() {}
@@ -141,6 +160,58 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() until enable_loop() is called.
+   *
+   * For components that only have work now and then, like a queue that ran empty: the main loop skips them entirely
+   * instead of making a virtual call on every iteration. Safe to call from setup(), from loop() itself and from
+   * callbacks of other components running in the middle of the main loop.
+   */
+  void disable_loop();
+
+  /** Call loop() again after disable_loop().
+   *
+   * Typically called where new work is handed to the component. Does nothing if the loop is not disabled.
+   */
+  void enable_loop();
+
+  /// Whether loop() is called, false after disable_loop() and for failed components.
+  bool is_loop_enabled() const;
+
+#ifdef USE_WARM_STATE
+  /** Number of bytes of state this component keeps across warm restarts (deep sleep wakes and safe reboots).
+   *
+   * Defaults to 0, meaning the component always starts cold.
+   */
+  virtual size_t get_warm_state_size() const { return 0; }
+
+  /** Serialize the warm state into data, which is get_warm_state_size() bytes long.
+   *
+   * Called from the safe shutdown hooks, right before deep sleep or a safe reboot.
+   */
+  virtual void save_warm_state(uint8_t *data) {}
+
+  /** Restore the warm state written by save_warm_state() before the restart.
+   *
+   * Called before setup(). Return false if the data can't be used, the component then starts cold.
+   */
+  virtual bool restore_warm_state(const uint8_t *data) { return false; }
+
+  /** Mark this component as warm started.
+   *
+   * This is set by the warm_state component, and should not be called manually.
+   */
+  void set_warm_start(bool warm_start) { this->warm_start_ = warm_start; }
+#endif
+
+  /// Whether the warm state was restored, so setup() can skip expensive re-initialization.
+  bool is_warm_start() const {
+#ifdef USE_WARM_STATE
+    return this->warm_start_;
+#else
+    return false;
+#endif
+  }
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -271,6 +342,9 @@ class Component {
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+#ifdef USE_WARM_STATE
+  bool warm_start_{false};
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -23,8 +23,11 @@
 #define USE_CLIMATE
 #define USE_COVER
 #define USE_DEEP_SLEEP
+#define USE_DEEP_SLEEP_WAKE_CYCLE
+#define DEEP_SLEEP_WAKE_CYCLE_BUFFER_SIZE 16  // NOLINT
 #define USE_FAN
 #define USE_GRAPH
+#define USE_HISTORY
 #define USE_HOMEASSISTANT_TIME
 #define USE_JSON
 #define USE_LIGHT
@@ -49,6 +52,8 @@
 #define USE_TIME
 #define USE_TOUCHSCREEN
 #define USE_UART_DEBUGGER
+#define USE_WARM_STATE
+#define WARM_STATE_SIZE 256  // NOLINT
 #define USE_WIFI
 #define USE_WIFI_AP
 #define USE_GRAPHICAL_DISPLAY_MENU
@@ -57,6 +62,7 @@
 #ifdef USE_ARDUINO
 #define USE_CAPTIVE_PORTAL
 #define USE_NEXTION_TFT_UPLOAD
+#define USE_HISTORY_WEB_SERVER
 #define USE_PROMETHEUS
 #define USE_WEBSERVER
 #define USE_WEBSERVER_PORT 80  // NOLINT
@@ -74,6 +80,7 @@
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
 #define USE_IMPROV
+#define USE_NETWORK_TASK
 #define USE_SOCKET_IMPL_BSD_SOCKETS
 #define USE_WIFI_11KV_SUPPORT
 #define USE_BLUETOOTH_PROXY
@@ -81,6 +88,7 @@
 #define USE_MICROPHONE
 #define USE_SPEAKER
 #define USE_SPI
+#define USE_STEP_TIMER
 
 #ifdef USE_ARDUINO
 #define USE_ARDUINO_VERSION_CODE VERSION_CODE(2, 0, 5)
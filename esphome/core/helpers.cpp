@@ -569,6 +569,9 @@ void get_mac_address_raw(uint8_t *mac) {  // NOLINT(readability-non-const-parame
   WiFi.macAddress(mac);
 #elif defined(USE_LIBRETINY)
   WiFi.macAddress(mac);
+#else
+  // No MAC address on this platform, e.g. the host
+  memset(mac, 0, 6);
 #endif
 }
 std::string get_mac_address() {
@@ -18,6 +18,9 @@ class ESPPreferenceObject {
   ESPPreferenceObject() = default;
   ESPPreferenceObject(ESPPreferenceBackend *backend) : backend_(backend) {}
 
+  /// False when the storage had no room left for the preference, it then neither loads nor saves.
+  bool is_valid() const { return backend_ != nullptr; }
+
   template<typename T> bool save(const T *src) {
     if (backend_ == nullptr)
       return false;
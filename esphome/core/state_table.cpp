@@ -0,0 +1,220 @@
+#include "state_table.h"
+#include "esphome/core/application.h"
+#include "esphome/core/component_iterator.h"
+
+namespace esphome {
+
+#ifdef USE_NETWORK_TASK
+// A frontend on the network task rather skips a pass than holds up its other clients
+static const TickType_t STATE_LOCK_WAIT = pdMS_TO_TICKS(2);
+#endif
+
+void StateTable::init() {
+  if (this->initialized_)
+    return;
+  this->initialized_ = true;
+#ifdef USE_NETWORK_TASK
+  this->lock_ = xSemaphoreCreateMutex();
+#endif
+
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::BINARY_SENSOR);
+    obj->add_on_state_callback([this, index](bool /*state*/) { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_COVER
+  for (auto *obj : App.get_covers()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::COVER);
+    obj->add_on_state_callback([this, index]() { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_FAN
+  for (auto *obj : App.get_fans()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::FAN);
+    obj->add_on_state_callback([this, index]() { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_LIGHT
+  for (auto *obj : App.get_lights()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::LIGHT);
+    obj->add_new_remote_values_callback([this, index]() { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_SENSOR
+  for (auto *obj : App.get_sensors()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::SENSOR);
+    obj->add_on_state_callback([this, index](float /*state*/) { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_SWITCH
+  for (auto *obj : App.get_switches()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::SWITCH);
+    obj->add_on_state_callback([this, index](bool /*state*/) { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_TEXT_SENSOR
+  for (auto *obj : App.get_text_sensors()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::TEXT_SENSOR);
+    obj->add_on_state_callback([this, index](const std::string & /*state*/) { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_CLIMATE
+  for (auto *obj : App.get_climates()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::CLIMATE);
+    obj->add_on_state_callback([this, index](climate::Climate & /*unused*/) { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_NUMBER
+  for (auto *obj : App.get_numbers()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::NUMBER);
+    obj->add_on_state_callback([this, index](float /*state*/) { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_TEXT
+  for (auto *obj : App.get_texts()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::TEXT);
+    obj->add_on_state_callback([this, index](const std::string & /*state*/) { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_SELECT
+  for (auto *obj : App.get_selects()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::SELECT);
+    obj->add_on_state_callback(
+        [this, index](const std::string & /*state*/, size_t /*index*/) { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_LOCK
+  for (auto *obj : App.get_locks()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::LOCK);
+    obj->add_on_state_callback([this, index]() { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_MEDIA_PLAYER
+  for (auto *obj : App.get_media_players()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::MEDIA_PLAYER);
+    obj->add_on_state_callback([this, index]() { this->mark_changed_(index); });
+  }
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  for (auto *obj : App.get_alarm_control_panels()) {
+    const uint16_t index = this->add_slot_(obj, EntityType::ALARM_CONTROL_PANEL);
+    obj->add_on_state_callback([this, index]() { this->mark_changed_(index); });
+  }
+#endif
+}
+
+bool StateTable::send_changed(Cursor &cursor, ComponentIterator *iterator, bool include_internal) {
+  if (cursor.index == 0 && cursor.since == this->version_)
+    return true;
+#ifdef USE_NETWORK_TASK
+  const bool locked = this->lock_ != nullptr && !App.in_task(TaskAffinity::CONTROL);
+  if (locked && xSemaphoreTake(this->lock_, STATE_LOCK_WAIT) != pdTRUE)
+    return false;
+#endif
+
+  // Entities updated during a pass get a newer version than the pass and are sent again by the next one
+  if (cursor.index == 0)
+    cursor.until = this->version_;
+  bool complete = true;
+  for (; cursor.index < this->slots_.size(); cursor.index++) {
+    const Slot &slot = this->slots_[cursor.index];
+    if (slot.version <= cursor.since || (!include_internal && slot.entity->is_internal()))
+      continue;
+    if (!this->send_slot_(slot, iterator)) {
+      complete = false;
+      break;
+    }
+  }
+  if (complete) {
+    cursor.since = cursor.until;
+    cursor.index = 0;
+  }
+
+#ifdef USE_NETWORK_TASK
+  if (locked)
+    xSemaphoreGive(this->lock_);
+#endif
+  return complete;
+}
+
+#ifdef USE_NETWORK_TASK
+void StateTable::lock() {
+  if (this->lock_ != nullptr)
+    xSemaphoreTake(this->lock_, portMAX_DELAY);
+}
+void StateTable::unlock() {
+  if (this->lock_ != nullptr)
+    xSemaphoreGive(this->lock_);
+}
+#endif
+
+uint16_t StateTable::add_slot_(EntityBase *entity, EntityType type) {
+  this->slots_.push_back(Slot{entity, type, 1});
+  return this->slots_.size() - 1;
+}
+
+bool StateTable::send_slot_(const Slot &slot, ComponentIterator *iterator) {
+  switch (slot.type) {
+#ifdef USE_BINARY_SENSOR
+    case EntityType::BINARY_SENSOR:
+      return iterator->on_binary_sensor(static_cast<binary_sensor::BinarySensor *>(slot.entity));
+#endif
+#ifdef USE_COVER
+    case EntityType::COVER:
+      return iterator->on_cover(static_cast<cover::Cover *>(slot.entity));
+#endif
+#ifdef USE_FAN
+    case EntityType::FAN:
+      return iterator->on_fan(static_cast<fan::Fan *>(slot.entity));
+#endif
+#ifdef USE_LIGHT
+    case EntityType::LIGHT:
+      return iterator->on_light(static_cast<light::LightState *>(slot.entity));
+#endif
+#ifdef USE_SENSOR
+    case EntityType::SENSOR:
+      return iterator->on_sensor(static_cast<sensor::Sensor *>(slot.entity));
+#endif
+#ifdef USE_SWITCH
+    case EntityType::SWITCH:
+      return iterator->on_switch(static_cast<switch_::Switch *>(slot.entity));
+#endif
+#ifdef USE_TEXT_SENSOR
+    case EntityType::TEXT_SENSOR:
+      return iterator->on_text_sensor(static_cast<text_sensor::TextSensor *>(slot.entity));
+#endif
+#ifdef USE_CLIMATE
+    case EntityType::CLIMATE:
+      return iterator->on_climate(static_cast<climate::Climate *>(slot.entity));
+#endif
+#ifdef USE_NUMBER
+    case EntityType::NUMBER:
+      return iterator->on_number(static_cast<number::Number *>(slot.entity));
+#endif
+#ifdef USE_TEXT
+    case EntityType::TEXT:
+      return iterator->on_text(static_cast<text::Text *>(slot.entity));
+#endif
+#ifdef USE_SELECT
+    case EntityType::SELECT:
+      return iterator->on_select(static_cast<select::Select *>(slot.entity));
+#endif
+#ifdef USE_LOCK
+    case EntityType::LOCK:
+      return iterator->on_lock(static_cast<lock::Lock *>(slot.entity));
+#endif
+#ifdef USE_MEDIA_PLAYER
+    case EntityType::MEDIA_PLAYER:
+      return iterator->on_media_player(static_cast<media_player::MediaPlayer *>(slot.entity));
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+    case EntityType::ALARM_CONTROL_PANEL:
+      return iterator->on_alarm_control_panel(static_cast<alarm_control_panel::AlarmControlPanel *>(slot.entity));
+#endif
+    default:
+      return true;
+  }
+}
+
+}  // namespace esphome
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "esphome/core/defines.h"
+#include "esphome/core/entity_base.h"
+
+#ifdef USE_NETWORK_TASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+namespace esphome {
+
+class ComponentIterator;
+
+/** Versioned table of the entity states, for frontends pulling the changes instead of being called on every update.
+ *
+ * Each state update stamps the entity with the next value of a global version counter. A frontend keeps a Cursor per
+ * client and regularly sends the entities changed since its previous pass, so any number of updates in between cost a
+ * single message, a client that can't keep up is sent the latest states only and a reconnect resends everything once.
+ */
+class StateTable {
+ public:
+  /// Position of a frontend client in the table.
+  struct Cursor {
+    /// Entities with a newer version are sent, 0 sends all of them.
+    uint32_t since{0};
+    /// Version the running pass is complete up to.
+    uint32_t until{0};
+    /// Slot the running pass continues at.
+    uint16_t index{0};
+
+    void reset() { *this = Cursor{}; }
+  };
+
+  /// Register the state callbacks of all entities, only the first call does something.
+  void init();
+
+  /** Send the entities changed since the cursor to the iterator, in registration order.
+   *
+   * Stops at the first entity the iterator could not send and continues with it on the next call, the cursor only
+   * moves past the changes that were sent.
+   *
+   * @return Whether the cursor caught up with all changes.
+   */
+  bool send_changed(Cursor &cursor, ComponentIterator *iterator, bool include_internal = false);
+
+  uint32_t get_version() const { return this->version_; }
+
+#ifdef USE_NETWORK_TASK
+  /** Held by the main loop while a component or the scheduler runs, so frontends on the network task never read a
+   * half-updated state. Frontends only hold it to copy the changed states, never while writing to a socket.
+   */
+  void lock();
+  void unlock();
+
+  /// Holds the lock of a table for as long as it exists.
+  class Guard {
+   public:
+    explicit Guard(StateTable &table) : table_(table) { table_.lock(); }
+    ~Guard() { table_.unlock(); }
+
+   protected:
+    StateTable &table_;
+  };
+#endif
+
+ protected:
+  enum class EntityType : uint8_t {
+    BINARY_SENSOR,
+    COVER,
+    FAN,
+    LIGHT,
+    SENSOR,
+    SWITCH,
+    TEXT_SENSOR,
+    CLIMATE,
+    NUMBER,
+    TEXT,
+    SELECT,
+    LOCK,
+    MEDIA_PLAYER,
+    ALARM_CONTROL_PANEL,
+  };
+
+  struct Slot {
+    EntityBase *entity;
+    EntityType type;
+    uint32_t version;
+  };
+
+  uint16_t add_slot_(EntityBase *entity, EntityType type);
+  void mark_changed_(uint16_t index) { this->slots_[index].version = ++this->version_; }
+  bool send_slot_(const Slot &slot, ComponentIterator *iterator);
+
+  std::vector<Slot> slots_;
+  /// Version of the latest update, all entities start at 1 so a cursor at 0 gets every state.
+  std::atomic<uint32_t> version_{1};
+  bool initialized_{false};
+#ifdef USE_NETWORK_TASK
+  SemaphoreHandle_t lock_{nullptr};
+#endif
+};
+
+}  // namespace esphome
@@ -487,6 +487,8 @@ def variable(
         id_.type = type_
     assignment = AssignmentExpression(id_.type, "", id_, rhs)
     CORE.add(assignment)
+    # Local to setup(), lambdas using it can't become shared functions
+    CORE.data.setdefault(KEY_LOCAL_VARIABLES, set()).add(str(id_))
     if register:
         CORE.register_variable(id_, obj)
     return obj
@@ -649,12 +651,65 @@ async def get_variable_with_full_id(id_: ID) -> tuple[ID, "MockObj"]:
     return await CORE.get_variable_with_full_id(id_)
 
 
+KEY_LOCAL_VARIABLES = "cpp_generator_local_variables"
+KEY_SHARED_LAMBDAS = "cpp_generator_shared_lambdas"
+# Lambdas with state of their own can't be shared between their occurrences
+_STATIC_RE = re.compile(r"\bstatic\b")
+
+
+def _share_lambda(lambda_: LambdaExpression) -> Expression:
+    """Turn a lambda into a free function, defined once for all identical lambdas.
+
+    Packages repeat the same lambdas over many entities, each would otherwise be its
+    own lambda class and std::function. The lambda stays as it is when it must be
+    local to setup(): without a return type to declare, or when it refers to local
+    variables or has static variables.
+    """
+    if lambda_.return_type is None or lambda_.capture not in ("=", ""):
+        return lambda_
+    content = lambda_.content
+    if _STATIC_RE.search(content):
+        return lambda_
+    local_variables = CORE.data.get(KEY_LOCAL_VARIABLES, set())
+    if local_variables and any(
+        re.search(rf"\b{re.escape(name)}\b", content) for name in local_variables
+    ):
+        return lambda_
+
+    shared = CORE.data.setdefault(KEY_SHARED_LAMBDAS, {})
+    key = (str(lambda_.return_type), str(lambda_.parameters), content)
+    function = shared.get(key)
+    if function is None:
+        function = shared[key] = SharedLambda(f"shared_lambda_{len(shared)}")
+        cpp = f"static {lambda_.return_type} {function.name}({lambda_.parameters}) {{\n"
+        if lambda_.source is not None:
+            cpp += f"{lambda_.source.as_line_directive}\n"
+        cpp += f"{content}\n}}"
+        CORE.add_global(RawStatement(indent_all_but_first_and_last(cpp)))
+    function.uses += 1
+    return RawExpression(function.name)
+
+
+class SharedLambda:
+    __slots__ = ("name", "uses")
+
+    def __init__(self, name: str):
+        self.name = name
+        self.uses = 0
+
+
+def shared_lambda_stats() -> tuple[int, int]:
+    """The number of lambdas turned into shared functions, and of the functions."""
+    shared = CORE.data.get(KEY_SHARED_LAMBDAS, {})
+    return sum(function.uses for function in shared.values()), len(shared)
+
+
 async def process_lambda(
     value: Lambda,
     parameters: list[tuple[SafeExpType, str]],
     capture: str = "=",
     return_type: SafeExpType = None,
-) -> Generator[LambdaExpression, None, None]:
+) -> Generator[Expression, None, None]:
     """Process the given lambda value into a LambdaExpression.
 
     This is a coroutine because lambdas can depend on other IDs,
@@ -664,7 +719,8 @@ async def process_lambda(
     :param parameters: The parameters to pass to the Lambda, list of tuples
     :param capture: The capture expression for the lambda, usually ''.
     :param return_type: The return type of the lambda.
-    :return: The generated lambda expression.
+    :return: The generated lambda expression, or the name of the shared function
+      it became.
     """
     from esphome.components.globals import (
         GlobalsComponent,
@@ -700,7 +756,9 @@ async def process_lambda(
         location.line += value.content_offset
     else:
         location = None
-    return LambdaExpression(parts, parameters, capture, return_type, location)
+    return _share_lambda(
+        LambdaExpression(parts, parameters, capture, return_type, location)
+    )
 
 
 def is_template(value):
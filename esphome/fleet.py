@@ -0,0 +1,271 @@
+"""Compile many nodes at once.
+
+Nodes are grouped by target platform and framework. The first node of a group is
+built on its own so the platform and toolchain are installed once, the rest of the
+group then builds in parallel sharing the installed packages. The number of parallel
+builds follows the CPU count and the available memory, and every build gets its share
+of the compile processes.
+"""
+import asyncio
+from dataclasses import dataclass, field
+import json
+import os
+import re
+import time
+from typing import Optional
+
+from esphome.const import CONF_FRAMEWORK, CONF_TYPE, TARGET_PLATFORMS
+from esphome.core import EsphomeError
+from esphome.log import color, Fore
+from esphome.util import ANSI_ESCAPE
+
+PHASES = ("config", "codegen", "compile", "link")
+# Lines of the compile output starting a phase, config starts with the process
+PHASE_MARKERS = (
+    ("codegen", re.compile(r".*Generating C\+\+ source\.\.\.")),
+    ("compile", re.compile(r".*Compiling app\.\.\.")),
+    ("link", re.compile(r"Linking ")),
+)
+OBJECT_LINE = re.compile(r"Compiling ")
+# Report the object count of a build every this many objects
+PROGRESS_INTERVAL = 50
+# Peak memory of a build per compile process, gcc with the larger frameworks
+MEMORY_PER_PROCESS = 256 * 1024 * 1024
+# Lines of output shown for a failed build
+FAILURE_OUTPUT_LINES = 40
+# Platform of the configurations that failed to load or have no target platform
+UNKNOWN_PLATFORM = "unknown"
+
+
+@dataclass
+class FleetNode:
+    config_path: str
+    group: tuple[str, str]
+    status: str = "pending"
+    phases: dict[str, float] = field(default_factory=dict)
+    objects: int = 0
+    output: list[str] = field(default_factory=list)
+
+    @property
+    def name(self) -> str:
+        return os.path.splitext(os.path.basename(self.config_path))[0]
+
+
+def node_group(config_path: str) -> tuple[str, str]:
+    """The target platform and framework of a configuration, without validating it.
+
+    Configurations without a known platform get a group of their own, as nothing says
+    they share the installed packages with any other node.
+    """
+    from esphome import yaml_util
+
+    try:
+        config = yaml_util.load_yaml(config_path)
+    except EsphomeError:
+        return UNKNOWN_PLATFORM, config_path
+    for platform in TARGET_PLATFORMS:
+        if platform in config:
+            conf = config[platform] or {}
+            framework = conf.get(CONF_FRAMEWORK) or {}
+            return platform, str(framework.get(CONF_TYPE, ""))
+    return UNKNOWN_PLATFORM, config_path
+
+
+def _available_memory() -> Optional[int]:
+    try:
+        with open("/proc/meminfo", encoding="utf-8") as meminfo:
+            for line in meminfo:
+                if line.startswith("MemAvailable:"):
+                    return int(line.split()[1]) * 1024
+    except (OSError, ValueError, IndexError):
+        pass
+    return None
+
+
+def parallel_builds(nodes: int, requested: Optional[int] = None) -> tuple[int, int]:
+    """Number of builds to run at once, and of compile processes per build."""
+    cpus = os.cpu_count() or 1
+    if requested is not None:
+        builds = requested
+    else:
+        # Configuration, code generation and linking are single threaded, so half the
+        # CPUs in builds keeps the cores busy in every phase
+        builds = max(cpus // 2, 1)
+        memory = _available_memory()
+        if memory is not None:
+            builds = min(builds, memory // (2 * MEMORY_PER_PROCESS))
+    builds = max(min(builds, nodes), 1)
+    return builds, max(cpus // builds, 1)
+
+
+class FleetScheduler:
+    def __init__(self, nodes: list[FleetNode], builds: int, processes: int) -> None:
+        self.nodes = nodes
+        self.builds = builds
+        self.processes = processes
+        self._started = 0.0
+        self.wall_time = 0.0
+
+    def _may_start(self, running: int) -> bool:
+        if running == 0:
+            return True
+        if running >= self.builds:
+            return False
+        # Builds started earlier may not have reached their peak yet, hold back while
+        # memory runs out or the machine is overloaded by something else
+        memory = _available_memory()
+        if memory is not None and memory < self.processes * MEMORY_PER_PROCESS:
+            return False
+        try:
+            return os.getloadavg()[0] < 2 * (os.cpu_count() or 1)
+        except OSError:
+            return True
+
+    def _next_node(self, warm_groups: set, busy_groups: set) -> Optional[FleetNode]:
+        for node in self.nodes:
+            if node.status != "pending":
+                continue
+            # The first build of a group installs the platform, the others wait for it.
+            # Should it fail the next node of the group takes over.
+            if node.group in warm_groups or node.group not in busy_groups:
+                return node
+        return None
+
+    def _print(self, node: FleetNode, message: str) -> None:
+        done = sum(1 for n in self.nodes if n.status in ("success", "failed"))
+        print(f"[{done}/{len(self.nodes)}] {color(Fore.CYAN, node.name)}: {message}")
+
+    async def _build(self, node: FleetNode) -> None:
+        env = dict(os.environ)
+        env["ESPHOME_COMPILE_PROCESS_LIMIT"] = str(self.processes)
+        self._print(node, "config")
+        phase, phase_start = "config", time.monotonic()
+        try:
+            proc = await asyncio.create_subprocess_exec(
+                "esphome",
+                "compile",
+                node.config_path,
+                stdout=asyncio.subprocess.PIPE,
+                stderr=asyncio.subprocess.STDOUT,
+                env=env,
+                # Verbose builds print long compiler command lines
+                limit=1024 * 1024,
+            )
+        except OSError as err:
+            node.status = "failed"
+            self._print(node, color(Fore.BOLD_RED, f"FAILED to start: {err}"))
+            return
+        while True:
+            raw = await proc.stdout.readline()
+            if not raw:
+                break
+            line = ANSI_ESCAPE.sub("", raw.decode("utf-8", "replace")).rstrip()
+            node.output = node.output[-(FAILURE_OUTPUT_LINES - 1) :] + [line]
+            for next_phase, marker in PHASE_MARKERS:
+                if PHASES.index(next_phase) > PHASES.index(phase) and marker.match(
+                    line
+                ):
+                    now = time.monotonic()
+                    node.phases[phase] = now - phase_start
+                    phase, phase_start = next_phase, now
+                    self._print(node, phase)
+            if phase == "compile" and OBJECT_LINE.match(line):
+                node.objects += 1
+                if node.objects % PROGRESS_INTERVAL == 0:
+                    self._print(node, f"compile, {node.objects} objects")
+        rc = await proc.wait()
+        node.phases[phase] = time.monotonic() - phase_start
+
+        node.status = "success" if rc == 0 else "failed"
+        total = sum(node.phases.values())
+        if rc == 0:
+            self._print(node, color(Fore.GREEN, f"SUCCESS in {total:.0f}s"))
+        else:
+            self._print(node, color(Fore.BOLD_RED, f"FAILED after {total:.0f}s"))
+            for line in node.output:
+                print(f"    {line}")
+
+    async def run(self) -> None:
+        self._started = time.monotonic()
+        tasks: dict[asyncio.Task, FleetNode] = {}
+        warm_groups: set = set()
+        while True:
+            busy_groups = {node.group for node in tasks.values()}
+            node = None
+            if self._may_start(len(tasks)):
+                node = self._next_node(warm_groups, busy_groups)
+            if node is not None:
+                node.status = "running"
+                tasks[asyncio.create_task(self._build(node))] = node
+                continue
+            if not tasks:
+                break
+            # Re-check memory and load from time to time while builds are running
+            done, _ = await asyncio.wait(
+                tasks, timeout=5, return_when=asyncio.FIRST_COMPLETED
+            )
+            for task in done:
+                finished = tasks.pop(task)
+                task.result()
+                if finished.status == "success":
+                    warm_groups.add(finished.group)
+        self.wall_time = time.monotonic() - self._started
+
+    def report(self) -> dict:
+        return {
+            "wall_time": self.wall_time,
+            "builds": self.builds,
+            "processes_per_build": self.processes,
+            "nodes": [
+                {
+                    "config": node.config_path,
+                    "platform": node.group[0],
+                    "framework": (
+                        "" if node.group[0] == UNKNOWN_PLATFORM else node.group[1]
+                    ),
+                    "status": node.status,
+                    "objects": node.objects,
+                    "phases": {p: node.phases.get(p, 0.0) for p in PHASES},
+                }
+                for node in self.nodes
+            ],
+        }
+
+    def print_report(self) -> None:
+        width = max([len(node.name) for node in self.nodes] + [4])
+        print()
+        header = "".join(f"{p:>10}" for p in PHASES)
+        print(f"{'NODE':<{width}}  {'STATUS':<8}{header}{'TOTAL':>10}")
+        totals = dict.fromkeys(PHASES, 0.0)
+        for node in self.nodes:
+            times = [node.phases.get(p, 0.0) for p in PHASES]
+            for p, t in zip(PHASES, times):
+                totals[p] += t
+            cells = "".join(f"{t:>9.1f}s" for t in times)
+            status = node.status.upper()
+            print(f"{node.name:<{width}}  {status:<8}{cells}{sum(times):>9.1f}s")
+        cells = "".join(f"{totals[p]:>9.1f}s" for p in PHASES)
+        print(f"{'SUM':<{width}}  {'':<8}{cells}{sum(totals.values()):>9.1f}s")
+        print(
+            f"Built {len(self.nodes)} nodes in {self.wall_time:.1f}s, "
+            f"{self.builds} at once with {self.processes} compile processes each"
+        )
+
+
+def compile_fleet(
+    config_paths: list[str],
+    builds: Optional[int] = None,
+    report_path: Optional[str] = None,
+) -> list[FleetNode]:
+    """Compile the configurations in parallel and print a build time report by phase."""
+    nodes = [FleetNode(path, node_group(path)) for path in config_paths]
+    # Build and report the nodes of a group together
+    order = list(dict.fromkeys(node.group for node in nodes))
+    nodes.sort(key=lambda node: order.index(node.group))
+    scheduler = FleetScheduler(nodes, *parallel_builds(len(nodes), builds))
+    asyncio.run(scheduler.run())
+    scheduler.print_report()
+    if report_path is not None:
+        with open(report_path, "w", encoding="utf-8") as report:
+            json.dump(scheduler.report(), report, indent=2)
+    return nodes
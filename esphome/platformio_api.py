@@ -105,6 +105,9 @@ def run_compile(config, verbose):
     args = []
     if CONF_COMPILE_PROCESS_LIMIT in config[CONF_ESPHOME]:
         args += [f"-j{config[CONF_ESPHOME][CONF_COMPILE_PROCESS_LIMIT]}"]
+    elif "ESPHOME_COMPILE_PROCESS_LIMIT" in os.environ:
+        # Share of the CPUs given by a fleet build, see esphome/fleet.py
+        args += [f"-j{os.environ['ESPHOME_COMPILE_PROCESS_LIMIT']}"]
     return run_platformio_cli_run(config, verbose, *args)
 
 
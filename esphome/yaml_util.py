@@ -1,5 +1,6 @@
 import fnmatch
 import functools
+import hashlib
 import inspect
 import logging
 import math
@@ -10,7 +11,7 @@ import yaml
 import yaml.constructor
 
 from esphome import core
-from esphome.config_helpers import read_config_file, Extend, Remove
+from esphome.config_helpers import copy_config, read_config_file, Extend, Remove
 from esphome.core import (
     EsphomeError,
     IPAddress,
@@ -39,6 +40,11 @@ _LOGGER = logging.getLogger(__name__)
 SECRET_YAML = "secrets.yaml"
 _SECRET_CACHE = {}
 _SECRET_VALUES = {}
+# Parsed files by path, for processes that load the same configuration over and
+# over like the dashboard editor validation, see _load_yaml_internal
+_LOAD_CACHE = {}
+# Entries of the files currently being parsed, innermost last
+_LOADING = []
 
 
 class ESPHomeDataBase:
@@ -230,6 +236,7 @@ class ESPHomeLoader(FastestAvailableSafeLoader):
 
     @_add_data_ref
     def construct_env_var(self, node):
+        _mark_uncacheable()
         args = node.value.split()
         # Check for a default value
         if len(args) > 1:
@@ -254,6 +261,10 @@ class ESPHomeLoader(FastestAvailableSafeLoader):
         except EsphomeError as e:
             if self.name == CORE.config_path:
                 raise e
+            # Which secrets.yaml this resolves to depends on the main configuration,
+            # not only on the files read, so neither this file nor its parents can be
+            # reused for another configuration
+            _mark_uncacheable()
             try:
                 main_config_dir = os.path.dirname(CORE.config_path)
                 main_secret_yml = os.path.join(main_config_dir, SECRET_YAML)
@@ -267,6 +278,8 @@ class ESPHomeLoader(FastestAvailableSafeLoader):
             )
         val = secrets[node.value]
         _SECRET_VALUES[str(val)] = node.value
+        for entry in _LOADING:
+            entry.secrets[str(val)] = node.value
         return val
 
     @_add_data_ref
@@ -325,11 +338,14 @@ class ESPHomeLoader(FastestAvailableSafeLoader):
 
     @_add_data_ref
     def construct_include_dir_list(self, node):
+        # The directory listing is not tracked, files may be added or removed
+        _mark_uncacheable()
         files = filter_yaml_files(_find_files(self._rel_path(node.value), "*.yaml"))
         return [_load_yaml_internal(f) for f in files]
 
     @_add_data_ref
     def construct_include_dir_merge_list(self, node):
+        _mark_uncacheable()
         files = filter_yaml_files(_find_files(self._rel_path(node.value), "*.yaml"))
         merged_list = []
         for fname in files:
@@ -340,6 +356,7 @@ class ESPHomeLoader(FastestAvailableSafeLoader):
 
     @_add_data_ref
     def construct_include_dir_named(self, node):
+        _mark_uncacheable()
         files = filter_yaml_files(_find_files(self._rel_path(node.value), "*.yaml"))
         mapping = OrderedDict()
         for fname in files:
@@ -349,6 +366,7 @@ class ESPHomeLoader(FastestAvailableSafeLoader):
 
     @_add_data_ref
     def construct_include_dir_merge_named(self, node):
+        _mark_uncacheable()
         files = filter_yaml_files(_find_files(self._rel_path(node.value), "*.yaml"))
         mapping = OrderedDict()
         for fname in files:
@@ -416,16 +434,90 @@ def load_yaml(fname, clear_secrets=True):
     return _load_yaml_internal(fname)
 
 
+class _LoadCacheEntry:
+    def __init__(self, digest):
+        self.digest = digest
+        # Digest of every file read for this one, None for files that were missing
+        self.dependencies = {}
+        self.secrets = {}
+        self.cacheable = True
+        self.data = None
+
+
+def _mark_uncacheable():
+    for entry in _LOADING:
+        entry.cacheable = False
+
+
+def _content_digest(content):
+    return hashlib.sha256(content.encode("utf-8")).hexdigest()
+
+
+def _file_digest(fname):
+    try:
+        return _content_digest(read_config_file(fname))
+    except EsphomeError:
+        return None
+
+
+def clear_load_cache():
+    _LOAD_CACHE.clear()
+
+
 def _load_yaml_internal(fname):
-    content = read_config_file(fname)
+    """Parse a file, or reuse an earlier parse while none of its files changed.
+
+    A cache entry is keyed by the path and the digest of the content, and stays valid
+    as long as the files it included (and secrets.yaml) still have the same digest.
+    Files using !env_var or !include_dir_* are always parsed again. Callers get their
+    own copy of the containers, as substitutions and validation modify the
+    configuration in place.
+    """
+    key = os.path.abspath(fname)
+    try:
+        content = read_config_file(fname)
+    except EsphomeError:
+        # Optional files like a local secrets.yaml, the parent is stale once they appear
+        for parent in _LOADING:
+            parent.dependencies[key] = None
+        raise
+    digest = _content_digest(content)
+    for parent in _LOADING:
+        parent.dependencies[key] = digest
+
+    entry = _LOAD_CACHE.get(key)
+    if (
+        entry is not None
+        and entry.digest == digest
+        and all(
+            _file_digest(dep) == dep_digest
+            for dep, dep_digest in entry.dependencies.items()
+        )
+    ):
+        for parent in _LOADING:
+            parent.dependencies.update(entry.dependencies)
+            parent.secrets.update(entry.secrets)
+        _SECRET_VALUES.update(entry.secrets)
+        return copy_config(entry.data)
+
+    entry = _LoadCacheEntry(digest)
+    _LOADING.append(entry)
     loader = ESPHomeLoader(content)
     loader.name = fname
     try:
-        return loader.get_single_data() or OrderedDict()
+        data = loader.get_single_data() or OrderedDict()
     except yaml.YAMLError as exc:
         raise EsphomeError(exc) from exc
     finally:
         loader.dispose()
+        _LOADING.pop()
+
+    if entry.cacheable:
+        entry.data = copy_config(data)
+        _LOAD_CACHE[key] = entry
+    else:
+        _LOAD_CACHE.pop(key, None)
+    return data
 
 
 def dump(dict_, show_secrets=False):
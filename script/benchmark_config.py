@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Time loading and validating large synthetic configurations.
+
+Runs the way the dashboard editor validation does, in one process: a cold load with
+empty caches, a load of the unchanged files and a load after editing a single block.
+"""
+import argparse
+from pathlib import Path
+import statistics
+import sys
+import tempfile
+import time
+
+from esphome import yaml_util
+from esphome.config import clear_schema_cache, load_config
+from esphome.core import CORE
+
+PACKAGE = """\
+sensor:
+{sensors}
+binary_sensor:
+{binary_sensors}
+switch:
+{switches}
+"""
+
+SENSOR = """\
+  - platform: template
+    name: "${{prefix}} {group} sensor {index}"
+    id: sensor_{group}_{index}
+    unit_of_measurement: "°C"
+    accuracy_decimals: 1
+    update_interval: 60s
+    lambda: return {index}.0f;
+    filters:
+      - offset: 0.5
+      - sliding_window_moving_average:
+          window_size: 5
+          send_every: 5
+"""
+
+BINARY_SENSOR = """\
+  - platform: template
+    name: "${{prefix}} {group} binary sensor {index}"
+    id: binary_sensor_{group}_{index}
+    lambda: return id(sensor_{group}_{index}).state > {index};
+"""
+
+SWITCH = """\
+  - platform: template
+    name: "${{prefix}} {group} switch {index}"
+    id: switch_{group}_{index}
+    optimistic: true
+"""
+
+MAIN = """\
+substitutions:
+  prefix: Benchmark
+
+esphome:
+  name: benchmark
+
+host:
+
+logger:
+
+api:
+
+packages:
+{packages}
+"""
+
+
+def write_config(directory: Path, entities: int, groups: int) -> Path:
+    per_group = max(entities // (3 * groups), 1)
+    packages = []
+    for group in range(groups):
+        name = f"group_{group}"
+        (directory / f"{name}.yaml").write_text(
+            PACKAGE.format(
+                sensors="".join(
+                    SENSOR.format(group=name, index=i) for i in range(per_group)
+                ),
+                binary_sensors="".join(
+                    BINARY_SENSOR.format(group=name, index=i) for i in range(per_group)
+                ),
+                switches="".join(
+                    SWITCH.format(group=name, index=i) for i in range(per_group)
+                ),
+            )
+        )
+        packages.append(f"  {name}: !include {name}.yaml")
+    main = directory / "benchmark.yaml"
+    main.write_text(MAIN.format(packages="\n".join(packages)))
+    return main
+
+
+def load(config_path: Path) -> float:
+    CORE.reset()
+    CORE.config_path = str(config_path)
+    start = time.perf_counter()
+    result = load_config({})
+    elapsed = time.perf_counter() - start
+    if result.errors:
+        raise RuntimeError(f"Invalid benchmark config: {result.errors[0]}")
+    return elapsed
+
+
+def edit_one_block(directory: Path) -> None:
+    # Same length, so the document ranges of the other blocks stay the same
+    package = directory / "group_0.yaml"
+    content = package.read_text()
+    if "return 0.0f;" in content:
+        content = content.replace("return 0.0f;", "return 9.0f;", 1)
+    else:
+        content = content.replace("return 9.0f;", "return 0.0f;", 1)
+    package.write_text(content)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--entities", type=int, default=400)
+    parser.add_argument("--groups", type=int, default=8)
+    parser.add_argument("--rounds", type=int, default=5)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+        directory = Path(directory)
+        config_path = write_config(directory, args.entities, args.groups)
+        timings = {"cold": [], "unchanged": [], "one block edited": []}
+        for _ in range(args.rounds):
+            yaml_util.clear_load_cache()
+            clear_schema_cache()
+            timings["cold"].append(load(config_path))
+            timings["unchanged"].append(load(config_path))
+            edit_one_block(directory)
+            timings["one block edited"].append(load(config_path))
+
+    print(f"{args.entities} entities in {args.groups} packages, {args.rounds} rounds")
+    cold = statistics.median(timings["cold"])
+    for name, values in timings.items():
+        median = statistics.median(values)
+        print(f"  {name:<18} {median * 1000:8.1f} ms  ({cold / median:4.1f}x)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""Build and run the microbenchmarks of tests/benchmarks on the host.
+
+The benchmarks are compiled with the host compiler against the sources of esphome/core
+and the components they cover. Results can be written as JSON in the format of Google
+Benchmark and compared with the results of another commit:
+
+    script/benchmark_core.py --output before.json
+    git checkout ...
+    script/benchmark_core.py --compare before.json
+"""
+import argparse
+from concurrent.futures import ThreadPoolExecutor
+import json
+import os
+from pathlib import Path
+import subprocess
+import sys
+import tempfile
+from typing import Optional
+
+ROOT = Path(__file__).resolve().parent.parent
+BENCHMARKS = ROOT / "tests" / "benchmarks"
+
+SOURCES = [
+    "esphome/core/application.cpp",
+    "esphome/core/color.cpp",
+    "esphome/core/component.cpp",
+    "esphome/core/entity_base.cpp",
+    "esphome/core/helpers.cpp",
+    "esphome/core/log.cpp",
+    "esphome/core/scheduler.cpp",
+    "esphome/core/string_ref.cpp",
+    "esphome/core/time.cpp",
+    "esphome/core/util.cpp",
+    "esphome/components/host/core.cpp",
+    "esphome/components/host/preferences.cpp",
+    "esphome/components/logger/logger.cpp",
+    "esphome/components/sensor/sensor.cpp",
+    "esphome/components/sensor/filter.cpp",
+    "esphome/components/display/display_color_convert.cpp",
+]
+JSON_SOURCES = ["esphome/components/json/json_util.cpp"]
+
+# Replaces esphome/core/defines.h, which enables everything for the IDE
+DEFINES = """\
+#pragma once
+#define USE_LOGGER
+#define USE_SENSOR
+"""
+
+
+def find_arduinojson() -> Optional[Path]:
+    candidates = list(ROOT.glob(".pio/libdeps/*/ArduinoJson/src"))
+    candidates += list(Path.home().glob(".platformio/lib/ArduinoJson*/src"))
+    for candidate in candidates:
+        if (candidate / "ArduinoJson.h").is_file():
+            return candidate
+    return None
+
+
+def compile_source(cxx: str, flags: list[str], source: Path, obj: Path) -> None:
+    extra = []
+    if source.match("components/host/core.cpp"):
+        # The benchmark runner brings its own main()
+        extra = ["-Dmain=esphome_host_main"]
+    subprocess.run(
+        [cxx, *flags, *extra, "-c", str(source), "-o", str(obj)], check=True
+    )
+
+
+def build(cxx: str, build_dir: Path, arduinojson: Optional[Path]) -> Path:
+    include = build_dir / "include"
+    (include / "esphome" / "core").mkdir(parents=True, exist_ok=True)
+    (include / "esphome" / "core" / "defines.h").write_text(DEFINES)
+
+    flags = ["-std=gnu++17", "-O2", "-DNDEBUG", "-DUSE_HOST", f"-I{include}"]
+    # Not in defines.h, some sources include log.h before it
+    flags += ["-DESPHOME_LOG_LEVEL=ESPHOME_LOG_LEVEL_DEBUG"]
+    flags += [f"-I{ROOT}", "-Wall", "-Wextra", "-Wno-unused-parameter"]
+    sources = [ROOT / source for source in SOURCES]
+    if arduinojson is not None:
+        flags.append(f"-I{arduinojson}")
+        sources += [ROOT / source for source in JSON_SOURCES]
+    sources += sorted(BENCHMARKS.glob("*.cpp"))
+
+    objects = [
+        build_dir / (source.relative_to(ROOT).as_posix().replace("/", "_") + ".o")
+        for source in sources
+    ]
+    with ThreadPoolExecutor(os.cpu_count()) as executor:
+        for future in [
+            executor.submit(compile_source, cxx, flags, source, obj)
+            for source, obj in zip(sources, objects)
+        ]:
+            future.result()
+
+    binary = build_dir / "benchmarks"
+    subprocess.run(
+        [cxx, *[str(obj) for obj in objects], "-o", str(binary), "-lpthread"],
+        check=True,
+    )
+    return binary
+
+
+def compare(baseline_path: Path, results: dict) -> None:
+    baseline = {
+        benchmark["name"]: benchmark
+        for benchmark in json.loads(baseline_path.read_text())["benchmarks"]
+    }
+    print(f"\n{'Benchmark':<44} {'Before':>12} {'After':>12} {'Change':>8}")
+    for benchmark in results["benchmarks"]:
+        before = baseline.get(benchmark["name"])
+        after = benchmark["real_time"]
+        if before is None:
+            print(f"{benchmark['name']:<44} {'-':>12} {after:>9.1f} ns {'new':>8}")
+            continue
+        change = (after - before["real_time"]) / before["real_time"] * 100
+        print(
+            f"{benchmark['name']:<44} {before['real_time']:>9.1f} ns "
+            f"{after:>9.1f} ns {change:>+7.1f}%"
+        )
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("--output", type=Path, help="write the results to this file")
+    parser.add_argument("--compare", type=Path, help="results to compare with")
+    parser.add_argument("--filter", help="only run benchmarks containing this")
+    parser.add_argument("--min-time", type=float, default=0.2)
+    parser.add_argument("--repetitions", type=int, default=3)
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"))
+    parser.add_argument(
+        "--arduinojson", type=Path, help="ArduinoJson src directory, for json"
+    )
+    parser.add_argument(
+        "--build-dir", type=Path, help="keep the build here instead of a temp dir"
+    )
+    args = parser.parse_args()
+
+    arduinojson = args.arduinojson or find_arduinojson()
+    if arduinojson is None:
+        print("ArduinoJson not found, skipping the json benchmarks", file=sys.stderr)
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        build_dir = args.build_dir or Path(temp_dir)
+        build_dir.mkdir(parents=True, exist_ok=True)
+        binary = build(args.cxx, build_dir, arduinojson)
+
+        output = build_dir / "results.json"
+        command = [
+            str(binary),
+            f"--benchmark_out={output}",
+            f"--benchmark_min_time={args.min_time}",
+            f"--benchmark_repetitions={args.repetitions}",
+        ]
+        if args.filter:
+            command.append(f"--benchmark_filter={args.filter}")
+        subprocess.run(command, check=True)
+        results = json.loads(output.read_text())
+
+    if args.output:
+        args.output.write_text(json.dumps(results, indent=2) + "\n")
+    if args.compare:
+        compare(args.compare, results)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
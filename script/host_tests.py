@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Build and run the C++ unit tests of tests/host_tests on the host.
+
+The tests are compiled with the host compiler against the sources of esphome/core and
+the components they cover, like the benchmarks of script/benchmark_core.py:
+
+    script/host_tests.py
+    script/host_tests.py --filter plan_segments
+"""
+import argparse
+from concurrent.futures import ThreadPoolExecutor
+import os
+from pathlib import Path
+import subprocess
+import sys
+import tempfile
+
+from benchmark_core import ROOT, SOURCES as CORE_SOURCES, compile_source
+
+TESTS = ROOT / "tests" / "host_tests"
+
+SOURCES = CORE_SOURCES + [
+    "esphome/components/modbus/modbus.cpp",
+    "esphome/components/modbus_controller/modbus_controller.cpp",
+    "esphome/components/modbus_gateway/modbus_gateway.cpp",
+    "esphome/components/socket/bsd_sockets_impl.cpp",
+    "esphome/components/socket/socket.cpp",
+    "esphome/components/stepper/planner.cpp",
+    "esphome/components/uart/uart.cpp",
+    "esphome/components/uart/uart_component.cpp",
+]
+
+# Replaces esphome/core/defines.h, which enables everything for the IDE
+DEFINES = """\
+#pragma once
+#define USE_LOGGER
+#define USE_SENSOR
+#define USE_SOCKET_IMPL_BSD_SOCKETS
+"""
+
+
+def build(cxx: str, build_dir: Path) -> Path:
+    include = build_dir / "include"
+    (include / "esphome" / "core").mkdir(parents=True, exist_ok=True)
+    (include / "esphome" / "core" / "defines.h").write_text(DEFINES)
+
+    flags = ["-std=gnu++17", "-O1", "-g", "-DUSE_HOST", f"-I{include}"]
+    # Not in defines.h, some sources include log.h before it
+    flags += ["-DESPHOME_LOG_LEVEL=ESPHOME_LOG_LEVEL_DEBUG"]
+    flags += [f"-I{ROOT}", "-Wall", "-Wextra", "-Wno-unused-parameter"]
+    sources = [ROOT / source for source in SOURCES]
+    sources += sorted(TESTS.glob("*.cpp"))
+
+    objects = [
+        build_dir / (source.relative_to(ROOT).as_posix().replace("/", "_") + ".o")
+        for source in sources
+    ]
+    with ThreadPoolExecutor(os.cpu_count()) as executor:
+        for future in [
+            executor.submit(compile_source, cxx, flags, source, obj)
+            for source, obj in zip(sources, objects)
+        ]:
+            future.result()
+
+    binary = build_dir / "host_tests"
+    subprocess.run(
+        [cxx, *[str(obj) for obj in objects], "-o", str(binary), "-lpthread"],
+        check=True,
+    )
+    return binary
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("--filter", help="only run tests containing this")
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"))
+    parser.add_argument(
+        "--build-dir", type=Path, help="keep the build here instead of a temp dir"
+    )
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        build_dir = args.build_dir or Path(temp_dir)
+        build_dir.mkdir(parents=True, exist_ok=True)
+        binary = build(args.cxx, build_dir)
+
+        command = [str(binary)]
+        if args.filter:
+            command.append(f"--filter={args.filter}")
+        return subprocess.run(command, check=False).returncode
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,62 @@
+#include "benchmark.h"
+
+#include "esphome/components/api/proto.h"
+
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::api;
+
+// the fields of a SensorStateResponse and of a typical ListEntitiesSensorResponse
+static void bm_proto_encode_sensor_state(benchmark::State &state) {
+  std::vector<uint8_t> buffer;
+  float value = 21.5f;
+  for ([[maybe_unused]] auto _ : state) {
+    buffer.clear();
+    ProtoWriteBuffer out(&buffer);
+    out.encode_fixed32(1, 0x12345678);
+    out.encode_float(2, value);
+    out.encode_bool(3, false);
+    value += 0.01f;
+    benchmark::do_not_optimize(buffer.data());
+  }
+}
+BENCHMARK(bm_proto_encode_sensor_state);
+
+static void bm_proto_encode_list_entities(benchmark::State &state) {
+  const std::string object_id = "living_room_temperature";
+  const std::string name = "Living Room Temperature";
+  const std::string unique_id = "livingroomsensorliving_room_temperature";
+  const std::string unit = "°C";
+  const std::string device_class = "temperature";
+  std::vector<uint8_t> buffer;
+  for ([[maybe_unused]] auto _ : state) {
+    buffer.clear();
+    ProtoWriteBuffer out(&buffer);
+    out.encode_string(1, object_id);
+    out.encode_fixed32(2, 0x12345678);
+    out.encode_string(3, name);
+    out.encode_string(4, unique_id);
+    out.encode_string(6, unit);
+    out.encode_int32(7, 1);
+    out.encode_bool(8, false);
+    out.encode_string(9, device_class);
+    out.encode_enum<uint32_t>(10, 1);
+    benchmark::do_not_optimize(buffer.data());
+  }
+}
+BENCHMARK(bm_proto_encode_list_entities);
+
+static void bm_proto_encode_varint(benchmark::State &state) {
+  std::vector<uint8_t> buffer;
+  for ([[maybe_unused]] auto _ : state) {
+    buffer.clear();
+    ProtoWriteBuffer out(&buffer);
+    for (uint32_t value = 1; value < (1u << 28); value <<= 3)
+      out.encode_uint32(1, value);
+    benchmark::do_not_optimize(buffer.data());
+  }
+  state.set_items_per_iteration(10);
+}
+BENCHMARK(bm_proto_encode_varint);
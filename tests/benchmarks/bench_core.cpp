@@ -0,0 +1,117 @@
+#include "benchmark.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/color.h"
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/scheduler.h"
+
+#include <string>
+
+using namespace esphome;
+
+static void bm_scheduler_set_cancel_timeout(benchmark::State &state) {
+  // cancelled timeouts are only dropped by call(), without it every iteration would scan all previous ones
+  Component component;
+  for ([[maybe_unused]] auto _ : state) {
+    App.scheduler.set_timeout(&component, "timeout", 60000, []() {});
+    App.scheduler.cancel_timeout(&component, "timeout");
+    App.scheduler.call();
+  }
+}
+BENCHMARK(bm_scheduler_set_cancel_timeout);
+
+static void bm_scheduler_call_idle(benchmark::State &state) {
+  // the typical main loop: a few intervals registered, none of them due
+  Component component;
+  for (int i = 0; i < 16; i++)
+    App.scheduler.set_interval(&component, "interval" + to_string(i), 3600000, []() {});
+  App.scheduler.call();
+  for ([[maybe_unused]] auto _ : state)
+    App.scheduler.call();
+  for (int i = 0; i < 16; i++)
+    App.scheduler.cancel_interval(&component, "interval" + to_string(i));
+  App.scheduler.call();
+}
+BENCHMARK(bm_scheduler_call_idle);
+
+static void bm_scheduler_call_due(benchmark::State &state) {
+  Component component;
+  uint32_t calls = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    App.scheduler.set_timeout(&component, "", 0, [&calls]() { calls++; });
+    App.scheduler.call();
+  }
+  benchmark::do_not_optimize(calls);
+}
+BENCHMARK(bm_scheduler_call_due);
+
+static void bm_callback_manager_call(benchmark::State &state) {
+  CallbackManager<void(float)> callbacks;
+  float sum = 0;
+  for (int i = 0; i < 4; i++)
+    callbacks.add([&sum](float value) { sum += value; });
+  for ([[maybe_unused]] auto _ : state)
+    callbacks.call(1.0f);
+  benchmark::do_not_optimize(sum);
+  state.set_items_per_iteration(4);
+}
+BENCHMARK(bm_callback_manager_call);
+
+static void bm_fnv1_hash(benchmark::State &state) {
+  const std::string name = "living_room_temperature_sensor";
+  for ([[maybe_unused]] auto _ : state)
+    benchmark::do_not_optimize(fnv1_hash(name));
+  state.set_items_per_iteration(name.size());
+}
+BENCHMARK(bm_fnv1_hash);
+
+static void bm_crc16_modbus_frame(benchmark::State &state) {
+  uint8_t frame[256];
+  for (size_t i = 0; i < sizeof(frame); i++)
+    frame[i] = i * 7;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::clobber_memory();
+    benchmark::do_not_optimize(crc16(frame, sizeof(frame)));
+  }
+  state.set_items_per_iteration(sizeof(frame));
+}
+BENCHMARK(bm_crc16_modbus_frame);
+
+static void bm_color_blend(benchmark::State &state) {
+  Color a(200, 100, 50);
+  Color b(10, 20, 250);
+  uint8_t amount = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    Color c = a.gradient(b, amount++);
+    benchmark::do_not_optimize(c.raw_32);
+  }
+}
+BENCHMARK(bm_color_blend);
+
+static void bm_rgb_to_hsv(benchmark::State &state) {
+  float red = 0.1f;
+  int hue;
+  float saturation, value;
+  for ([[maybe_unused]] auto _ : state) {
+    rgb_to_hsv(red, 0.5f, 0.9f, hue, saturation, value);
+    benchmark::do_not_optimize(hue);
+    benchmark::do_not_optimize(saturation);
+    benchmark::do_not_optimize(value);
+    red = red < 1.0f ? red + 0.001f : 0.0f;
+  }
+}
+BENCHMARK(bm_rgb_to_hsv);
+
+static void bm_hsv_to_rgb(benchmark::State &state) {
+  int hue = 0;
+  float red, green, blue;
+  for ([[maybe_unused]] auto _ : state) {
+    hsv_to_rgb(hue, 0.8f, 0.9f, red, green, blue);
+    benchmark::do_not_optimize(red);
+    benchmark::do_not_optimize(green);
+    benchmark::do_not_optimize(blue);
+    hue = (hue + 1) % 360;
+  }
+}
+BENCHMARK(bm_hsv_to_rgb);
@@ -0,0 +1,84 @@
+#include "benchmark.h"
+
+#include "esphome/components/display/display_color_convert.h"
+
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::display;
+
+// one row of a 320 pixel wide display, in each of the buffer modes of ili9xxx. 16 bit buffers on 16 bit panels are
+// sent without conversion, so there is nothing to measure for them.
+static const size_t ROW = 320;
+
+static std::vector<uint8_t> make_row(size_t bytes) {
+  std::vector<uint8_t> row(bytes);
+  for (size_t i = 0; i < bytes; i++)
+    row[i] = i * 37 + 11;
+  return row;
+}
+
+static void bm_display_convert_332_to_565(benchmark::State &state) {
+  PixelConverter converter;
+  converter.set_rgb332();
+  auto src = make_row(ROW);
+  std::vector<uint8_t> dst(ROW * 2);
+  for ([[maybe_unused]] auto _ : state) {
+    converter.convert_to_565(src.data(), dst.data(), ROW);
+    benchmark::clobber_memory();
+  }
+  state.set_items_per_iteration(ROW);
+}
+BENCHMARK(bm_display_convert_332_to_565);
+
+static void bm_display_convert_332_to_666(benchmark::State &state) {
+  PixelConverter converter;
+  converter.set_rgb332();
+  auto src = make_row(ROW);
+  std::vector<uint8_t> dst(ROW * 3);
+  for ([[maybe_unused]] auto _ : state) {
+    converter.convert_to_666(src.data(), dst.data(), ROW);
+    benchmark::clobber_memory();
+  }
+  state.set_items_per_iteration(ROW);
+}
+BENCHMARK(bm_display_convert_332_to_666);
+
+static void bm_display_convert_indexed_to_565(benchmark::State &state) {
+  PixelConverter converter;
+  auto palette = make_row(256 * 3);
+  converter.set_palette888(palette.data());
+  auto src = make_row(ROW);
+  std::vector<uint8_t> dst(ROW * 2);
+  for ([[maybe_unused]] auto _ : state) {
+    converter.convert_to_565(src.data(), dst.data(), ROW);
+    benchmark::clobber_memory();
+  }
+  state.set_items_per_iteration(ROW);
+}
+BENCHMARK(bm_display_convert_indexed_to_565);
+
+static void bm_display_convert_indexed_to_666(benchmark::State &state) {
+  PixelConverter converter;
+  auto palette = make_row(256 * 3);
+  converter.set_palette888(palette.data());
+  auto src = make_row(ROW);
+  std::vector<uint8_t> dst(ROW * 3);
+  for ([[maybe_unused]] auto _ : state) {
+    converter.convert_to_666(src.data(), dst.data(), ROW);
+    benchmark::clobber_memory();
+  }
+  state.set_items_per_iteration(ROW);
+}
+BENCHMARK(bm_display_convert_indexed_to_666);
+
+static void bm_display_convert_565_to_666(benchmark::State &state) {
+  auto src = make_row(ROW * 2);
+  std::vector<uint8_t> dst(ROW * 3);
+  for ([[maybe_unused]] auto _ : state) {
+    PixelConverter::convert_565_to_666(src.data(), dst.data(), ROW);
+    benchmark::clobber_memory();
+  }
+  state.set_items_per_iteration(ROW);
+}
+BENCHMARK(bm_display_convert_565_to_666);
@@ -0,0 +1,43 @@
+#include "benchmark.h"
+
+// ArduinoJson is a library dependency, script/benchmark_core only builds these when it finds it
+#if __has_include(<ArduinoJson.h>)
+
+#include "esphome/components/json/json_util.h"
+
+using namespace esphome;
+
+// the state of a sensor as the web server sends it
+static void bm_json_build_sensor_state(benchmark::State &state) {
+  float value = 21.5f;
+  for ([[maybe_unused]] auto _ : state) {
+    std::string json = json::build_json([value](JsonObject root) {
+      root["id"] = "sensor-living_room_temperature";
+      root["value"] = value;
+      root["state"] = value_accuracy_to_string(value, 1) + " °C";
+    });
+    benchmark::do_not_optimize(json.data());
+    value += 0.01f;
+  }
+}
+BENCHMARK(bm_json_build_sensor_state);
+
+static void bm_json_build_light_state(benchmark::State &state) {
+  for ([[maybe_unused]] auto _ : state) {
+    std::string json = json::build_json([](JsonObject root) {
+      root["id"] = "light-kitchen";
+      root["state"] = "ON";
+      root["brightness"] = 180;
+      JsonObject color = root.createNestedObject("color");
+      color["r"] = 255;
+      color["g"] = 128;
+      color["b"] = 0;
+      root["color_mode"] = "rgb";
+      root["effect"] = "None";
+    });
+    benchmark::do_not_optimize(json.data());
+  }
+}
+BENCHMARK(bm_json_build_light_state);
+
+#endif  // __has_include(<ArduinoJson.h>)
@@ -0,0 +1,27 @@
+#include "benchmark.h"
+
+#include "esphome/components/logger/logger.h"
+#include "esphome/core/log.h"
+
+using namespace esphome;
+
+static const char *const TAG = "sensor";
+
+static void run_logger(benchmark::State &state, int level) {
+  logger::Logger log(0, 512);
+  log.pre_setup();
+  float value = 21.5f;
+  for ([[maybe_unused]] auto _ : state) {
+    esp_log_printf_(level, TAG, __LINE__, "'%s': Sending state %.5f %s with %d decimals of accuracy",
+                    "Living Room Temperature", value, "°C", 1);
+    value += 0.01f;
+  }
+  // the other benchmarks run without a logger
+  logger::global_logger = nullptr;
+}
+
+static void bm_logger_log_vprintf(benchmark::State &state) { run_logger(state, ESPHOME_LOG_LEVEL_DEBUG); }
+BENCHMARK(bm_logger_log_vprintf);
+
+static void bm_logger_log_vprintf_filtered(benchmark::State &state) { run_logger(state, ESPHOME_LOG_LEVEL_VERBOSE); }
+BENCHMARK(bm_logger_log_vprintf_filtered);
@@ -0,0 +1,65 @@
+#include "benchmark.h"
+
+#include "esphome/components/sensor/filter.h"
+#include "esphome/components/sensor/sensor.h"
+
+using namespace esphome;
+using namespace esphome::sensor;
+
+// offset: -2, multiply: 1.8, clamp: 0..100, round: 1 as the code generator builds it without and with fusing
+static void run_sensor(benchmark::State &state, Sensor &sensor) {
+  float sum = 0;
+  sensor.add_on_state_callback([&sum](float value) { sum += value; });
+  int i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    sensor.publish_state(float(i) * 0.37f);
+    i = i == 999 ? 0 : i + 1;
+  }
+  benchmark::do_not_optimize(sum);
+}
+
+static void bm_sensor_publish_no_filters(benchmark::State &state) {
+  Sensor sensor;
+  run_sensor(state, sensor);
+}
+BENCHMARK(bm_sensor_publish_no_filters);
+
+static void bm_sensor_filter_chain_separate(benchmark::State &state) {
+  Sensor sensor;
+  sensor.add_filters(
+      {new OffsetFilter(-2.0f), new MultiplyFilter(1.8f), new ClampFilter(0.0f, 100.0f, false), new RoundFilter(1)});
+  run_sensor(state, sensor);
+}
+BENCHMARK(bm_sensor_filter_chain_separate);
+
+static void bm_sensor_filter_chain_fused(benchmark::State &state) {
+  Sensor sensor;
+  sensor.add_filters({new FusedFilter<OffsetStage, MultiplyStage, ClampStage, RoundStage>(
+      OffsetStage(-2.0f), MultiplyStage(1.8f), ClampStage(0.0f, 100.0f, false), RoundStage(10.0f))});
+  run_sensor(state, sensor);
+}
+BENCHMARK(bm_sensor_filter_chain_fused);
+
+// calibrate_linear with one function, multiply: 0.5, offset: 3
+static void bm_sensor_affine_chain_separate(benchmark::State &state) {
+  Sensor sensor;
+  sensor.add_filters(
+      {new CalibrateLinearFilter({{1.02f, -0.4f, NAN}}), new MultiplyFilter(0.5f), new OffsetFilter(3.0f)});
+  run_sensor(state, sensor);
+}
+BENCHMARK(bm_sensor_affine_chain_separate);
+
+static void bm_sensor_affine_chain_fused(benchmark::State &state) {
+  Sensor sensor;
+  sensor.add_filters({new FusedFilter<AffineStage, MultiplyStage, OffsetStage>(
+      AffineStage(1.02f, -0.4f), MultiplyStage(0.5f), OffsetStage(3.0f))});
+  run_sensor(state, sensor);
+}
+BENCHMARK(bm_sensor_affine_chain_fused);
+
+static void bm_sensor_sliding_window_average(benchmark::State &state) {
+  Sensor sensor;
+  sensor.add_filters({new SlidingWindowMovingAverageFilter(15, 1, 1)});
+  run_sensor(state, sensor);
+}
+BENCHMARK(bm_sensor_sliding_window_average);
@@ -0,0 +1,70 @@
+#pragma once
+
+// Minimal microbenchmark harness for the host platform, modelled after Google Benchmark:
+//
+//   static void bm_something(benchmark::State &state) {
+//     for ([[maybe_unused]] auto _ : state)
+//       benchmark::do_not_optimize(something());
+//   }
+//   BENCHMARK(bm_something);
+//
+// The runner (main.cpp) calibrates the number of iterations and writes the results as JSON in the format of
+// Google Benchmark, see script/benchmark_core.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace benchmark {
+
+class State {
+ public:
+  explicit State(size_t iterations) : iterations_(iterations) {}
+
+  struct Iterator {
+    size_t remaining;
+    bool operator!=(const Iterator &other) const { return this->remaining != other.remaining; }
+    void operator++() { this->remaining--; }
+    /// The value is unused, it only lets benchmarks write `for ([[maybe_unused]] auto _ : state)`.
+    int operator*() const { return 0; }
+  };
+  Iterator begin() { return {this->iterations_}; }
+  Iterator end() { return {0}; }
+
+  size_t iterations() const { return this->iterations_; }
+  /// Number of items (pixels, bytes, callbacks, ...) processed per iteration, reported as items per second.
+  void set_items_per_iteration(size_t items) { this->items_per_iteration_ = items; }
+  size_t get_items_per_iteration() const { return this->items_per_iteration_; }
+
+ protected:
+  size_t iterations_;
+  size_t items_per_iteration_{0};
+};
+
+using benchmark_func_t = void (*)(State &);
+
+struct Registration {
+  const char *name;
+  benchmark_func_t func;
+};
+
+inline std::vector<Registration> &registry() {
+  static std::vector<Registration> benchmarks;
+  return benchmarks;
+}
+
+struct Registrar {
+  Registrar(const char *name, benchmark_func_t func) { registry().push_back({name, func}); }
+};
+
+/// Keep the compiler from optimizing away a value which is computed but not used.
+template<typename T> inline void do_not_optimize(T const &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+/// Keep the compiler from assuming memory is unchanged between iterations.
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+}  // namespace benchmark
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+#define BENCHMARK(func) \
+  static const benchmark::Registrar BENCHMARK_CONCAT(benchmark_registrar_, __LINE__)(#func, func)  // NOLINT
@@ -0,0 +1,136 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+// The host platform implements these in the main loop, the benchmarks never run it.
+void setup() {}
+void loop() {}
+
+namespace {
+
+struct Result {
+  const char *name;
+  size_t iterations;
+  double ns_per_iteration;
+  size_t items_per_iteration;
+};
+
+double run_once(benchmark::benchmark_func_t func, size_t iterations, size_t *items) {
+  benchmark::State state(iterations);
+  auto start = std::chrono::steady_clock::now();
+  func(state);
+  auto stop = std::chrono::steady_clock::now();
+  *items = state.get_items_per_iteration();
+  return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+Result run(const benchmark::Registration &benchmark, double min_time, int repetitions) {
+  // grow the number of iterations until a run takes long enough to be measured reliably
+  size_t iterations = 1;
+  size_t items = 0;
+  while (true) {
+    double ns = run_once(benchmark.func, iterations, &items);
+    if (ns >= min_time * 1e9 || iterations >= (size_t(1) << 40))
+      break;
+    double factor = ns <= 0 ? 10.0 : std::min(10.0, std::max(2.0, min_time * 1e9 * 1.2 / ns));
+    iterations = size_t(double(iterations) * factor);
+  }
+
+  std::vector<double> times;
+  for (int i = 0; i < repetitions; i++)
+    times.push_back(run_once(benchmark.func, iterations, &items) / double(iterations));
+  std::sort(times.begin(), times.end());
+  return {benchmark.name, iterations, times[times.size() / 2], items};
+}
+
+void write_json(FILE *out, const std::vector<Result> &results) {
+  char date[32];
+  time_t now = time(nullptr);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+  fprintf(out, "{\n  \"context\": {\n    \"date\": \"%s\",\n", date);
+#ifdef __VERSION__
+  fprintf(out, "    \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+#ifdef NDEBUG
+  fprintf(out, "    \"library_build_type\": \"release\"\n  },\n");
+#else
+  fprintf(out, "    \"library_build_type\": \"debug\"\n  },\n");
+#endif
+  fprintf(out, "  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &result = results[i];
+    fprintf(out, "    {\"name\": \"%s\", \"run_type\": \"iteration\", \"iterations\": %zu, ", result.name,
+            result.iterations);
+    fprintf(out, "\"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\"", result.ns_per_iteration,
+            result.ns_per_iteration);
+    if (result.items_per_iteration != 0)
+      fprintf(out, ", \"items_per_second\": %.1f", result.items_per_iteration * 1e9 / result.ns_per_iteration);
+    fprintf(out, "}%s\n", i + 1 == results.size() ? "" : ",");
+  }
+  fprintf(out, "  ]\n}\n");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *filter = nullptr;
+  const char *out_path = nullptr;
+  double min_time = 0.2;
+  int repetitions = 3;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--benchmark_filter=", 19) == 0) {
+      filter = argv[i] + 19;
+    } else if (strncmp(argv[i], "--benchmark_out=", 16) == 0) {
+      out_path = argv[i] + 16;
+    } else if (strncmp(argv[i], "--benchmark_min_time=", 21) == 0) {
+      min_time = atof(argv[i] + 21);
+    } else if (strncmp(argv[i], "--benchmark_repetitions=", 24) == 0) {
+      repetitions = std::max(1, atoi(argv[i] + 24));
+    } else {
+      fprintf(stderr, "Usage: %s [--benchmark_filter=<substring>] [--benchmark_out=<file.json>]\n", argv[0]);
+      fprintf(stderr, "          [--benchmark_min_time=<seconds>] [--benchmark_repetitions=<n>]\n");
+      return 1;
+    }
+  }
+
+  // The host logger prints every message with puts(), keep the logging benchmarks from flooding the output.
+  if (freopen("/dev/null", "w", stdout) == nullptr) {
+    fprintf(stderr, "Could not redirect stdout\n");
+    return 1;
+  }
+
+  auto benchmarks = benchmark::registry();
+  using benchmark::Registration;
+  std::sort(benchmarks.begin(), benchmarks.end(),
+            [](const Registration &a, const Registration &b) { return strcmp(a.name, b.name) < 0; });
+
+  std::vector<Result> results;
+  fprintf(stderr, "%-44s %14s %14s %16s\n", "Benchmark", "Time", "Iterations", "Items/s");
+  for (const auto &benchmark : benchmarks) {
+    if (filter != nullptr && strstr(benchmark.name, filter) == nullptr)
+      continue;
+    Result result = run(benchmark, min_time, repetitions);
+    fprintf(stderr, "%-44s %11.1f ns %14zu", result.name, result.ns_per_iteration, result.iterations);
+    if (result.items_per_iteration != 0)
+      fprintf(stderr, " %14.3gM", result.items_per_iteration * 1e3 / result.ns_per_iteration);
+    fprintf(stderr, "\n");
+    results.push_back(result);
+  }
+
+  if (out_path != nullptr) {
+    FILE *out = fopen(out_path, "w");
+    if (out == nullptr) {
+      fprintf(stderr, "Could not open %s\n", out_path);
+      return 1;
+    }
+    write_json(out, results);
+    fclose(out);
+  }
+  return 0;
+}
@@ -42,3 +42,17 @@ def test_deep_sleep_run_duration_dictionary(generate_main):
         "    .gpio_cause = 30000,\n"
         "});"
     ) in main_cpp
+
+
+def test_deep_sleep_wake_cycle(generate_main):
+    """
+    When deep sleep is configured with a wake cycle, the sensors should be added
+    before the cycle is started.
+    """
+    main_cpp = generate_main("tests/component_tests/deep_sleep/test_deep_sleep3.yaml")
+
+    assert "deepsleep->set_network_interval(10);" in main_cpp
+    assert "deepsleep->add_wake_cycle_sensor(temperature, 0.5f);" in main_cpp
+    assert main_cpp.index("deepsleep->add_wake_cycle_sensor(") < main_cpp.index(
+        "deepsleep->begin_wake_cycle();"
+    )
@@ -0,0 +1,44 @@
+#include "test.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// The host platform implements these in the main loop, the tests never run it.
+void setup() {}
+void loop() {}
+
+int main(int argc, char **argv) {
+  const char *filter = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--filter=", 9) == 0) {
+      filter = argv[i] + 9;
+    } else {
+      fprintf(stderr, "Usage: %s [--filter=<substring>]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  auto tests = test::registry();
+  using test::Registration;
+  std::sort(tests.begin(), tests.end(),
+            [](const Registration &a, const Registration &b) { return strcmp(a.name, b.name) < 0; });
+
+  int run = 0;
+  int failed = 0;
+  for (const auto &test : tests) {
+    if (filter != nullptr && strstr(test.name, filter) == nullptr)
+      continue;
+    test::failures() = 0;
+    test.func();
+    run++;
+    if (test::failures() != 0) {
+      failed++;
+      fprintf(stderr, "FAILED  %s\n", test.name);
+    } else {
+      fprintf(stderr, "ok      %s\n", test.name);
+    }
+  }
+  fprintf(stderr, "\n%d tests, %d failed\n", run, failed);
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// Minimal unit test harness for the host platform:
+//
+//   TEST(profile_reaches_cruise_speed) {
+//     stepper::StepProfile profile;
+//     profile.plan(1000, 0.0f, 0.0f, 1000.0f, 2000.0f, 2000.0f);
+//     EXPECT_EQ(profile.get_accelerate_steps(), 750u);
+//   }
+//
+// The runner (main.cpp) runs all registered tests and exits non-zero when an expectation failed, see
+// script/host_tests.py.
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace test {
+
+using test_func_t = void (*)();
+
+struct Registration {
+  const char *name;
+  test_func_t func;
+};
+
+inline std::vector<Registration> &registry() {
+  static std::vector<Registration> tests;
+  return tests;
+}
+
+struct Registrar {
+  Registrar(const char *name, test_func_t func) { registry().push_back({name, func}); }
+};
+
+/// Failed expectations of the running test.
+inline int &failures() {
+  static int count = 0;
+  return count;
+}
+
+inline void fail(const char *file, int line, const std::string &message) {
+  fprintf(stderr, "%s:%d: %s\n", file, line, message.c_str());
+  failures()++;
+}
+
+template<typename T> std::string describe(const T &value) {
+  std::ostringstream out;
+  // Numbers as numbers, also when they are uint8_t
+  if constexpr (std::is_arithmetic<T>::value) {
+    out << +value;
+  } else {
+    out << value;
+  }
+  return out.str();
+}
+
+template<typename T> std::string describe(const std::vector<T> &values) {
+  std::string out = "{";
+  for (size_t i = 0; i < values.size(); i++)
+    out += (i == 0 ? "" : ", ") + describe(values[i]);
+  return out + "}";
+}
+
+}  // namespace test
+
+#define TEST_CONCAT_(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_(a, b)
+#define TEST(name) \
+  static void name(); \
+  static const test::Registrar TEST_CONCAT(test_registrar_, __LINE__)(#name, name);  /* NOLINT */ \
+  static void name()
+
+#define EXPECT_TRUE(condition) \
+  do { \
+    if (!(condition)) \
+      test::fail(__FILE__, __LINE__, "expected " #condition); \
+  } while (false)
+
+#define EXPECT_EQ(actual, expected) \
+  do { \
+    const auto &actual_ = (actual); \
+    const auto &expected_ = (expected); \
+    if (!(actual_ == expected_)) \
+      test::fail(__FILE__, __LINE__, \
+                 #actual " is " + test::describe(actual_) + ", expected " + test::describe(expected_)); \
+  } while (false)
+
+#define EXPECT_NEAR(actual, expected, tolerance) \
+  do { \
+    const double actual_ = (actual); \
+    const double expected_ = (expected); \
+    if (!(std::fabs(actual_ - expected_) <= (tolerance))) \
+      test::fail(__FILE__, __LINE__, \
+                 #actual " is " + test::describe(actual_) + ", expected " + test::describe(expected_) + " +- " + \
+                     test::describe(tolerance)); \
+  } while (false)
@@ -0,0 +1,266 @@
+#include "test.h"
+
+#include "esphome/components/modbus_gateway/modbus_gateway.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace esphome;
+using modbus_gateway::ModbusGateway;
+using modbus_controller::ModbusController;
+
+static const uint8_t DEVICE_ADDRESS = 0x11;
+
+/// UART with an RTU slave at the other end, answering every frame once it was flushed.
+class MockSlave : public uart::UARTComponent {
+ public:
+  void write_array(const uint8_t *data, size_t len) override { this->tx_.insert(this->tx_.end(), data, data + len); }
+  bool peek_byte(uint8_t *data) override {
+    if (this->rx_.empty())
+      return false;
+    *data = this->rx_.front();
+    return true;
+  }
+  bool read_array(uint8_t *data, size_t len) override {
+    if (this->rx_.size() < len)
+      return false;
+    for (size_t i = 0; i < len; i++) {
+      data[i] = this->rx_.front();
+      this->rx_.pop_front();
+    }
+    return true;
+  }
+  int available() override { return this->rx_.size(); }
+  void flush() override {
+    this->frames.push_back(this->tx_);
+    this->respond_(this->tx_);
+    this->tx_.clear();
+  }
+
+  std::map<uint16_t, uint16_t> holding;
+  /// Frames the slave received.
+  std::vector<std::vector<uint8_t>> frames;
+  /// Answer with this exception code instead, when not 0.
+  uint8_t exception{0};
+  /// Do not answer at all.
+  bool silent{false};
+
+ protected:
+  void check_logger_conflict() override {}
+
+  void respond_(const std::vector<uint8_t> &frame) {
+    if (this->silent || frame.size() < 8 || frame[0] != DEVICE_ADDRESS)
+      return;
+    const uint8_t function_code = frame[1];
+    const uint16_t address = encode_uint16(frame[2], frame[3]);
+    const uint16_t value = encode_uint16(frame[4], frame[5]);
+    std::vector<uint8_t> response{DEVICE_ADDRESS};
+    if (this->exception != 0) {
+      response.push_back(function_code | 0x80);
+      response.push_back(this->exception);
+    } else if (function_code == 0x03) {
+      response.push_back(function_code);
+      response.push_back(value * 2);
+      for (uint16_t i = 0; i < value; i++) {
+        const uint16_t reg = this->holding[address + i];
+        response.push_back(reg >> 8);
+        response.push_back(reg & 0xFF);
+      }
+    } else if (function_code == 0x06) {
+      this->holding[address] = value;
+      response.insert(response.end(), frame.begin() + 1, frame.begin() + 6);
+    } else {
+      response.push_back(function_code | 0x80);
+      response.push_back(0x01);
+    }
+    const uint16_t crc = crc16(response.data(), response.size());
+    response.push_back(crc & 0xFF);
+    response.push_back(crc >> 8);
+    this->rx_.insert(this->rx_.end(), response.begin(), response.end());
+  }
+
+  std::vector<uint8_t> tx_;
+  std::deque<uint8_t> rx_;
+};
+
+/// The gateway with its controller and bus, on a port of its own.
+struct Gateway {
+  explicit Gateway(uint32_t timeout = 1000) {
+    static uint16_t next_port = 20000 + getpid() % 20000;
+    this->port = next_port++;
+    this->modbus.set_uart_parent(&this->slave);
+    this->modbus.set_send_wait_time(250);
+    this->modbus.set_disable_crc(false);
+    this->modbus.register_device(&this->controller);
+    this->controller.set_parent(&this->modbus);
+    this->controller.set_address(DEVICE_ADDRESS);
+    this->controller.set_command_throttle(0);
+    this->controller.set_offline_skip_updates(0);
+    this->gateway.set_controller(&this->controller);
+    this->gateway.set_port(this->port);
+    this->gateway.set_max_age(5000);
+    this->gateway.set_timeout(timeout);
+    this->modbus.setup();
+    this->controller.setup();
+    this->gateway.setup();
+  }
+  ~Gateway() { App.scheduler.cancel_interval(&this->gateway, "stats"); }
+
+  void loop() {
+    this->gateway.loop();
+    this->controller.loop();
+    this->modbus.loop();
+    this->controller.loop();
+  }
+
+  uint16_t port;
+  MockSlave slave;
+  modbus::Modbus modbus;
+  ModbusController controller;
+  ModbusGateway gateway;
+};
+
+/// Modbus TCP client.
+class Client {
+ public:
+  explicit Client(uint16_t port) {
+    this->fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    this->connected_ = ::connect(this->fd_, (struct sockaddr *) &addr, sizeof(addr)) == 0;
+  }
+  ~Client() { ::close(this->fd_); }
+
+  bool is_connected() const { return this->connected_; }
+
+  void send(uint16_t transaction_id, uint8_t unit_id, const std::vector<uint8_t> &pdu) {
+    std::vector<uint8_t> adu{uint8_t(transaction_id >> 8), uint8_t(transaction_id & 0xFF), 0, 0};
+    adu.push_back((pdu.size() + 1) >> 8);
+    adu.push_back((pdu.size() + 1) & 0xFF);
+    adu.push_back(unit_id);
+    adu.insert(adu.end(), pdu.begin(), pdu.end());
+    EXPECT_EQ(::send(this->fd_, adu.data(), adu.size(), 0), ssize_t(adu.size()));
+  }
+
+  /// PDU of the next response while running the gateway, empty when none came in time.
+  std::vector<uint8_t> receive(Gateway &gateway, uint16_t transaction_id, uint32_t timeout = 2000) {
+    const uint32_t start = millis();
+    while (millis() - start < timeout) {
+      gateway.loop();
+      uint8_t buf[260];
+      const ssize_t received = ::recv(this->fd_, buf, sizeof(buf), MSG_DONTWAIT);
+      if (received > 0)
+        this->rx_.insert(this->rx_.end(), buf, buf + received);
+      if (this->rx_.size() >= 7 && this->rx_.size() >= 6u + encode_uint16(this->rx_[4], this->rx_[5])) {
+        const size_t size = 6u + encode_uint16(this->rx_[4], this->rx_[5]);
+        EXPECT_EQ(encode_uint16(this->rx_[0], this->rx_[1]), transaction_id);
+        std::vector<uint8_t> pdu(this->rx_.begin() + 7, this->rx_.begin() + size);
+        this->rx_.erase(this->rx_.begin(), this->rx_.begin() + size);
+        return pdu;
+      }
+      delay(1);
+    }
+    return {};
+  }
+
+ protected:
+  int fd_;
+  bool connected_;
+  std::vector<uint8_t> rx_;
+};
+
+static std::vector<uint8_t> read_holding(uint16_t address, uint16_t count) {
+  return {0x03, uint8_t(address >> 8), uint8_t(address & 0xFF), uint8_t(count >> 8), uint8_t(count & 0xFF)};
+}
+
+TEST(modbus_gateway_miss_then_hit) {
+  Gateway gateway;
+  gateway.slave.holding = {{0x10, 0x1234}, {0x11, 0xABCD}};
+  Client client(gateway.port);
+  EXPECT_TRUE(client.is_connected());
+
+  client.send(1, DEVICE_ADDRESS, read_holding(0x10, 2));
+  EXPECT_EQ(client.receive(gateway, 1), (std::vector<uint8_t>{0x03, 0x04, 0x12, 0x34, 0xAB, 0xCD}));
+  EXPECT_EQ(gateway.slave.frames.size(), 1u);
+  EXPECT_EQ(gateway.gateway.get_misses(), 1u);
+
+  // Answered from the cache, also through the gateway unit id and for a part of the registers
+  gateway.slave.holding[0x11] = 0x5555;
+  client.send(2, 0xFF, read_holding(0x11, 1));
+  EXPECT_EQ(client.receive(gateway, 2), (std::vector<uint8_t>{0x03, 0x02, 0xAB, 0xCD}));
+  EXPECT_EQ(gateway.slave.frames.size(), 1u);
+  EXPECT_EQ(gateway.gateway.get_hits(), 1u);
+}
+
+TEST(modbus_gateway_coalesces_reads) {
+  Gateway gateway;
+  gateway.slave.holding = {{0x20, 1}, {0x21, 2}, {0x22, 3}, {0x23, 4}};
+  Client first(gateway.port);
+  Client second(gateway.port);
+
+  // Both arrive before the device answered, the second one is covered by the read of the first
+  first.send(1, DEVICE_ADDRESS, read_holding(0x20, 4));
+  second.send(7, DEVICE_ADDRESS, read_holding(0x21, 2));
+  delay(10);
+  EXPECT_EQ(first.receive(gateway, 1), (std::vector<uint8_t>{0x03, 0x08, 0, 1, 0, 2, 0, 3, 0, 4}));
+  EXPECT_EQ(second.receive(gateway, 7), (std::vector<uint8_t>{0x03, 0x04, 0, 2, 0, 3}));
+  EXPECT_EQ(gateway.slave.frames.size(), 1u);
+  EXPECT_EQ(gateway.gateway.get_misses(), 2u);
+  EXPECT_EQ(gateway.gateway.get_coalesced(), 1u);
+}
+
+TEST(modbus_gateway_write_invalidates_cache) {
+  Gateway gateway;
+  gateway.slave.holding = {{0x30, 1}};
+  Client client(gateway.port);
+
+  client.send(1, DEVICE_ADDRESS, read_holding(0x30, 1));
+  EXPECT_EQ(client.receive(gateway, 1), (std::vector<uint8_t>{0x03, 0x02, 0x00, 0x01}));
+  client.send(2, DEVICE_ADDRESS, {0x06, 0x00, 0x30, 0x02, 0x22});
+  EXPECT_EQ(client.receive(gateway, 2), (std::vector<uint8_t>{0x06, 0x00, 0x30, 0x02, 0x22}));
+  // Read from the device again, not the old value from the cache
+  client.send(3, DEVICE_ADDRESS, read_holding(0x30, 1));
+  EXPECT_EQ(client.receive(gateway, 3), (std::vector<uint8_t>{0x03, 0x02, 0x02, 0x22}));
+  EXPECT_EQ(gateway.slave.frames.size(), 3u);
+}
+
+TEST(modbus_gateway_passes_exceptions_through) {
+  Gateway gateway;
+  gateway.slave.exception = 0x02;
+  Client client(gateway.port);
+
+  client.send(1, DEVICE_ADDRESS, read_holding(0x40, 1));
+  EXPECT_EQ(client.receive(gateway, 1), (std::vector<uint8_t>{0x83, 0x02}));
+  // Checked by the gateway without asking the device
+  client.send(2, DEVICE_ADDRESS, read_holding(0x40, 126));
+  EXPECT_EQ(client.receive(gateway, 2), (std::vector<uint8_t>{0x83, 0x03}));
+  client.send(3, DEVICE_ADDRESS + 1, read_holding(0x40, 1));
+  EXPECT_EQ(client.receive(gateway, 3), (std::vector<uint8_t>{0x83, 0x0A}));
+  client.send(4, DEVICE_ADDRESS, {0x2B, 0x0E, 0x01, 0x00});
+  EXPECT_EQ(client.receive(gateway, 4), (std::vector<uint8_t>{0xAB, 0x01}));
+  EXPECT_EQ(gateway.slave.frames.size(), 1u);
+}
+
+TEST(modbus_gateway_times_out) {
+  Gateway gateway(100);
+  gateway.slave.silent = true;
+  Client client(gateway.port);
+
+  const uint32_t start = millis();
+  client.send(1, DEVICE_ADDRESS, read_holding(0x50, 1));
+  EXPECT_EQ(client.receive(gateway, 1), (std::vector<uint8_t>{0x83, 0x0B}));
+  EXPECT_TRUE(millis() - start >= 100);
+  EXPECT_EQ(gateway.gateway.get_timeouts(), 1u);
+}
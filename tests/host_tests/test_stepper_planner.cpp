@@ -0,0 +1,185 @@
+#include "test.h"
+
+#include "esphome/components/stepper/planner.h"
+
+#include <deque>
+#include <vector>
+
+using namespace esphome::stepper;
+
+static Waypoint waypoint(int32_t target) { return Waypoint{target, 1000.0f, 2000.0f, 2000.0f}; }
+
+/// Time of the whole move in µs, as the step timer adds it up.
+static double move_time_us(const StepProfile &profile) {
+  double total = 0;
+  for (uint32_t i = 0; i < profile.get_steps(); i++)
+    total += profile.interval_us(i);
+  return total;
+}
+
+TEST(profile_trapezoid) {
+  StepProfile profile;
+  profile.plan(1000, 0.0f, 0.0f, 1000.0f, 2000.0f, 2000.0f);
+  // 250 steps each to speed up and slow down, cruising in between
+  EXPECT_EQ(profile.get_accelerate_steps(), 750u);
+  EXPECT_EQ(profile.get_decelerate_steps(), 250u);
+  EXPECT_NEAR(profile.speed_at(500), 1000.0, 0.01);
+  EXPECT_EQ(profile.interval_us(500), 1000u);
+  // 0.5 s up, 0.5 s cruise, 0.5 s down
+  EXPECT_NEAR(move_time_us(profile), 1.5e6, 1.5e4);
+}
+
+TEST(profile_triangle) {
+  StepProfile profile;
+  profile.plan(100, 0.0f, 0.0f, 1000.0f, 2000.0f, 2000.0f);
+  EXPECT_EQ(profile.get_accelerate_steps(), 50u);
+  EXPECT_EQ(profile.get_decelerate_steps(), 50u);
+  // Peaks at sqrt(2 * 2000 * 50) in the middle, well below the cruise speed
+  EXPECT_NEAR(profile.speed_at(50), 447.2, 0.5);
+}
+
+TEST(profile_exit_speed_limited_by_acceleration) {
+  StepProfile profile;
+  profile.plan(25, 0.0f, 1000.0f, 1000.0f, 2000.0f, 2000.0f);
+  // Can only reach sqrt(2 * 2000 * 25) at the end
+  EXPECT_NEAR(profile.speed_at(25), 316.2, 0.5);
+  EXPECT_EQ(profile.get_decelerate_steps(), 0u);
+}
+
+TEST(profile_single_step) {
+  StepProfile profile;
+  profile.plan(1, 0.0f, 0.0f, 1000.0f, 2000.0f, 2000.0f);
+  EXPECT_TRUE(profile.interval_us(0) > 0u);
+  EXPECT_TRUE(profile.interval_us(0) < 1000000u);
+}
+
+TEST(plan_moves_joins_same_direction) {
+  std::vector<PlannedMove> moves{
+      PlannedMove{1000, 500.0f, 2000.0f, 2000.0f},
+      PlannedMove{1000, 1000.0f, 2000.0f, 2000.0f},
+      PlannedMove{-1000, 1000.0f, 2000.0f, 2000.0f},
+  };
+  plan_moves(moves, 0.0f);
+  EXPECT_NEAR(moves[0].entry_speed, 0.0, 0.0);
+  // At the lower of both speeds into the second move, stopped for the reversal and at the end
+  EXPECT_NEAR(moves[0].exit_speed, 500.0, 0.01);
+  EXPECT_NEAR(moves[1].entry_speed, 500.0, 0.01);
+  EXPECT_NEAR(moves[1].exit_speed, 0.0, 0.0);
+  EXPECT_NEAR(moves[2].entry_speed, 0.0, 0.0);
+  EXPECT_NEAR(moves[2].exit_speed, 0.0, 0.0);
+}
+
+TEST(plan_moves_junction_limited_by_short_moves) {
+  std::vector<PlannedMove> moves{
+      PlannedMove{10, 1000.0f, 2000.0f, 2000.0f},
+      PlannedMove{10, 1000.0f, 2000.0f, 2000.0f},
+  };
+  plan_moves(moves, 0.0f);
+  // Neither speeding up within the first move nor slowing down within the second allows more
+  EXPECT_NEAR(moves[0].exit_speed, 200.0, 0.01);
+}
+
+TEST(plan_segments_from_standstill) {
+  std::deque<Waypoint> waypoints{waypoint(100), waypoint(100), waypoint(300), waypoint(200)};
+  SegmentPlan plan;
+  plan_segments(waypoints, 0, PlanStart{0, 0.0f, nullptr}, plan);
+  EXPECT_EQ(plan.count, 3);
+  EXPECT_EQ(plan.skipped, 0);
+  EXPECT_EQ(plan.planned, 4);
+  // The repeated waypoint is reached along with the first segment
+  EXPECT_EQ(plan.segments[0].profile.get_steps(), 100u);
+  EXPECT_EQ(plan.segments[0].waypoints, 2);
+  EXPECT_TRUE(plan.segments[0].forward);
+  EXPECT_EQ(plan.segments[1].profile.get_steps(), 200u);
+  EXPECT_TRUE(plan.segments[1].forward);
+  EXPECT_EQ(plan.segments[2].profile.get_steps(), 100u);
+  EXPECT_TRUE(!plan.segments[2].forward);
+  // No stop between the first two, a stop before turning around
+  EXPECT_TRUE(plan.segments[0].profile.speed_at(100) > 0.0f);
+  EXPECT_NEAR(plan.segments[1].profile.speed_at(200), 0.0, 0.0);
+}
+
+TEST(plan_segments_skips_reached_waypoints) {
+  std::deque<Waypoint> waypoints{waypoint(50), waypoint(0), waypoint(0), waypoint(80)};
+  SegmentPlan plan;
+  // The first waypoint was reached by the timer already
+  plan_segments(waypoints, 1, PlanStart{0, 0.0f, nullptr}, plan);
+  EXPECT_EQ(plan.skipped, 2);
+  EXPECT_EQ(plan.count, 1);
+  EXPECT_EQ(plan.planned, 1);
+  EXPECT_EQ(plan.segments[0].profile.get_steps(), 80u);
+}
+
+TEST(plan_segments_limits_segments) {
+  std::deque<Waypoint> waypoints;
+  for (int32_t i = 1; i <= 6; i++)
+    waypoints.push_back(waypoint(i * 100 * (i % 2 == 0 ? -1 : 1)));
+  SegmentPlan plan;
+  plan_segments(waypoints, 0, PlanStart{0, 0.0f, nullptr}, plan);
+  const uint8_t max_segments = SegmentPlan::MAX_SEGMENTS;
+  EXPECT_EQ(plan.count, max_segments);
+  EXPECT_EQ(plan.planned, max_segments);
+}
+
+TEST(plan_segments_stops_before_close_target) {
+  StepSegment running{};
+  running.profile.plan(10000, 1000.0f, 0.0f, 1000.0f, 2000.0f, 2000.0f);
+  running.forward = true;
+  std::deque<Waypoint> waypoints{waypoint(100)};
+  SegmentPlan plan;
+  plan_segments(waypoints, 0, PlanStart{0, 1000.0f, &running}, plan);
+  // Slowing down from 1000 steps/s takes 250 steps, 150 past the target
+  EXPECT_EQ(plan.count, 2);
+  EXPECT_EQ(plan.planned, 1);
+  EXPECT_EQ(plan.segments[0].profile.get_steps(), 250u);
+  EXPECT_TRUE(plan.segments[0].forward);
+  EXPECT_EQ(plan.segments[0].waypoints, 0);
+  EXPECT_NEAR(plan.segments[0].profile.speed_at(0), 1000.0, 0.01);
+  EXPECT_EQ(plan.segments[1].profile.get_steps(), 150u);
+  EXPECT_TRUE(!plan.segments[1].forward);
+  EXPECT_EQ(plan.segments[1].waypoints, 1);
+}
+
+TEST(plan_segments_continues_towards_far_target) {
+  StepSegment running{};
+  running.profile.plan(10000, 1000.0f, 0.0f, 1000.0f, 2000.0f, 2000.0f);
+  running.forward = false;
+  std::deque<Waypoint> waypoints{waypoint(-1000)};
+  SegmentPlan plan;
+  plan_segments(waypoints, 0, PlanStart{0, 1000.0f, &running}, plan);
+  EXPECT_EQ(plan.count, 1);
+  EXPECT_TRUE(!plan.segments[0].forward);
+  EXPECT_EQ(plan.segments[0].profile.get_steps(), 1000u);
+  EXPECT_NEAR(plan.segments[0].profile.speed_at(0), 1000.0, 0.01);
+}
+
+TEST(plan_segments_stops_without_waypoints) {
+  StepSegment running{};
+  running.profile.plan(10000, 500.0f, 0.0f, 1000.0f, 2000.0f, 1000.0f);
+  running.forward = true;
+  SegmentPlan plan;
+  plan_segments({}, 0, PlanStart{0, 500.0f, &running}, plan);
+  // With the deceleration of the running segment
+  EXPECT_EQ(plan.count, 1);
+  EXPECT_EQ(plan.segments[0].profile.get_steps(), 125u);
+  EXPECT_EQ(plan.planned, 0);
+}
+
+TEST(coordinate_axes_finish_together) {
+  std::vector<AxisMove> axes{
+      AxisMove{100, 1000.0f, 2000.0f, 2000.0f},
+      AxisMove{50, 1000.0f, 2000.0f, 2000.0f},
+      AxisMove{0, 1000.0f, 2000.0f, 2000.0f},
+  };
+  coordinate_axes(axes);
+  EXPECT_NEAR(axes[0].max_speed, 1000.0, 0.01);
+  EXPECT_NEAR(axes[1].max_speed, 500.0, 0.01);
+  EXPECT_NEAR(axes[1].acceleration, 1000.0, 0.01);
+  // Not moving, left alone
+  EXPECT_NEAR(axes[2].max_speed, 1000.0, 0.0);
+
+  StepProfile first, second;
+  first.plan(axes[0].steps, 0.0f, 0.0f, axes[0].max_speed, axes[0].acceleration, axes[0].deceleration);
+  second.plan(axes[1].steps, 0.0f, 0.0f, axes[1].max_speed, axes[1].acceleration, axes[1].deceleration);
+  EXPECT_NEAR(move_time_us(first), move_time_us(second), move_time_us(first) * 0.02);
+}
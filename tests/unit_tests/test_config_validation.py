@@ -152,3 +152,120 @@ def hex_int__valid(value):
 
     assert isinstance(actual, HexInt)
     assert actual == value
+
+
+@pytest.fixture
+def schema_cache(monkeypatch):
+    """An empty validated-block cache and pin registry, restored afterwards."""
+    from esphome import config, pins
+
+    monkeypatch.setattr(pins.PIN_SCHEMA_REGISTRY, "pins_used", {})
+    monkeypatch.setattr(CORE, "data", {})
+    monkeypatch.setattr(CORE, "loaded_integrations", set())
+    config.clear_schema_cache()
+    yield
+    config.clear_schema_cache()
+
+
+def validate_block(comp, conf, path=("test",)):
+    from esphome.config import Config, SchemaValidationStep
+
+    result = Config()
+    SchemaValidationStep(comp.module, list(path), conf, comp).run(result)
+    return result
+
+
+def counting_component(validator=None):
+    """A component whose schema counts how often it validates a block."""
+    from types import SimpleNamespace
+
+    comp = SimpleNamespace(module="test", is_platform=False, calls=0)
+
+    def config_schema(value):
+        comp.calls += 1
+        if validator is not None:
+            validator(value)
+        return {**value, "validated": True}
+
+    comp.config_schema = config_schema
+    return comp
+
+
+def test_schema_validation_step__unchanged_block_reuses_result(schema_cache):
+    comp = counting_component()
+
+    first = validate_block(comp, {"value": 1})
+    second = validate_block(comp, {"value": 1})
+
+    assert comp.calls == 1
+    assert second.get_nested_item(["test"]) == first.get_nested_item(["test"])
+    assert second.get_nested_item(["test"]) == {"value": 1, "validated": True}
+    # Each result gets its own copy
+    assert second.get_nested_item(["test"]) is not first.get_nested_item(["test"])
+
+    validate_block(comp, {"value": 2})
+
+    assert comp.calls == 2
+
+
+def test_schema_validation_step__core_state_change_revalidates(schema_cache):
+    comp = counting_component()
+
+    validate_block(comp, {"value": 1})
+    CORE.data["esp32"] = {"variant": "ESP32"}
+    validate_block(comp, {"value": 1})
+    CORE.loaded_integrations.add("spi")
+    validate_block(comp, {"value": 1})
+    validate_block(comp, {"value": 1})
+
+    assert comp.calls == 3
+
+
+def test_schema_validation_step__state_modifying_block_not_cached(schema_cache):
+    def set_variant(value):
+        CORE.data["variant"] = value["variant"]
+
+    comp = counting_component(set_variant)
+
+    validate_block(comp, {"variant": "ESP32"})
+    # Like the next load of the configuration, which starts from a clean state
+    CORE.data.clear()
+    validate_block(comp, {"variant": "ESP32"})
+
+    assert comp.calls == 2
+    assert CORE.data == {"variant": "ESP32"}
+
+
+def test_schema_validation_step__errors_not_cached(schema_cache):
+    def invalid(value):
+        raise Invalid("broken")
+
+    comp = counting_component(invalid)
+
+    first = validate_block(comp, {"value": 1})
+    second = validate_block(comp, {"value": 1})
+
+    assert comp.calls == 2
+    assert len(first.errors) == len(second.errors) == 1
+
+
+def test_schema_validation_step__pins_replayed_on_hit(schema_cache):
+    from esphome import config, pins
+
+    pin_key = ("esp32", None, 4)
+
+    def use_pin(value):
+        pins.PIN_SCHEMA_REGISTRY.pins_used.setdefault(pin_key, []).append(
+            (config.path_context.get(), "esp32", {"number": 4})
+        )
+
+    comp = counting_component(use_pin)
+
+    validate_block(comp, {"pin": 4}, path=("first",))
+    validate_block(comp, {"pin": 4}, path=("second",))
+
+    assert comp.calls == 1
+    assert pins.PIN_SCHEMA_REGISTRY.pins_used[pin_key] == [
+        (["first"], "esp32", {"number": 4}),
+        (["second"], "esp32", {"number": 4}),
+    ]
@@ -179,6 +179,47 @@ class TestLambdaExpression:
         )
 
 
+class TestShareLambda:
+    @pytest.fixture(autouse=True)
+    def core(self, monkeypatch):
+        monkeypatch.setattr(cg.CORE, "data", {})
+        monkeypatch.setattr(cg.CORE, "global_statements", [])
+
+    @staticmethod
+    def lambda_(content, return_type=bool):
+        return cg.LambdaExpression((content,), ((float, "x"),), "=", return_type)
+
+    def test_identical_lambdas_share_a_function(self):
+        first = cg._share_lambda(self.lambda_("return x > 5;"))
+        second = cg._share_lambda(self.lambda_("return x > 5;"))
+        other = cg._share_lambda(self.lambda_("return x < 5;"))
+
+        assert str(first) == str(second) == "shared_lambda_0"
+        assert str(other) == "shared_lambda_1"
+        assert cg.shared_lambda_stats() == (3, 2)
+        assert str(cg.CORE.global_statements[0]) == (
+            "static bool shared_lambda_0(float x) {\n  return x > 5;\n}"
+        )
+
+    @pytest.mark.parametrize(
+        "target",
+        (
+            cg.LambdaExpression(("return x > 5;",), ((float, "x"),)),
+            cg.LambdaExpression(
+                ("static int n = 0; return n++ > x;",), ((float, "x"),), "=", bool
+            ),
+            cg.LambdaExpression(
+                ("return custom->get() > x;",), ((float, "x"),), "=", bool
+            ),
+        ),
+    )
+    def test_lambdas_kept_local(self, target):
+        cg.CORE.data[cg.KEY_LOCAL_VARIABLES] = {"custom"}
+
+        assert cg._share_lambda(target) is target
+        assert cg.CORE.global_statements == []
+
+
 class TestLiterals:
     @pytest.mark.parametrize(
         "target, expected",
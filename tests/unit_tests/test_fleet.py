@@ -0,0 +1,245 @@
+"""Tests for the fleet.py file."""
+import asyncio
+
+import pytest
+
+from esphome import fleet
+from esphome.fleet import (
+    MEMORY_PER_PROCESS,
+    PHASES,
+    FleetNode,
+    FleetScheduler,
+    compile_fleet,
+    node_group,
+    parallel_builds,
+)
+
+
+@pytest.fixture
+def machine(monkeypatch):
+    """An idle machine with 8 CPUs and unknown memory, the tests set what they need."""
+    state = {"cpus": 8, "memory": None}
+    monkeypatch.setattr(fleet.os, "cpu_count", lambda: state["cpus"])
+    monkeypatch.setattr(fleet.os, "getloadavg", lambda: (0.0, 0.0, 0.0))
+    monkeypatch.setattr(fleet, "_available_memory", lambda: state["memory"])
+    return state
+
+
+def write_config(tmp_path, name, content):
+    path = tmp_path / f"{name}.yaml"
+    path.write_text(content)
+    return str(path)
+
+
+class FakeProcess:
+    """A compile process printing the given lines, then exiting with rc."""
+
+    def __init__(self, lines, rc=0):
+        self.stdout = self
+        self._lines = [f"{line}\n".encode() for line in lines]
+        self._rc = rc
+
+    async def readline(self):
+        return self._lines.pop(0) if self._lines else b""
+
+    async def wait(self):
+        return self._rc
+
+
+def fake_compile(monkeypatch, lines, rc=0):
+    calls = []
+
+    async def create_subprocess_exec(*args, **kwargs):
+        calls.append((args, kwargs))
+        return FakeProcess(lines, rc)
+
+    monkeypatch.setattr(fleet.asyncio, "create_subprocess_exec", create_subprocess_exec)
+    return calls
+
+
+def test_node_group__platform_and_framework(tmp_path):
+    esp32 = write_config(
+        tmp_path,
+        "esp32",
+        "esphome:\n  name: a\n"
+        "esp32:\n  board: esp32dev\n  framework:\n    type: esp-idf\n",
+    )
+    esp8266 = write_config(
+        tmp_path, "esp8266", "esphome:\n  name: b\nesp8266:\n  board: d1_mini\n"
+    )
+
+    assert node_group(esp32) == ("esp32", "esp-idf")
+    assert node_group(esp8266) == ("esp8266", "")
+
+
+def test_node_group__unknown(tmp_path):
+    no_platform = write_config(tmp_path, "none", "esphome:\n  name: c\n")
+    missing = str(tmp_path / "missing.yaml")
+
+    # Each in a group of its own, they need not share a platform
+    assert node_group(no_platform) == ("unknown", no_platform)
+    assert node_group(missing) == ("unknown", missing)
+
+
+def test_compile_fleet__groups_nodes_in_order_of_appearance(
+    tmp_path, monkeypatch, machine
+):
+    idf = "esp32:\n  board: esp32dev\n  framework:\n    type: esp-idf\n"
+    arduino = "esp32:\n  board: esp32dev\n  framework:\n    type: arduino\n"
+    paths = [
+        write_config(tmp_path, "a", idf),
+        write_config(tmp_path, "b", arduino),
+        write_config(tmp_path, "c", idf),
+        write_config(tmp_path, "d", arduino),
+    ]
+    fake_compile(monkeypatch, [])
+
+    nodes = compile_fleet(paths)
+
+    assert [node.name for node in nodes] == ["a", "c", "b", "d"]
+    assert [node.group for node in nodes] == [
+        ("esp32", "esp-idf"),
+        ("esp32", "esp-idf"),
+        ("esp32", "arduino"),
+        ("esp32", "arduino"),
+    ]
+    assert all(node.status == "success" for node in nodes)
+
+
+@pytest.mark.parametrize(
+    "nodes, requested, memory, expected",
+    (
+        # Half the CPUs, each with its share of compile processes
+        (10, None, None, (4, 2)),
+        # Never more builds than nodes
+        (2, None, None, (2, 4)),
+        # Two compile processes' worth of memory per build
+        (10, None, 3 * 2 * MEMORY_PER_PROCESS, (3, 2)),
+        # Always at least one build, even when short of memory
+        (10, None, MEMORY_PER_PROCESS, (1, 8)),
+        # Requested explicitly, memory is not considered
+        (10, 8, MEMORY_PER_PROCESS, (8, 1)),
+        (3, 6, None, (3, 2)),
+    ),
+)
+def test_parallel_builds(machine, nodes, requested, memory, expected):
+    machine["memory"] = memory
+
+    assert parallel_builds(nodes, requested) == expected
+
+
+def test_fleet_scheduler__limits_builds_and_warms_groups_first(machine):
+    nodes = [
+        FleetNode("a1.yaml", ("esp32", "esp-idf")),
+        FleetNode("a2.yaml", ("esp32", "esp-idf")),
+        FleetNode("a3.yaml", ("esp32", "esp-idf")),
+        FleetNode("b1.yaml", ("esp8266", "")),
+        FleetNode("b2.yaml", ("esp8266", "")),
+    ]
+    scheduler = FleetScheduler(nodes, 2, 4)
+    running = []
+    events = []
+    most_running = 0
+
+    async def build(node):
+        nonlocal most_running
+        running.append(node.name)
+        most_running = max(most_running, len(running))
+        events.append(("start", node.name))
+        await asyncio.sleep(0.01)
+        running.remove(node.name)
+        events.append(("end", node.name))
+        node.status = "success"
+
+    scheduler._build = build
+    asyncio.run(scheduler.run())
+
+    assert most_running == 2
+    # Only the first node of a group starts until it installed the platform
+    assert events[:2] == [("start", "a1"), ("start", "b1")]
+    for first, other in (("a1", "a2"), ("a1", "a3"), ("b1", "b2")):
+        assert events.index(("start", other)) > events.index(("end", first))
+    assert all(node.status == "success" for node in nodes)
+
+
+def test_fleet_scheduler__next_node_of_group_takes_over_after_failure(machine):
+    nodes = [
+        FleetNode("a1.yaml", ("esp32", "esp-idf")),
+        FleetNode("a2.yaml", ("esp32", "esp-idf")),
+        FleetNode("a3.yaml", ("esp32", "esp-idf")),
+    ]
+    scheduler = FleetScheduler(nodes, 3, 2)
+    order = []
+
+    async def build(node):
+        order.append(node.name)
+        await asyncio.sleep(0)
+        node.status = "failed" if node.name == "a1" else "success"
+
+    scheduler._build = build
+    asyncio.run(scheduler.run())
+
+    # a2 builds alone once a1 failed, a3 only waits for a2
+    assert order == ["a1", "a2", "a3"]
+    assert [node.status for node in nodes] == ["failed", "success", "success"]
+
+
+def test_fleet_scheduler__holds_back_while_short_of_memory(machine):
+    scheduler = FleetScheduler([], 4, 2)
+
+    machine["memory"] = 2 * MEMORY_PER_PROCESS
+    assert scheduler._may_start(0)
+    assert scheduler._may_start(1)
+    assert not scheduler._may_start(4)
+
+    machine["memory"] = MEMORY_PER_PROCESS
+    assert scheduler._may_start(0)
+    assert not scheduler._may_start(1)
+
+
+def test_fleet_scheduler__phases_from_compile_output(monkeypatch, machine):
+    calls = fake_compile(
+        monkeypatch,
+        [
+            "INFO Reading configuration node.yaml...",
+            "INFO Generating C++ source...",
+            "\x1b[32mINFO Compiling app...\x1b[0m",
+            "Compiling .pioenvs/node/src/main.cpp.o",
+            "Compiling .pioenvs/node/src/esphome/core/application.cpp.o",
+            # Markers of earlier phases do not go back
+            "INFO Generating C++ source...",
+            "Linking .pioenvs/node/firmware.elf",
+            "Compiling .pioenvs/node/late.o",
+        ],
+    )
+    node = FleetNode("node.yaml", ("esp32", "esp-idf"))
+    scheduler = FleetScheduler([node], 1, 3)
+
+    asyncio.run(scheduler.run())
+
+    assert node.status == "success"
+    assert set(node.phases) == set(PHASES)
+    assert node.objects == 2
+    assert calls[0][0] == ("esphome", "compile", "node.yaml")
+    assert calls[0][1]["env"]["ESPHOME_COMPILE_PROCESS_LIMIT"] == "3"
+
+
+def test_fleet_scheduler__failed_build_keeps_last_output(monkeypatch, machine):
+    lines = [f"line {i}" for i in range(fleet.FAILURE_OUTPUT_LINES + 10)]
+    fake_compile(monkeypatch, lines, rc=1)
+    node = FleetNode("node.yaml", ("esp32", "esp-idf"))
+    scheduler = FleetScheduler([node], 1, 1)
+
+    asyncio.run(scheduler.run())
+
+    assert node.status == "failed"
+    assert set(node.phases) == {"config"}
+    assert node.output == lines[-fleet.FAILURE_OUTPUT_LINES :]
+    report = scheduler.report()
+    assert report["nodes"][0]["status"] == "failed"
+    assert report["nodes"][0]["phases"] == {
+        "config": node.phases["config"],
+        "codegen": 0.0,
+        "compile": 0.0,
+        "link": 0.0,
+    }
@@ -0,0 +1,89 @@
+import pytest
+from unittest.mock import Mock
+
+from esphome import cpp_generator as cg
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ACCURACY_DECIMALS,
+    CONF_FROM,
+    CONF_METHOD,
+    CONF_TO,
+    CONF_TYPE_ID,
+)
+from esphome.core import ID
+
+
+@pytest.fixture(autouse=True)
+def core(monkeypatch):
+    core_mock = Mock()
+    monkeypatch.setattr(cg, "CORE", core_mock)
+    return core_mock
+
+
+def filter_config(name, key, value, type_):
+    return {key: value, CONF_TYPE_ID: ID(name, is_declaration=True, type=type_)}
+
+
+def declarations(core):
+    return [str(call.args[0]) for call in core.add_global.call_args_list]
+
+
+def test_build_fused_filter__declares_fused_filter(core):
+    sensor.build_fused_filter(
+        [
+            filter_config("filter_1", "offset", 2.0, sensor.OffsetFilter),
+            filter_config("filter_2", "multiply", 1.5, sensor.MultiplyFilter),
+            filter_config(
+                "filter_3", "round", {CONF_ACCURACY_DECIMALS: 1}, sensor.RoundFilter
+            ),
+        ]
+    )
+
+    stages = "sensor::OffsetStage, sensor::MultiplyStage, sensor::RoundStage"
+    assert declarations(core) == [f"sensor::FusedFilter<{stages}> *filter_1"]
+    assert str(core.add.call_args.args[0]) == (
+        f"filter_1 = new sensor::FusedFilter<{stages}>(sensor::OffsetStage(2.0f), "
+        "sensor::MultiplyStage(1.5f), sensor::RoundStage(10.0f))"
+    )
+
+
+def test_build_fused_filter__calibrate_linear(core):
+    calibrate = {
+        CONF_METHOD: "least_squares",
+        sensor.CONF_DATAPOINTS: [
+            {CONF_FROM: 0.0, CONF_TO: 1.0},
+            {CONF_FROM: 1.0, CONF_TO: 3.0},
+        ],
+    }
+    sensor.build_fused_filter(
+        [
+            filter_config(
+                "filter_1", "calibrate_linear", calibrate, sensor.CalibrateLinearFilter
+            ),
+            filter_config("filter_2", "offset", 0.5, sensor.OffsetFilter),
+        ]
+    )
+
+    assert str(core.add.call_args.args[0]) == (
+        "filter_1 = new sensor::FusedFilter<sensor::AffineStage, sensor::OffsetStage>"
+        "(sensor::AffineStage(2.0f, 1.0f), sensor::OffsetStage(0.5f))"
+    )
+
+
+@pytest.mark.asyncio
+async def test_build_filters__fuses_runs_of_two_or_more(core):
+    filters = await sensor.build_filters(
+        [
+            filter_config("filter_1", "offset", 2.0, sensor.OffsetFilter),
+            filter_config("filter_2", "filter_out", 0.0, sensor.FilterOutValueFilter),
+            filter_config("filter_3", "multiply", 1.5, sensor.MultiplyFilter),
+            filter_config("filter_4", "offset", 1.0, sensor.OffsetFilter),
+        ]
+    )
+
+    assert len(filters) == 3
+    assert declarations(core) == [
+        "sensor::OffsetFilter *filter_1",
+        "sensor::FilterOutValueFilter *filter_2",
+        "sensor::FusedFilter<sensor::MultiplyStage, sensor::OffsetStage> *filter_3",
+    ]
@@ -11,3 +11,54 @@ def test_include_with_vars(fixture_path):
     assert actual["esphome"]["libraries"][0] == "Wire"
     assert actual["esphome"]["board"] == "nodemcu"
     assert actual["wifi"]["ssid"] == "my_custom_ssid"
+
+
+def test_load_cache_reuses_unchanged_files(tmp_path):
+    main = tmp_path / "main.yaml"
+    main.write_text("esphome:\n  name: test\nwifi: !include wifi.yaml\n")
+    (tmp_path / "wifi.yaml").write_text("ssid: first\n")
+
+    first = yaml_util.load_yaml(str(main))
+    first["esphome"]["name"] = "modified"
+    second = yaml_util.load_yaml(str(main))
+    assert second["esphome"]["name"] == "test"
+    assert second["esphome"] is not first["esphome"]
+    assert second["esphome"].esp_range is not None
+
+
+def test_load_cache_tracks_includes(tmp_path):
+    main = tmp_path / "main.yaml"
+    main.write_text("wifi: !include wifi.yaml\n")
+    (tmp_path / "wifi.yaml").write_text("ssid: first\n")
+    assert yaml_util.load_yaml(str(main))["wifi"]["ssid"] == "first"
+
+    (tmp_path / "wifi.yaml").write_text("ssid: second\n")
+    assert yaml_util.load_yaml(str(main))["wifi"]["ssid"] == "second"
+
+
+def test_load_cache_restores_secrets(tmp_path):
+    main = tmp_path / "main.yaml"
+    main.write_text("wifi:\n  password: !secret wifi_password\n")
+    (tmp_path / "secrets.yaml").write_text("wifi_password: hunter2\n")
+
+    yaml_util.load_yaml(str(main))
+    config = yaml_util.load_yaml(str(main))
+    assert yaml_util.is_secret(config["wifi"]["password"]) == "wifi_password"
+
+
+def test_load_cache_does_not_share_fallback_secrets(tmp_path, monkeypatch):
+    common = tmp_path / "common"
+    common.mkdir()
+    (common / "common.yaml").write_text("password: !secret wifi_password\n")
+    configs = {}
+    for name in ("a", "b"):
+        directory = tmp_path / name
+        directory.mkdir()
+        (directory / "secrets.yaml").write_text(f"wifi_password: secret_{name}\n")
+        configs[name] = directory / f"{name}.yaml"
+        configs[name].write_text("wifi: !include ../common/common.yaml\n")
+
+    for name in ("a", "b", "a"):
+        monkeypatch.setattr(yaml_util.CORE, "config_path", str(configs[name]))
+        config = yaml_util.load_yaml(str(configs[name]))
+        assert config["wifi"]["password"] == f"secret_{name}"